@@ -0,0 +1,56 @@
+/******************************************************************************
+ * 
+ * @file    bench.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ * 
+ * @brief   Benchmark helpers
+ * 
+ *****************************************************************************/
+
+#ifndef __USTRING_BENCH_H__
+#define __USTRING_BENCH_H__
+
+#include <stdio.h>
+#include <stddef.h>
+#include <time.h>
+
+/**
+ * @brief Number of allocations and reallocations performed
+ *      by the library since @c bench_init call
+ */
+extern size_t bench_alloc_count;
+
+/**
+ * @brief Installs the allocation counting allocator as the global allocator
+ * 
+ * Must be called before any benchmarked objects are created.
+ */
+void bench_init(void);
+
+/**
+ * @brief Returns monotonic time in seconds
+ */
+static inline double bench_now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Prints single benchmark result line
+ * 
+ * @param name Benchmark name
+ * @param ops Number of performed operations
+ * @param seconds Elapsed time in seconds
+ * @param allocs Number of heap allocations performed by the benchmark
+ */
+static inline void bench_report(const char* name, size_t ops, double seconds, size_t allocs) {
+    printf("%-24s %10zu ops %10.2f ns/op %8.2f allocs/op\n",
+        name,
+        ops,
+        seconds * 1e9 / (double) ops,
+        (double) allocs / (double) ops);
+}
+
+#endif /* __USTRING_BENCH_H__ */
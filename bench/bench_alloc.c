@@ -0,0 +1,46 @@
+/**************************************************************************//**
+ * 
+ * @file    bench_alloc.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ * 
+ * Allocation counting allocator installed as the global library allocator.
+ * 
+ *****************************************************************************/
+
+#include <stdlib.h>
+
+#include <ustring/alloc.h>
+
+#include "bench.h"
+
+size_t bench_alloc_count = 0;
+
+static void* bench_alloc(void* ctx, size_t size) {
+    (void) ctx;
+    bench_alloc_count += 1;
+    return malloc(size);
+}
+
+static void* bench_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size) {
+    (void) ctx;
+    (void) old_size;
+    bench_alloc_count += 1;
+    return realloc(ptr, new_size);
+}
+
+static void bench_free(void* ctx, void* ptr) {
+    (void) ctx;
+    free(ptr);
+}
+
+static const ustring_allocator_t bench_allocator = {
+    .alloc = bench_alloc,
+    .realloc = bench_realloc,
+    .free = bench_free,
+    .ctx = NULL,
+};
+
+void bench_init(void) {
+    ustring_set_allocator(&bench_allocator);
+}
@@ -0,0 +1,252 @@
+/**************************************************************************//**
+ * 
+ * @file    str_bench.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ * 
+ * String construction benchmarks: str_new, str_copy, str_split and
+ * str_split_iter on short tokens, str_new and str_concat on longer strings.
+ * Copies of 4 KiB strings with owned and shared characters.
+ * Hashing of short and long strings.
+ * str_replace on 4 KiB strings with shorter, equal and longer replacements.
+ * 
+ *****************************************************************************/
+
+#include <stdlib.h>
+
+#include <ustring/str.h>
+#include <ustring/str_list.h>
+#include <ustring/str_view.h>
+
+#include "bench.h"
+
+#define TOKEN_COUNT ((size_t) 1024)
+#define TOKEN_MAX_LEN ((size_t) 16)
+#define ITERATIONS ((size_t) 1000000)
+#define SPLIT_ITERATIONS ((size_t) 20000)
+
+static char tokens[TOKEN_COUNT][TOKEN_MAX_LEN];
+
+static void make_tokens(void) {
+    srand(42);
+    for (size_t i = 0; i < TOKEN_COUNT; i++) {
+        const size_t len = 3 + (size_t) rand() % (TOKEN_MAX_LEN - 4);
+        for (size_t j = 0; j < len; j++) {
+            tokens[i][j] = 'a' + (char) (rand() % 26);
+        }
+        tokens[i][len] = '\0';
+    }
+}
+
+static void bench_new(void) {
+    const size_t allocs = bench_alloc_count;
+    const double start = bench_now();
+
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        str_t* string = str_new(tokens[i % TOKEN_COUNT]);
+        str_drop(&string);
+    }
+
+    bench_report("str_new", ITERATIONS, bench_now() - start, bench_alloc_count - allocs);
+}
+
+static void bench_copy(void) {
+    str_t* strings[TOKEN_COUNT];
+    for (size_t i = 0; i < TOKEN_COUNT; i++) {
+        strings[i] = str_new(tokens[i]);
+    }
+
+    const size_t allocs = bench_alloc_count;
+    const double start = bench_now();
+
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        str_t* copy = str_copy(strings[i % TOKEN_COUNT]);
+        str_drop(&copy);
+    }
+
+    bench_report("str_copy", ITERATIONS, bench_now() - start, bench_alloc_count - allocs);
+
+    for (size_t i = 0; i < TOKEN_COUNT; i++) {
+        str_drop(&strings[i]);
+    }
+}
+
+static void bench_copy_shared(void) {
+    char line[4096];
+    for (size_t i = 0; i < (sizeof(line) - 1); i++) {
+        line[i] = 'a' + (char) (i % 26);
+    }
+    line[sizeof(line) - 1] = '\0';
+
+    str_t* string = str_new(line);
+
+    size_t allocs = bench_alloc_count;
+    double start = bench_now();
+
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        str_t* copy = str_copy(string);
+        str_drop(&copy);
+    }
+
+    bench_report("str_copy (4 KiB)", ITERATIONS, bench_now() - start, bench_alloc_count - allocs);
+
+    str_make_shared(string);
+
+    allocs = bench_alloc_count;
+    start = bench_now();
+
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        str_t* copy = str_copy(string);
+        str_drop(&copy);
+    }
+
+    bench_report("str_copy (4 KiB, shared)", ITERATIONS, bench_now() - start, bench_alloc_count - allocs);
+
+    str_drop(&string);
+}
+
+static void bench_long(void) {
+    char line[256];
+    for (size_t i = 0; i < (sizeof(line) - 1); i++) {
+        line[i] = 'a' + (char) (i % 26);
+    }
+    line[sizeof(line) - 1] = '\0';
+
+    size_t allocs = bench_alloc_count;
+    double start = bench_now();
+
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        str_t* string = str_new(line + (i % 64));
+        str_drop(&string);
+    }
+
+    bench_report("str_new (long)", ITERATIONS, bench_now() - start, bench_alloc_count - allocs);
+
+    str_t* half_a = str_new(line + 128);
+    str_t* half_b = str_new(line + 100);
+
+    allocs = bench_alloc_count;
+    start = bench_now();
+
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        str_t* string = str_concat(half_a, half_b);
+        str_drop(&string);
+    }
+
+    bench_report("str_concat (long)", ITERATIONS, bench_now() - start, bench_alloc_count - allocs);
+
+    str_drop(&half_a);
+    str_drop(&half_b);
+}
+
+static void bench_split(void) {
+    str_t* line = str_new(NULL);
+    for (size_t i = 0; i < 64; i++) {
+        str_append(line, tokens[i]);
+        str_append(line, " ");
+    }
+
+    size_t allocs = bench_alloc_count;
+    double start = bench_now();
+
+    for (size_t i = 0; i < SPLIT_ITERATIONS; i++) {
+        str_list_t* list = str_split_whitespace(line);
+        str_list_drop(&list);
+    }
+
+    /* Reported per token */
+    bench_report("str_split (per token)", SPLIT_ITERATIONS * 64,
+        bench_now() - start, bench_alloc_count - allocs);
+
+    size_t total_len = 0;
+    allocs = bench_alloc_count;
+    start = bench_now();
+
+    for (size_t i = 0; i < SPLIT_ITERATIONS; i++) {
+        str_split_iter_t it = str_split_whitespace_iter(str_as_view(line));
+        str_view_t token;
+        while (str_split_iter_next(&it, &token)) {
+            total_len += token.len;
+        }
+    }
+
+    bench_report("str_split_iter (per token)", SPLIT_ITERATIONS * 64,
+        bench_now() - start, bench_alloc_count - allocs);
+
+    /* Keeps the loop from being optimized out */
+    if (total_len == 0) {
+        puts("unreachable");
+    }
+
+    str_drop(&line);
+}
+
+static void bench_hash(void) {
+    static const size_t lengths[] = {8, 64, 1024};
+    char text[1024];
+
+    for (size_t i = 0; i < sizeof(text); i++) {
+        text[i] = 'a' + (char) (i % 26);
+    }
+
+    for (size_t n = 0; n < (sizeof(lengths) / sizeof(lengths[0])); n++) {
+        const str_view_t view = str_view_from_parts(text, lengths[n]);
+        uint64_t hash = 0;
+        char name[32];
+
+        const double start = bench_now();
+
+        for (size_t i = 0; i < ITERATIONS; i++) {
+            hash ^= str_view_hash(view, i);
+        }
+
+        snprintf(name, sizeof(name), "str_hash (%zu B)", lengths[n]);
+        bench_report(name, ITERATIONS, bench_now() - start, 0);
+
+        if (hash == 0) {
+            puts("unreachable");
+        }
+    }
+}
+
+static void bench_replace(void) {
+    static const char* const replacements[] = {"*", "<val>", "<longer-value>"};
+    static const char* const names[] = {
+        "str_replace (4 KiB, shrink)", "str_replace (4 KiB, equal)", "str_replace (4 KiB, grow)",
+    };
+    char text[4096];
+
+    for (size_t i = 0; i < (sizeof(text) - 1); i++) {
+        text[i] = ((i % 32) < 5) ? "<key>"[i % 32] : 'a' + (char) (i % 26);
+    }
+    text[sizeof(text) - 1] = '\0';
+
+    for (size_t n = 0; n < (sizeof(replacements) / sizeof(replacements[0])); n++) {
+        const size_t allocs = bench_alloc_count;
+        const double start = bench_now();
+
+        /* Includes the construction of the string to be replaced in */
+        for (size_t i = 0; i < SPLIT_ITERATIONS; i++) {
+            str_t* string = str_new(text);
+            str_replace(string, "<key>", replacements[n]);
+            str_drop(&string);
+        }
+
+        bench_report(names[n], SPLIT_ITERATIONS, bench_now() - start, bench_alloc_count - allocs);
+    }
+}
+
+int main(void) {
+    bench_init();
+    make_tokens();
+
+    bench_new();
+    bench_copy();
+    bench_copy_shared();
+    bench_split();
+    bench_long();
+    bench_hash();
+    bench_replace();
+
+    return 0;
+}
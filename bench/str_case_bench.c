@@ -0,0 +1,141 @@
+/**************************************************************************//**
+ *
+ * @file    str_case_bench.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * Case conversion of 64 B, 4 KiB and 1 MiB strings. Case-insensitive
+ * equality and search on 4 KiB strings: str_eq_ignore_case and
+ * str_contains_ignore_case against lowercased copies compared with
+ * str_eq and str_contains.
+ *
+ *****************************************************************************/
+
+#include <stdlib.h>
+
+#include <ustring/str.h>
+
+#include "bench.h"
+
+#define TEXT_LEN ((size_t) 1 << 20)
+#define COMPARE_LEN ((size_t) 4096)
+#define BYTES_PER_ITERATION ((size_t) 1 << 26)
+#define ITERATIONS ((size_t) 100000)
+
+static char* make_text(size_t len) {
+    static const char* words[] = {"Hello", "WORLD", "user_id=42", "Status", "ok", "GET /Index.html"};
+    char* text = malloc(len + 32);
+    size_t written = 0;
+
+    srand(42);
+    while (written < len) {
+        written += (size_t) snprintf(text + written, 32, "%s ", words[rand() % 6]);
+    }
+    text[len] = '\0';
+
+    return text;
+}
+
+static void bench_convert(void) {
+    static const size_t lengths[] = {64, 4096, TEXT_LEN};
+    char* text = make_text(TEXT_LEN);
+
+    for (size_t n = 0; n < (sizeof(lengths) / sizeof(lengths[0])); n++) {
+        const size_t iterations = BYTES_PER_ITERATION / lengths[n];
+        const char saved = text[lengths[n]];
+        char name[48];
+
+        text[lengths[n]] = '\0';
+        str_t* string = str_new(text);
+        text[lengths[n]] = saved;
+
+        const double start = bench_now();
+
+        for (size_t i = 0; i < iterations; i++) {
+            if (i % 2 == 0) {
+                str_to_lowercase(string);
+            } else {
+                str_to_uppercase(string);
+            }
+        }
+
+        snprintf(name, sizeof(name), "str_to_case (%zu B)", lengths[n]);
+        bench_report(name, iterations, bench_now() - start, 0);
+
+        str_drop(&string);
+    }
+
+    free(text);
+}
+
+static void bench_compare(void) {
+    char* text = make_text(COMPARE_LEN);
+    str_t* a = str_new(text);
+    str_t* b = str_new(text);
+    size_t found = 0;
+
+    str_to_uppercase(b);
+
+    size_t allocs = bench_alloc_count;
+    double start = bench_now();
+
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        str_t* lower_a = str_copy(a);
+        str_t* lower_b = str_copy(b);
+        str_to_lowercase(lower_a);
+        str_to_lowercase(lower_b);
+        found += str_eq(lower_a, lower_b);
+        str_drop(&lower_b);
+        str_drop(&lower_a);
+    }
+
+    bench_report("eq lowercased copies", ITERATIONS, bench_now() - start, bench_alloc_count - allocs);
+
+    allocs = bench_alloc_count;
+    start = bench_now();
+
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        found += str_eq_ignore_case(a, b);
+    }
+
+    bench_report("str_eq_ignore_case", ITERATIONS, bench_now() - start, bench_alloc_count - allocs);
+
+    /* Pattern absent from the text: the whole string is scanned */
+    allocs = bench_alloc_count;
+    start = bench_now();
+
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        str_t* lower = str_copy(b);
+        str_to_lowercase(lower);
+        found += str_contains(lower, "status=500");
+        str_drop(&lower);
+    }
+
+    bench_report("contains lowercased", ITERATIONS, bench_now() - start, bench_alloc_count - allocs);
+
+    allocs = bench_alloc_count;
+    start = bench_now();
+
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        found += str_contains_ignore_case(b, "Status=500");
+    }
+
+    bench_report("str_contains_ignore_case", ITERATIONS, bench_now() - start, bench_alloc_count - allocs);
+
+    if (found != 2 * ITERATIONS) {
+        puts("unreachable");
+    }
+
+    str_drop(&b);
+    str_drop(&a);
+    free(text);
+}
+
+int main(void) {
+    bench_init();
+
+    bench_convert();
+    bench_compare();
+
+    return 0;
+}
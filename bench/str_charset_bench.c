@@ -0,0 +1,141 @@
+/**************************************************************************//**
+ *
+ * @file    str_charset_bench.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * Predicate callbacks against character sets on 1 MiB of text:
+ * str_contains_fn and str_contains_set searching for an absent digit,
+ * str_trim_matches_fn and str_trim_matches_set removing blanks,
+ * str_trim_start_matches_fn and str_trim_start_matches_set
+ * removing 64 KiB of leading whitespace.
+ *
+ *****************************************************************************/
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ustring/str.h>
+#include <ustring/str_charset.h>
+
+#include "bench.h"
+
+#define TEXT_LEN ((size_t) 1 << 20)
+#define LEADING_LEN ((size_t) 1 << 16)
+#define ITERATIONS ((size_t) 50)
+
+static bool is_digit(char ch) {
+    return isdigit((unsigned char) ch);
+}
+
+static bool is_blank(char ch) {
+    return (ch == ' ') || (ch == '\t');
+}
+
+static bool is_space(char ch) {
+    return isspace((unsigned char) ch);
+}
+
+static char* make_text(void) {
+    static const char* words[] = {"lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing"};
+    char* text = malloc(TEXT_LEN + 16);
+    size_t len = 0;
+
+    srand(42);
+    while (len < TEXT_LEN) {
+        len += (size_t) snprintf(text + len, 16, "%s%c", words[rand() % 7], (rand() % 4 == 0) ? '\t' : ' ');
+    }
+    text[TEXT_LEN] = '\0';
+
+    return text;
+}
+
+static void bench_contains(const str_t* string) {
+    const str_charset_t digit = str_charset_digit();
+    size_t found = 0;
+
+    double start = bench_now();
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        found += str_contains_fn(string, is_digit);
+    }
+    bench_report("str_contains_fn", ITERATIONS, bench_now() - start, 0);
+
+    start = bench_now();
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        found += str_contains_set(string, &digit);
+    }
+    bench_report("str_contains_set", ITERATIONS, bench_now() - start, 0);
+
+    if (found != 0) {
+        puts("unreachable");
+    }
+}
+
+static void bench_trim_matches(const str_t* string) {
+    const str_charset_t blank = str_charset_blank();
+
+    /* Includes the copy of the string to be trimmed */
+    double start = bench_now();
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        str_t* copy = str_copy(string);
+        str_trim_matches_fn(copy, is_blank);
+        str_drop(&copy);
+    }
+    bench_report("str_trim_matches_fn", ITERATIONS, bench_now() - start, 0);
+
+    start = bench_now();
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        str_t* copy = str_copy(string);
+        str_trim_matches_set(copy, &blank);
+        str_drop(&copy);
+    }
+    bench_report("str_trim_matches_set", ITERATIONS, bench_now() - start, 0);
+}
+
+static void bench_trim_start(const char* text) {
+    const str_charset_t space = str_charset_space();
+    char* padded = malloc(LEADING_LEN + TEXT_LEN + 1);
+
+    for (size_t i = 0; i < LEADING_LEN; i++) {
+        padded[i] = " \t\n"[i % 3];
+    }
+    memcpy(padded + LEADING_LEN, text, TEXT_LEN + 1);
+
+    str_t* string = str_new(padded);
+
+    double start = bench_now();
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        str_t* copy = str_copy(string);
+        str_trim_start_matches_fn(copy, is_space);
+        str_drop(&copy);
+    }
+    bench_report("str_trim_start_fn", ITERATIONS, bench_now() - start, 0);
+
+    start = bench_now();
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        str_t* copy = str_copy(string);
+        str_trim_start_matches_set(copy, &space);
+        str_drop(&copy);
+    }
+    bench_report("str_trim_start_set", ITERATIONS, bench_now() - start, 0);
+
+    str_drop(&string);
+    free(padded);
+}
+
+int main(void) {
+    bench_init();
+
+    char* text = make_text();
+    str_t* string = str_new(text);
+
+    bench_contains(string);
+    bench_trim_matches(string);
+    bench_trim_start(text);
+
+    str_drop(&string);
+    free(text);
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+/**************************************************************************//**
+ *
+ * @file    str_cmp_bench.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * Comparison of equal strings from 1 B to 1 MiB held in different buffers,
+ * so every character is examined: str_eq against the character by character
+ * loop, str_cmp of strings differing in the last character.
+ *
+ *****************************************************************************/
+
+#include <stdlib.h>
+
+#include <ustring/str.h>
+
+#include "bench.h"
+
+#define MAX_LEN ((size_t) 1 << 20)
+#define BYTES_PER_ITERATION ((size_t) 1 << 28)
+#define MAX_ITERATIONS ((size_t) 10000000)
+
+/* Character by character loop, as str_eq compared the strings before */
+static bool byte_loop_eq(const str_t* a, const str_t* b) {
+    const char* a_ptr = str_as_ptr(a);
+    const char* b_ptr = str_as_ptr(b);
+    const size_t len = str_len(a);
+
+    if (len != str_len(b)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        if (a_ptr[i] != b_ptr[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(void) {
+    static const size_t lengths[] = {1, 8, 16, 64, 256, 4096, 65536, MAX_LEN};
+    char* text = malloc(MAX_LEN + 1);
+    size_t equal = 0;
+
+    bench_init();
+
+    for (size_t len = 0; len < MAX_LEN; len++) {
+        text[len] = 'a' + (char) (len % 26);
+    }
+
+    for (size_t n = 0; n < (sizeof(lengths) / sizeof(lengths[0])); n++) {
+        const size_t len = lengths[n];
+        const size_t budget = BYTES_PER_ITERATION / len;
+        const size_t iterations = (budget < MAX_ITERATIONS) ? budget : MAX_ITERATIONS;
+        char name[48];
+
+        text[len] = '\0';
+        str_t* a = str_new(text);
+        str_t* b = str_new(text);
+        str_t* c = str_new(text);
+        text[len] = 'a' + (char) (len % 26);
+
+        str_truncate(c, len - 1);
+        str_append(c, "~");
+
+        double start = bench_now();
+        for (size_t i = 0; i < iterations; i++) {
+            equal += byte_loop_eq(a, b);
+        }
+        snprintf(name, sizeof(name), "byte loop eq (%zu B)", len);
+        bench_report(name, iterations, bench_now() - start, 0);
+
+        start = bench_now();
+        for (size_t i = 0; i < iterations; i++) {
+            equal += str_eq(a, b);
+        }
+        snprintf(name, sizeof(name), "str_eq (%zu B)", len);
+        bench_report(name, iterations, bench_now() - start, 0);
+
+        start = bench_now();
+        for (size_t i = 0; i < iterations; i++) {
+            equal += (str_cmp(a, c) < 0);
+        }
+        snprintf(name, sizeof(name), "str_cmp (%zu B)", len);
+        bench_report(name, iterations, bench_now() - start, 0);
+
+        if (equal != 3 * iterations) {
+            puts("unreachable");
+        }
+        equal = 0;
+
+        str_drop(&c);
+        str_drop(&b);
+        str_drop(&a);
+    }
+
+    free(text);
+
+    return 0;
+}
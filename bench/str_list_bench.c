@@ -0,0 +1,157 @@
+/**************************************************************************//**
+ * 
+ * @file    str_list_bench.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ * 
+ * String list benchmarks: split, iteration and join of 1M short
+ * tokens stored in str_list_t and in str_list_flat_t, sequential
+ * and parallel split on all online processors.
+ * 
+ *****************************************************************************/
+
+#include <stdlib.h>
+
+#include <ustring/str.h>
+#include <ustring/str_list.h>
+#include <ustring/str_list_flat.h>
+#include <ustring/str_view.h>
+
+#include "bench.h"
+
+#define TOKEN_COUNT ((size_t) 1000000)
+#define ITERATIONS ((size_t) 5)
+
+static str_t* make_input(void) {
+    str_t* input = str_with_capacity(TOKEN_COUNT * 10);
+
+    srand(42);
+    for (size_t i = 0; i < TOKEN_COUNT; i++) {
+        char token[16];
+        const size_t len = 3 + (size_t) rand() % 10;
+        for (size_t j = 0; j < len; j++) {
+            token[j] = 'a' + (char) (rand() % 26);
+        }
+        token[len] = ',';
+        token[len + 1] = '\0';
+        str_append(input, token);
+    }
+
+    return input;
+}
+
+static void bench_list(const str_t* input) {
+    size_t total_len = 0;
+    double split_time = 0.0;
+    double iter_time = 0.0;
+    double join_time = 0.0;
+    double join_into_time = 0.0;
+    const size_t allocs = bench_alloc_count;
+
+    for (size_t n = 0; n < ITERATIONS; n++) {
+        double start = bench_now();
+        str_list_t* list = str_split(input, ",");
+        split_time += bench_now() - start;
+
+        start = bench_now();
+        for (size_t i = 0; i < str_list_size(list); i++) {
+            total_len += str_len(str_list_at(list, i));
+        }
+        iter_time += bench_now() - start;
+
+        start = bench_now();
+        str_t* joined = str_list_join(list, ",");
+        join_time += bench_now() - start;
+
+        start = bench_now();
+        str_clear(joined);
+        str_list_join_into(joined, list, ",");
+        join_into_time += bench_now() - start;
+
+        str_drop(&joined);
+        str_list_drop(&list);
+    }
+
+    const size_t ops = ITERATIONS * TOKEN_COUNT;
+    bench_report("str_split", ops, split_time, bench_alloc_count - allocs);
+    bench_report("str_list iterate", ops, iter_time, 0);
+    bench_report("str_list_join", ops, join_time, 0);
+    bench_report("str_list_join_into", ops, join_into_time, 0);
+
+    if (total_len == 0) {
+        puts("unreachable");
+    }
+}
+
+static void bench_list_flat(const str_t* input) {
+    size_t total_len = 0;
+    double split_time = 0.0;
+    double iter_time = 0.0;
+    double join_time = 0.0;
+    const size_t allocs = bench_alloc_count;
+
+    for (size_t n = 0; n < ITERATIONS; n++) {
+        double start = bench_now();
+        str_list_flat_t* list = str_list_flat_new();
+        str_split_into(list, str_as_view(input), ",");
+        split_time += bench_now() - start;
+
+        start = bench_now();
+        for (size_t i = 0; i < str_list_flat_size(list); i++) {
+            total_len += str_list_flat_at(list, i).len;
+        }
+        iter_time += bench_now() - start;
+
+        start = bench_now();
+        str_t* joined = str_list_flat_join(list, ",");
+        join_time += bench_now() - start;
+
+        str_drop(&joined);
+        str_list_flat_drop(&list);
+    }
+
+    const size_t ops = ITERATIONS * TOKEN_COUNT;
+    bench_report("str_split_into (flat)", ops, split_time, bench_alloc_count - allocs);
+    bench_report("str_list_flat iterate", ops, iter_time, 0);
+    bench_report("str_list_flat_join", ops, join_time, 0);
+
+    if (total_len == 0) {
+        puts("unreachable");
+    }
+}
+
+static void bench_par_split(const str_t* input) {
+    double split_time = 0.0;
+    double split_into_time = 0.0;
+
+    for (size_t n = 0; n < ITERATIONS; n++) {
+        double start = bench_now();
+        str_list_t* list = str_par_split(input, ",", 0);
+        split_time += bench_now() - start;
+        str_list_drop(&list);
+
+        str_list_flat_t* flat = str_list_flat_new();
+        start = bench_now();
+        str_par_split_into(flat, str_as_view(input), ",", 0);
+        split_into_time += bench_now() - start;
+        str_list_flat_drop(&flat);
+    }
+
+    const size_t ops = ITERATIONS * TOKEN_COUNT;
+    bench_report("str_par_split", ops, split_time, 0);
+    bench_report("str_par_split_into", ops, split_into_time, 0);
+}
+
+int main(void) {
+    bench_init();
+
+    str_t* input = make_input();
+
+    bench_list(input);
+    bench_list_flat(input);
+    bench_par_split(input);
+
+    str_drop(&input);
+
+    return 0;
+}
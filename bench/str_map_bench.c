@@ -0,0 +1,88 @@
+/**************************************************************************//**
+ *
+ * @file    str_map_bench.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * String set benchmarks: deduplication of 1M short tokens
+ * with 100k distinct values, lookup hits and misses.
+ *
+ *****************************************************************************/
+
+#include <stdlib.h>
+
+#include <ustring/str.h>
+#include <ustring/str_list_flat.h>
+#include <ustring/str_map.h>
+#include <ustring/str_view.h>
+
+#include "bench.h"
+
+#define TOKEN_COUNT ((size_t) 1000000)
+#define DISTINCT_COUNT ((size_t) 100000)
+#define ITERATIONS ((size_t) 5)
+
+static str_list_flat_t* make_tokens(char first) {
+    str_list_flat_t* tokens = str_list_flat_with_capacity(TOKEN_COUNT, TOKEN_COUNT * 12);
+    char token[32];
+
+    srand(42);
+    for (size_t i = 0; i < TOKEN_COUNT; i++) {
+        const int len = snprintf(token, sizeof(token), "%c/key/%zu",
+            first, (size_t) rand() % DISTINCT_COUNT);
+        str_list_flat_push(tokens, str_view_from_parts(token, (size_t) len));
+    }
+
+    return tokens;
+}
+
+int main(void) {
+    bench_init();
+
+    str_list_flat_t* tokens = make_tokens('h');
+    str_list_flat_t* misses = make_tokens('m');
+
+    size_t found = 0;
+    double insert_time = 0.0;
+    double hit_time = 0.0;
+    double miss_time = 0.0;
+    const size_t allocs = bench_alloc_count;
+
+    for (size_t n = 0; n < ITERATIONS; n++) {
+        str_set_t* set = str_set_new();
+
+        double start = bench_now();
+        for (size_t i = 0; i < TOKEN_COUNT; i++) {
+            str_set_insert_view(set, str_list_flat_at(tokens, i));
+        }
+        insert_time += bench_now() - start;
+
+        start = bench_now();
+        for (size_t i = 0; i < TOKEN_COUNT; i++) {
+            found += str_set_contains_view(set, str_list_flat_at(tokens, i));
+        }
+        hit_time += bench_now() - start;
+
+        start = bench_now();
+        for (size_t i = 0; i < TOKEN_COUNT; i++) {
+            found += str_set_contains_view(set, str_list_flat_at(misses, i));
+        }
+        miss_time += bench_now() - start;
+
+        str_set_drop(&set);
+    }
+
+    const size_t ops = ITERATIONS * TOKEN_COUNT;
+    bench_report("str_set_insert (dedup)", ops, insert_time, bench_alloc_count - allocs);
+    bench_report("str_set_contains hit", ops, hit_time, 0);
+    bench_report("str_set_contains miss", ops, miss_time, 0);
+
+    if (found == 0) {
+        puts("unreachable");
+    }
+
+    str_list_flat_drop(&misses);
+    str_list_flat_drop(&tokens);
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+/**************************************************************************//**
+ *
+ * @file    str_matcher_bench.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * Redaction of 16 and 64 patterns in 1 MB of log lines: str_contains and
+ * str_replace called once per pattern against a single str_replace_many
+ * pass, with replacements shorter than the patterns (in place) and
+ * longer than the patterns (single allocation).
+ *
+ *****************************************************************************/
+
+#include <stdlib.h>
+
+#include <ustring/str.h>
+#include <ustring/str_matcher.h>
+
+#include "bench.h"
+
+#define TEXT_LEN ((size_t) 1 << 20)
+#define NAMED_PATTERN_COUNT ((size_t) 16)
+#define PATTERN_COUNT ((size_t) 64)
+#define ITERATIONS ((size_t) 20)
+
+static const char* named_patterns[NAMED_PATTERN_COUNT] = {
+    "password", "passwd", "secret", "token", "api_key", "apikey", "session",
+    "cookie", "authorization", "bearer", "private_key", "ssn", "credit_card",
+    "cvv", "pin_code", "iban",
+};
+
+static char extra_patterns[PATTERN_COUNT - NAMED_PATTERN_COUNT][16];
+static const char* patterns[PATTERN_COUNT];
+
+static const char* words[] = {
+    "user", "request", "GET", "POST", "/v1/orders", "status=200", "latency=12ms",
+    "password", "token", "session", "ok", "retry", "bearer", "cache", "miss",
+};
+
+static char* make_text(void) {
+    char* text = malloc(TEXT_LEN + 64);
+    size_t len = 0;
+
+    srand(42);
+    while (len < TEXT_LEN) {
+        len += (size_t) snprintf(text + len, 64, "%s ", words[rand() % 15]);
+        if (rand() % 12 == 0) {
+            text[len - 1] = '\n';
+        }
+    }
+    text[TEXT_LEN] = '\0';
+
+    return text;
+}
+
+static void bench_redact(const char* name, size_t count, const char* const* replacements) {
+    char* text = make_text();
+    char label[64];
+
+    size_t allocs = bench_alloc_count;
+    double start = bench_now();
+
+    for (size_t n = 0; n < ITERATIONS; n++) {
+        str_t* string = str_new(text);
+        for (size_t i = 0; i < count; i++) {
+            if (str_contains(string, patterns[i])) {
+                str_replace(string, patterns[i], replacements[i]);
+            }
+        }
+        str_drop(&string);
+    }
+
+    snprintf(label, sizeof(label), "replace x%zu %s", count, name);
+    bench_report(label, ITERATIONS, bench_now() - start, bench_alloc_count - allocs);
+
+    str_matcher_t* matcher = str_matcher_new(patterns, count);
+
+    allocs = bench_alloc_count;
+    start = bench_now();
+
+    for (size_t n = 0; n < ITERATIONS; n++) {
+        str_t* string = str_new(text);
+        str_replace_many(string, matcher, replacements);
+        str_drop(&string);
+    }
+
+    snprintf(label, sizeof(label), "replace_many x%zu %s", count, name);
+    bench_report(label, ITERATIONS, bench_now() - start, bench_alloc_count - allocs);
+
+    str_matcher_drop(&matcher);
+    free(text);
+}
+
+int main(void) {
+    const char* shrink[PATTERN_COUNT];
+    const char* grow[PATTERN_COUNT];
+
+    for (size_t i = 0; i < PATTERN_COUNT; i++) {
+        if (i < NAMED_PATTERN_COUNT) {
+            patterns[i] = named_patterns[i];
+        } else {
+            snprintf(extra_patterns[i - NAMED_PATTERN_COUNT], 16, "field_%02zu", i);
+            patterns[i] = extra_patterns[i - NAMED_PATTERN_COUNT];
+        }
+
+        shrink[i] = "***";
+        grow[i] = "[REDACTED-SENSITIVE]";
+    }
+
+    bench_init();
+
+    bench_redact("shrink", NAMED_PATTERN_COUNT, shrink);
+    bench_redact("grow", NAMED_PATTERN_COUNT, grow);
+    bench_redact("shrink", PATTERN_COUNT, shrink);
+    bench_redact("grow", PATTERN_COUNT, grow);
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+/**************************************************************************//**
+ *
+ * @file    str_pattern_bench.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * Filtering of short log lines with the same patterns: str_contains,
+ * str_trim_end_matches and str_replace taking the pattern characters
+ * against the _pat variants taking the compiled pattern, for short
+ * and long (Horspool) patterns.
+ *
+ *****************************************************************************/
+
+#include <stdlib.h>
+
+#include <ustring/str.h>
+#include <ustring/str_list.h>
+#include <ustring/str_pattern.h>
+
+#include "bench.h"
+
+#define LINE_COUNT ((size_t) 4096)
+#define ROUNDS ((size_t) 200)
+
+#define SHORT_PATTERN "ERROR"
+#define LONG_PATTERN "connection reset by peer while reading response"
+
+static const char* words[] = {
+    "INFO", "WARN", "ERROR", "request", "served", "in", "12ms", "user=42", "GET", "/v1/items",
+};
+
+static str_list_t* make_lines(void) {
+    str_list_t* lines = str_list_new();
+    char line[128];
+
+    srand(42);
+    for (size_t i = 0; i < LINE_COUNT; i++) {
+        size_t len = 0;
+        for (size_t j = 0; j < 6; j++) {
+            len += (size_t) snprintf(line + len, sizeof(line) - len, "%s ", words[rand() % 10]);
+        }
+        if (rand() % 16 == 0) {
+            snprintf(line + len, sizeof(line) - len, "%s", LONG_PATTERN);
+        }
+        str_list_push(lines, str_new(line));
+    }
+
+    return lines;
+}
+
+static void bench_contains(const char* name, const char* pattern) {
+    str_list_t* lines = make_lines();
+    size_t found = 0;
+    char label[48];
+
+    double start = bench_now();
+
+    for (size_t n = 0; n < ROUNDS; n++) {
+        for (size_t i = 0; i < LINE_COUNT; i++) {
+            found += str_contains(str_list_at(lines, i), pattern);
+        }
+    }
+
+    snprintf(label, sizeof(label), "str_contains (%s)", name);
+    bench_report(label, ROUNDS * LINE_COUNT, bench_now() - start, 0);
+
+    str_pattern_t* compiled = str_pattern_compile(pattern);
+    start = bench_now();
+
+    for (size_t n = 0; n < ROUNDS; n++) {
+        for (size_t i = 0; i < LINE_COUNT; i++) {
+            found += str_contains_pat(str_list_at(lines, i), compiled);
+        }
+    }
+
+    snprintf(label, sizeof(label), "str_contains_pat (%s)", name);
+    bench_report(label, ROUNDS * LINE_COUNT, bench_now() - start, 0);
+
+    /* Keeps the loop from being optimized out */
+    if (found == 0) {
+        puts("unreachable");
+    }
+
+    str_pattern_drop(&compiled);
+    str_list_drop(&lines);
+}
+
+static void bench_edit(void) {
+    str_list_t* lines = make_lines();
+    str_pattern_t* end = str_pattern_compile(" ");
+    str_pattern_t* error = str_pattern_compile(SHORT_PATTERN);
+
+    size_t allocs = bench_alloc_count;
+    double start = bench_now();
+
+    for (size_t i = 0; i < LINE_COUNT; i++) {
+        str_t* line = str_list_at(lines, i);
+        str_trim_end_matches(line, " ");
+        str_replace(line, SHORT_PATTERN, "E");
+    }
+
+    bench_report("trim + replace", LINE_COUNT, bench_now() - start, bench_alloc_count - allocs);
+    str_list_drop(&lines);
+
+    lines = make_lines();
+    allocs = bench_alloc_count;
+    start = bench_now();
+
+    for (size_t i = 0; i < LINE_COUNT; i++) {
+        str_t* line = str_list_at(lines, i);
+        str_trim_end_matches_pat(line, end);
+        str_replace_pat(line, error, "E");
+    }
+
+    bench_report("trim + replace (_pat)", LINE_COUNT, bench_now() - start, bench_alloc_count - allocs);
+
+    str_pattern_drop(&error);
+    str_pattern_drop(&end);
+    str_list_drop(&lines);
+}
+
+int main(void) {
+    bench_init();
+
+    bench_contains("short", SHORT_PATTERN);
+    bench_contains("long", LONG_PATTERN);
+    bench_edit();
+
+    return 0;
+}
@@ -0,0 +1,195 @@
+/**************************************************************************//**
+ *
+ * @file    str_rope_bench.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * Editing of 1 MB documents: filling 1000 distinct placeholders with
+ * repeated str_replace against str_rope_replace, 2000 inserts at random
+ * positions with str_concat of the parts against str_rope_insert, and
+ * building the document of 1 KB pieces with str_concat against
+ * str_rope_append. Rope timings include flattening into a string.
+ *
+ *****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <ustring/str.h>
+#include <ustring/str_rope.h>
+#include <ustring/str_view.h>
+
+#include "bench.h"
+
+#define DOCUMENT_LEN ((size_t) 1 << 20)
+#define PLACEHOLDER_COUNT ((size_t) 1000)
+#define PLACEHOLDER_LEN ((size_t) 9)
+#define INSERT_COUNT ((size_t) 2000)
+#define PIECE_LEN ((size_t) 1024)
+
+static char* make_document(size_t* positions) {
+    char* document = malloc(DOCUMENT_LEN + 1);
+    const size_t stride = DOCUMENT_LEN / PLACEHOLDER_COUNT;
+
+    for (size_t i = 0; i < DOCUMENT_LEN; i++) {
+        document[i] = (i % 64 == 63) ? '\n' : 'a' + (char) (i % 26);
+    }
+    document[DOCUMENT_LEN] = '\0';
+
+    for (size_t i = 0; i < PLACEHOLDER_COUNT; i++) {
+        char placeholder[PLACEHOLDER_LEN + 1];
+        snprintf(placeholder, sizeof(placeholder), "{{k%04zu}}", i);
+        memcpy(document + i * stride, placeholder, PLACEHOLDER_LEN);
+        positions[i] = i * stride;
+    }
+
+    return document;
+}
+
+static void bench_fill(void) {
+    static size_t positions[PLACEHOLDER_COUNT];
+    char* document = make_document(positions);
+    char placeholder[PLACEHOLDER_LEN + 1];
+    char value[32];
+
+    size_t allocs = bench_alloc_count;
+    double start = bench_now();
+
+    str_t* string = str_new(document);
+    for (size_t i = 0; i < PLACEHOLDER_COUNT; i++) {
+        snprintf(placeholder, sizeof(placeholder), "{{k%04zu}}", i);
+        snprintf(value, sizeof(value), "value-%zu", i * 7919);
+        str_replace(string, placeholder, value);
+    }
+
+    bench_report("str_replace fill", PLACEHOLDER_COUNT, bench_now() - start, bench_alloc_count - allocs);
+
+    allocs = bench_alloc_count;
+    start = bench_now();
+
+    /* Placeholders are filled from the end, so positions of the others stay valid */
+    str_rope_t* rope = str_rope_from_view(str_view_new(document));
+    for (size_t i = PLACEHOLDER_COUNT; i > 0; i--) {
+        snprintf(value, sizeof(value), "value-%zu", (i - 1) * 7919);
+        str_rope_replace(rope, positions[i - 1], PLACEHOLDER_LEN, str_view_new(value));
+    }
+    str_t* flat = str_rope_to_str(rope);
+
+    bench_report("str_rope_replace fill", PLACEHOLDER_COUNT, bench_now() - start, bench_alloc_count - allocs);
+
+    if (!str_eq(string, flat)) {
+        printf("str_rope_replace fill: result mismatch\n");
+    }
+
+    str_drop(&flat);
+    str_rope_drop(&rope);
+    str_drop(&string);
+    free(document);
+}
+
+static void bench_insert(void) {
+    static size_t positions[PLACEHOLDER_COUNT];
+    char* document = make_document(positions);
+    const char* text = "<inserted text/>";
+
+    srand(42);
+    size_t* offsets = malloc(INSERT_COUNT * sizeof(size_t));
+    for (size_t i = 0; i < INSERT_COUNT; i++) {
+        offsets[i] = ((size_t) rand() * (size_t) RAND_MAX + (size_t) rand()) % DOCUMENT_LEN;
+    }
+
+    size_t allocs = bench_alloc_count;
+    double start = bench_now();
+
+    str_t* string = str_new(document);
+    for (size_t i = 0; i < INSERT_COUNT; i++) {
+        str_t* prefix = str_from_view(str_view_from_parts(str_as_ptr(string), offsets[i]));
+        str_t* suffix = str_from_view(str_view_from_parts(str_as_ptr(string) + offsets[i], str_len(string) - offsets[i]));
+        str_t* middle = str_new(text);
+        str_t* head = str_concat(prefix, middle);
+
+        str_drop(&string);
+        string = str_concat(head, suffix);
+
+        str_drop(&head);
+        str_drop(&middle);
+        str_drop(&suffix);
+        str_drop(&prefix);
+    }
+
+    bench_report("str_concat insert", INSERT_COUNT, bench_now() - start, bench_alloc_count - allocs);
+
+    allocs = bench_alloc_count;
+    start = bench_now();
+
+    str_rope_t* rope = str_rope_from_view(str_view_new(document));
+    for (size_t i = 0; i < INSERT_COUNT; i++) {
+        str_rope_insert(rope, offsets[i], str_view_new(text));
+    }
+    str_t* flat = str_rope_to_str(rope);
+
+    bench_report("str_rope_insert", INSERT_COUNT, bench_now() - start, bench_alloc_count - allocs);
+
+    if (!str_eq(string, flat)) {
+        printf("str_rope_insert: result mismatch\n");
+    }
+
+    str_drop(&flat);
+    str_rope_drop(&rope);
+    str_drop(&string);
+    free(offsets);
+    free(document);
+}
+
+static void bench_append(void) {
+    const size_t count = DOCUMENT_LEN / PIECE_LEN;
+    char piece[PIECE_LEN + 1];
+
+    for (size_t i = 0; i < PIECE_LEN; i++) {
+        piece[i] = 'a' + (char) (i % 26);
+    }
+    piece[PIECE_LEN] = '\0';
+
+    size_t allocs = bench_alloc_count;
+    double start = bench_now();
+
+    str_t* string = str_new(NULL);
+    str_t* addition = str_new(piece);
+    for (size_t i = 0; i < count; i++) {
+        str_t* result = str_concat(string, addition);
+        str_drop(&string);
+        string = result;
+    }
+
+    bench_report("str_concat append", count, bench_now() - start, bench_alloc_count - allocs);
+
+    allocs = bench_alloc_count;
+    start = bench_now();
+
+    str_rope_t* rope = str_rope_new();
+    for (size_t i = 0; i < count; i++) {
+        str_rope_append(rope, str_view_from_parts(piece, PIECE_LEN));
+    }
+    str_t* flat = str_rope_to_str(rope);
+
+    bench_report("str_rope_append", count, bench_now() - start, bench_alloc_count - allocs);
+
+    if (!str_eq(string, flat)) {
+        printf("str_rope_append: result mismatch\n");
+    }
+
+    str_drop(&flat);
+    str_rope_drop(&rope);
+    str_drop(&addition);
+    str_drop(&string);
+}
+
+int main(void) {
+    bench_init();
+
+    bench_fill();
+    bench_insert();
+    bench_append();
+
+    return 0;
+}
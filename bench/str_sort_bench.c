@@ -0,0 +1,123 @@
+/**************************************************************************//**
+ *
+ * @file    str_sort_bench.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * String list sort benchmarks: qsort with the comparison callback
+ * against str_list_sort, str_list_sort_stable and str_list_par_sort
+ * on all online processors, on 1M URLs and 1M log keys, both with
+ * long shared prefixes.
+ *
+ *****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <ustring/str.h>
+#include <ustring/str_list.h>
+
+#include "bench.h"
+
+#define ITEM_COUNT ((size_t) 1000000)
+#define ITERATIONS ((size_t) 3)
+
+static const char* hosts[] = {"example.com", "api.example.com", "cdn.example.org", "shop.example.net"};
+static const char* paths[] = {"users", "orders", "products", "static/img", "search"};
+static const char* services[] = {"api", "auth", "billing", "gateway", "worker"};
+static const char* levels[] = {"debug", "info", "warn", "error"};
+
+static str_list_t* make_urls(void) {
+    str_list_t* list = str_list_with_capacity(ITEM_COUNT);
+    char buffer[128];
+
+    srand(42);
+    for (size_t i = 0; i < ITEM_COUNT; i++) {
+        snprintf(buffer, sizeof(buffer), "https://%s/v1/%s/%d?page=%d",
+            hosts[rand() % 4], paths[rand() % 5], rand() % 100000, rand() % 50);
+        str_list_push(list, str_new(buffer));
+    }
+
+    return list;
+}
+
+static str_list_t* make_log_keys(void) {
+    str_list_t* list = str_list_with_capacity(ITEM_COUNT);
+    char buffer[128];
+
+    srand(42);
+    for (size_t i = 0; i < ITEM_COUNT; i++) {
+        snprintf(buffer, sizeof(buffer), "2026-10-16T%02d:%02d:%02d.%03dZ service=%s level=%s",
+            rand() % 24, rand() % 60, rand() % 60, rand() % 1000,
+            services[rand() % 5], levels[rand() % 4]);
+        str_list_push(list, str_new(buffer));
+    }
+
+    return list;
+}
+
+static int qsort_cmp(const void* a, const void* b) {
+    return strcmp(str_as_ptr(*(str_t* const*) a), str_as_ptr(*(str_t* const*) b));
+}
+
+static void bench_sort(const char* name, str_list_t* (*make)(void)) {
+    double qsort_time = 0.0;
+    double sort_time = 0.0;
+    double stable_time = 0.0;
+    double par_time = 0.0;
+    char label[64];
+
+    for (size_t n = 0; n < ITERATIONS; n++) {
+        str_list_t* list = make();
+        str_t** items = malloc(ITEM_COUNT * sizeof(str_t*));
+
+        for (size_t i = 0; i < ITEM_COUNT; i++) {
+            items[i] = str_list_at(list, i);
+        }
+
+        double start = bench_now();
+        qsort(items, ITEM_COUNT, sizeof(str_t*), qsort_cmp);
+        qsort_time += bench_now() - start;
+
+        free(items);
+        str_list_drop(&list);
+
+        list = make();
+        start = bench_now();
+        str_list_sort(list);
+        sort_time += bench_now() - start;
+        str_list_drop(&list);
+
+        list = make();
+        start = bench_now();
+        str_list_sort_stable(list);
+        stable_time += bench_now() - start;
+        str_list_drop(&list);
+
+        list = make();
+        start = bench_now();
+        str_list_par_sort(list, 0);
+        par_time += bench_now() - start;
+        str_list_drop(&list);
+    }
+
+    const size_t ops = ITERATIONS * ITEM_COUNT;
+
+    snprintf(label, sizeof(label), "qsort %s", name);
+    bench_report(label, ops, qsort_time, 0);
+    snprintf(label, sizeof(label), "str_list_sort %s", name);
+    bench_report(label, ops, sort_time, 0);
+    snprintf(label, sizeof(label), "str_list_sort_stable %s", name);
+    bench_report(label, ops, stable_time, 0);
+    snprintf(label, sizeof(label), "str_list_par_sort %s", name);
+    bench_report(label, ops, par_time, 0);
+}
+
+int main(void) {
+    bench_init();
+
+    bench_sort("urls", make_urls);
+    bench_sort("log keys", make_log_keys);
+
+    return 0;
+}
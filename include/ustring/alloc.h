@@ -0,0 +1,96 @@
+/**************************************************************************//**
+ * 
+ * @file    alloc.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ * 
+ * @brief   Memory allocator API
+ * 
+ * All memory of the library objects is allocated through
+ * allocator vtables, which may be replaced globally or
+ * provided for each object separately.
+ * 
+ *****************************************************************************/
+
+#ifndef __USTRING_ALLOC_H__
+#define __USTRING_ALLOC_H__
+
+#include <stddef.h>
+
+/**
+ * @addtogroup API
+ * @{
+ * 
+ * @addtogroup Allocator
+ * 
+ * Memory allocator API.
+ * 
+ * Every object remembers the allocator it was created with and uses it
+ * for all subsequent allocations, reallocations and deallocations.
+ * Objects created without an explicit allocator use the global
+ * allocator set at the moment of their creation.
+ * 
+ * @code
+ *      static void* pool_alloc(void* ctx, size_t size) { ... }
+ *      static void* pool_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size) { ... }
+ *      static void pool_free(void* ctx, void* ptr) { ... }
+ * 
+ *      const ustring_allocator_t pool_allocator = {
+ *          .alloc = pool_alloc,
+ *          .realloc = pool_realloc,
+ *          .free = pool_free,
+ *          .ctx = &pool,
+ *      };
+ * 
+ *      ustring_set_allocator(&pool_allocator);      // globally
+ *      str_t* s = str_new_alloc(&pool_allocator, "text"); // or per object
+ * @endcode
+ * 
+ * @{
+ */
+
+/**
+ * @brief Allocator vtable
+ * 
+ * Functions must follow the semantics of the standard
+ * @c malloc , @c realloc and @c free functions. Size of the memory
+ * being reallocated is provided for allocators that do not track it.
+ */
+typedef struct ustring_allocator {
+    void* (*alloc) (void* ctx, size_t size);                                    /**< Allocates memory */
+    void* (*realloc) (void* ctx, void* ptr, size_t old_size, size_t new_size);  /**< Resizes memory */
+    void (*free) (void* ctx, void* ptr);                                        /**< Releases memory */
+    void* ctx;                                                                  /**< User context passed to every function */
+} ustring_allocator_t;
+
+/**
+ * @brief Sets the global allocator
+ * 
+ * Global allocator is used by all objects created after the call
+ * without an explicit allocator. Existing objects keep using the
+ * allocator they were created with.
+ * 
+ * @param allocator Pointer to the allocator vtable. If @c NULL ,
+ *      the default allocator based on @c malloc , @c realloc and @c free is restored
+ * @warning Allocator vtable must stay valid while objects created with it exist.
+ *      Function is not thread-safe and should be called before
+ *      objects are created concurrently
+ */
+void ustring_set_allocator(const ustring_allocator_t* allocator);
+
+/**
+ * @brief Returns the global allocator
+ * 
+ * @return Pointer to the current global allocator vtable, never @c NULL
+ */
+const ustring_allocator_t* ustring_get_allocator(void);
+
+/**
+ * @}
+ */ /* Allocator */
+
+/**
+ * @}
+ */ /* API */
+
+#endif /* __USTRING_ALLOC_H__ */
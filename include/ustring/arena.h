@@ -0,0 +1,119 @@
+/**************************************************************************//**
+ * 
+ * @file    arena.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ * 
+ * @brief   Arena allocator API
+ * 
+ * Arena is a bump allocator for objects sharing the same lifetime.
+ * Strings and string lists created in an arena are released all
+ * together by resetting or dropping the arena.
+ * 
+ *****************************************************************************/
+
+#ifndef __USTRING_ARENA_H__
+#define __USTRING_ARENA_H__
+
+#include <stddef.h>
+
+#include "alloc.h"
+
+/**
+ * @addtogroup API
+ * @{
+ * 
+ * @addtogroup Arena
+ * 
+ * Arena allocator API.
+ * 
+ * Arena is a bump allocator for objects sharing the same lifetime.
+ * Objects are created in the arena with @c *_in constructors,
+ * e.g. @c str_new_in or @c str_split_in . Dropping such objects
+ * is allowed but not required: memory is released all together
+ * when the arena is reset or dropped.
+ * 
+ * @warning Arena is not thread-safe
+ * 
+ * @code
+ *      ustring_arena_t* arena = ustring_arena_new(0);
+ * 
+ *      for (;;) {
+ *          str_t* request = str_new_in(arena, read_request());
+ *          str_list_t* fields = str_split_in(arena, request, ";");
+ *          // ...
+ *          ustring_arena_reset(arena); // request and fields are released
+ *      }
+ * @endcode
+ * 
+ * @{
+ */
+
+typedef struct __ustring_arena ustring_arena_t; /**< Arena allocator type */
+
+#define USTRING_ARENA_DEFAULT_BLOCK_SIZE ((size_t) 65536) /**< Default arena block size */
+
+/**
+ * @brief Creates new arena
+ * 
+ * Arena allocates memory from the heap in blocks of the given size.
+ * Allocations larger than the block size get dedicated blocks.
+ * 
+ * @param block_size Size of the arena memory block in bytes.
+ *      If 0, @c USTRING_ARENA_DEFAULT_BLOCK_SIZE is used
+ * @return On success, returns the pointer to the new arena instance. On failure, returns @c NULL
+ */
+ustring_arena_t* ustring_arena_new(size_t block_size);
+
+/**
+ * @brief Releases all objects allocated in the arena
+ * 
+ * One memory block is kept for subsequent allocations,
+ * the rest are returned to the heap.
+ * 
+ * @param self Pointer to the initialized arena instance
+ * @warning All objects created in the arena become invalid and must not be used
+ */
+void ustring_arena_reset(ustring_arena_t* self);
+
+/**
+ * @brief Drops the arena and releases all objects allocated in it
+ * 
+ * @param self Pointer to the pointer to the initialized arena instance
+ * @note If @c self or @c *self is @c NULL, function does nothing
+ * @warning All objects created in the arena become invalid and must not be used,
+ *      the arena pointer passed to the function will be set to @c NULL
+ */
+void ustring_arena_drop(ustring_arena_t** self);
+
+/**
+ * @brief Returns the number of bytes allocated in the arena since the last reset
+ * 
+ * @param self Pointer to the initialized arena instance
+ * @return Number of allocated bytes including alignment padding.
+ *      If @c self is @c NULL , 0 is returned
+ */
+size_t ustring_arena_used(const ustring_arena_t* self);
+
+/**
+ * @brief Returns the allocator vtable allocating memory in the arena
+ * 
+ * Allows passing the arena wherever an allocator is expected,
+ * e.g. to @c str_new_alloc . Arena memory blocks themselves are
+ * allocated with the global allocator set at the moment of the arena creation.
+ * 
+ * @param self Pointer to the initialized arena instance
+ * @return Pointer to the arena allocator vtable, valid until the arena is dropped.
+ *      If @c self is @c NULL , @c NULL is returned
+ */
+const ustring_allocator_t* ustring_arena_allocator(ustring_arena_t* self);
+
+/**
+ * @}
+ */ /* Arena */
+
+/**
+ * @}
+ */ /* API */
+
+#endif /* __USTRING_ARENA_H__ */
@@ -15,8 +15,12 @@
 #define __USTRING_STR_H__
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
 
+#include "alloc.h"
+#include "arena.h"
+
 /**
  * @addtogroup API
  * @{
@@ -33,6 +37,10 @@
 
 typedef struct __str str_t; /**< String type */
 
+#define STR_NPOS ((size_t) -1) /**< Index value denoting "not found" */
+
+#define STR_HASH_DEFAULT_SEED ((uint64_t) 0) /**< Seed of the hash cached in the string */
+
 /**
  * @brief Creates new instance of string
  * 
@@ -47,6 +55,29 @@ typedef struct __str str_t; /**< String type */
  */
 str_t* str_new(const char* string);
 
+/**
+ * @brief Creates new instance of string in the arena
+ * 
+ * Same as @c str_new , but the string and its buffer are allocated in the arena.
+ * 
+ * @param arena Pointer to the initialized arena instance. If @c NULL , the global allocator is used
+ * @param string Null-terminated byte string of valid ASCII characters
+ * @return On success, returns the pointer to the new string instance. On failure, returns @c NULL
+ */
+str_t* str_new_in(ustring_arena_t* arena, const char* string);
+
+/**
+ * @brief Creates new instance of string with the allocator
+ * 
+ * Same as @c str_new , but the memory is allocated with the given allocator,
+ * which is then used by the instance for all subsequent operations.
+ * 
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ * @param string Null-terminated byte string of valid ASCII characters
+ * @return On success, returns the pointer to the new string instance. On failure, returns @c NULL
+ */
+str_t* str_new_alloc(const ustring_allocator_t* allocator, const char* string);
+
 /**
  * @brief Creates an empty string with the buffer of the given capacity
  * 
@@ -56,21 +87,71 @@ str_t* str_new(const char* string);
  */
 str_t* str_with_capacity(size_t capacity);
 
+/**
+ * @brief Creates an empty string with the buffer of the given capacity in the arena
+ * 
+ * @param arena Pointer to the initialized arena instance. If @c NULL , the global allocator is used
+ * @param capacity Capacity of the buffer
+ * @return On success, returns the pointer to the new string instance. On failure, returns @c NULL
+ */
+str_t* str_with_capacity_in(ustring_arena_t* arena, size_t capacity);
+
+/**
+ * @brief Creates an empty string with the buffer of the given capacity with the allocator
+ * 
+ * Same as @c str_with_capacity , but the memory is allocated with the given allocator,
+ * which is then used by the instance for all subsequent operations.
+ * 
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ * @param capacity Capacity of the buffer
+ * @return On success, returns the pointer to the new string instance. On failure, returns @c NULL
+ */
+str_t* str_with_capacity_alloc(const ustring_allocator_t* allocator, size_t capacity);
+
 /**
  * @brief Creates copy of the string
  * 
+ * Copy of a shared string (see @c str_make_shared ) takes O(1) time:
+ * it shares the characters with @c other instead of copying them.
+ * 
  * @param other Pointer to the initialized string instance to be copied
  * @return On success, returns the pointer to the new instance of the string copy. On failure, returns @c NULL
  * @note If @c other is @c NULL , an empty string is created
  */
 str_t* str_copy(const str_t* other);
 
+/**
+ * @brief Creates copy of the string in the arena
+ * 
+ * @param arena Pointer to the initialized arena instance. If @c NULL , the global allocator is used
+ * @param other Pointer to the initialized string instance to be copied
+ * @return On success, returns the pointer to the new instance of the string copy. On failure, returns @c NULL
+ */
+str_t* str_copy_in(ustring_arena_t* arena, const str_t* other);
+
+/**
+ * @brief Creates copy of the string with the allocator
+ * 
+ * Same as @c str_copy , but the memory is allocated with the given allocator,
+ * which is then used by the instance for all subsequent operations.
+ * Characters of a shared string are shared only if @c allocator is the
+ * allocator of @c other , otherwise they are copied.
+ * 
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ * @param other Pointer to the initialized string instance to be copied
+ * @return On success, returns the pointer to the new instance of the string copy. On failure, returns @c NULL
+ */
+str_t* str_copy_alloc(const ustring_allocator_t* allocator, const str_t* other);
+
 /**
  * @brief Drops the string instance
  * 
  * Frees the allocated memory and sets string
  * instance pointer to @c NULL  
  * 
+ * Memory of the string created in an arena is
+ * released when the arena is reset or dropped.
+ * 
  * @param self Pointer to the pointer to the initialized string instance
  * @note If @c self or @c *self is @c NULL, function does nothing
  * @warning After string is dropped it must not be used,
@@ -78,6 +159,36 @@ str_t* str_copy(const str_t* other);
  */
 void str_drop(str_t** self);
 
+/**
+ * @brief Moves characters of the string to a shared buffer
+ * 
+ * Shared buffer is reference counted: copies of the string created
+ * with @c str_copy take O(1) time and share the buffer with the string
+ * instead of copying its characters. Shared characters are never modified.
+ * The first modification of the string or any of its copies (append, trim,
+ * replace, case change, etc.) gives the modified string its own characters,
+ * unless it is the only owner of the buffer left.
+ * 
+ * Shared string and its copies may be read and dropped from different threads
+ * at the same time without synchronization, since only the reference counter
+ * is modified and it is atomic. A single instance must not be modified
+ * while it is used by another thread.
+ * 
+ * Function takes O(n) time once, if the string is already shared it does nothing.
+ * 
+ * @param self Pointer to the initialized string instance
+ * @return On success, returns 0. On failure returns non-zero error code
+ */
+int str_make_shared(str_t* self);
+
+/**
+ * @brief Checks if characters of the string are in a shared buffer
+ * 
+ * @param self Pointer to the initialized string instance
+ * @return @c true if string characters are shared; @c false otherwise or if @c self is @c NULL
+ */
+bool str_is_shared(const str_t* self);
+
 /**
  * @brief Returns the length of the string
  * 
@@ -132,9 +243,8 @@ const char* str_as_ptr(const str_t* self);
  * the provided C-style string to it. Second string stays unchanged.
  * Function does nothing to @c self if @c string is @c NULL  or empty.
  * 
- * @note Appending string instance to itself, passing its
- * buffer as pointer is inefficient (string buffer is temporary duplicated).
- * For this purpose use str_concat method instead.
+ * @note String instance may be appended to itself by passing
+ * its buffer (or a pointer into it) as @c string .
  * 
  * @param self Pointer to the initialized string instance
  * @param string NULL-terminated byte string of valid ASCII characters
@@ -162,6 +272,28 @@ int str_clear(str_t* self);
  */
 str_t* str_concat(const str_t* str_a, const str_t* str_b);
 
+/**
+ * @brief Creates new string in the arena which is a result of concatenation of two given strings.
+ * 
+ * @param arena Pointer to the initialized arena instance. If @c NULL , the global allocator is used
+ * @param str_a,str_b Pointers to the initialized string instances
+ * @return On success, returns the pointer to the new string instance - a result
+ *      of concatenation of the given strings. On failure, returns @c NULL
+ */
+str_t* str_concat_in(ustring_arena_t* arena, const str_t* str_a, const str_t* str_b);
+
+/**
+ * @brief Creates new string by concatenating two strings with the allocator
+ * 
+ * Same as @c str_concat , but the memory is allocated with the given allocator,
+ * which is then used by the instance for all subsequent operations.
+ * 
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ * @param str_a,str_b Pointers to the initialized string instances
+ * @return On success, returns the pointer to the new string instance. On failure, returns @c NULL
+ */
+str_t* str_concat_alloc(const ustring_allocator_t* allocator, const str_t* str_a, const str_t* str_b);
+
 /**
  * @brief Trims leading and trailing whitespace characters in the string.
  * 
@@ -176,12 +308,43 @@ int str_trim(str_t* self);
 /**
  * @brief Checks two strings for equality
  * 
+ * Strings of different lengths are rejected first. If hashes of both
+ * strings are cached (see @c str_hash ), strings with different hashes
+ * are rejected without comparing characters. Otherwise characters are
+ * compared 16 or 32 at a time.
+ * 
  * @param a,b Pointers to the initialized string instances
  * @returns @c true if strings are equal; @c false otherwise.
  *      If one of strings is @c NULL, @c false is returned
  */
 bool str_eq(const str_t* a, const str_t* b);
 
+/**
+ * @brief Compares two strings lexicographically
+ * 
+ * Characters are compared as unsigned bytes. If one string is a prefix
+ * of the other, the shorter one is less. @c NULL is less than
+ * any string and equal to @c NULL .
+ * 
+ * @param a,b Pointers to the initialized string instances
+ * @returns -1 if @c a is less than @c b , 0 if they are equal,
+ *      1 if @c a is greater than @c b
+ */
+int str_cmp(const str_t* a, const str_t* b);
+
+/**
+ * @brief Compares at most @c len leading characters of two strings lexicographically
+ * 
+ * Same as @c str_cmp applied to the prefixes of both strings
+ * no longer than @c len characters, similar to @c strncmp .
+ * 
+ * @param a,b Pointers to the initialized string instances
+ * @param len Maximum number of characters to compare
+ * @returns -1 if the prefix of @c a is less than the prefix of @c b ,
+ *      0 if they are equal, 1 if it is greater
+ */
+int str_cmp_prefix(const str_t* a, const str_t* b, size_t len);
+
 /**
  * @brief Truncates the string to the given length.
  * 
@@ -210,6 +373,42 @@ int str_truncate(str_t* self, size_t len);
  */
 bool str_contains(const str_t* self, const char* pattern);
 
+/**
+ * @brief Finds the first occurrence of the pattern in the string
+ * 
+ * @note Empty pattern is found at index 0 of any string
+ * 
+ * @param self Pointer to the initialized string instance
+ * @param pattern Search pattern - NULL-terminated byte string of valid ASCII characters
+ * @return Index of the first character of the first pattern occurrence;
+ *      @c STR_NPOS if the pattern is not found or if either @c self or @c pattern is @c NULL
+ */
+size_t str_find(const str_t* self, const char* pattern);
+
+/**
+ * @brief Finds the first occurrence of the pattern in the string starting from the given index
+ * 
+ * Allows walking through all pattern occurrences without rescanning the string:
+ * 
+ * @code
+ *      size_t idx = str_find(string, "ab");
+ *      while (idx != STR_NPOS) {
+ *          // ...
+ *          idx = str_find_from(string, "ab", idx + 2);
+ *      }
+ * @endcode
+ * 
+ * @note Empty pattern is found at index @c from if @c from does not exceed string length
+ * 
+ * @param self Pointer to the initialized string instance
+ * @param pattern Search pattern - NULL-terminated byte string of valid ASCII characters
+ * @param from Index of the character the search starts from
+ * @return Index of the first character of the first pattern occurrence at or after @c from ;
+ *      @c STR_NPOS if the pattern is not found, if @c from exceeds string length
+ *      or if either @c self or @c pattern is @c NULL
+ */
+size_t str_find_from(const str_t* self, const char* pattern, size_t from);
+
 /**
  * @brief Checks if the string contains at least one character of class
  *      determined by the predicate function.
@@ -308,6 +507,10 @@ int str_trim_end_matches_fn(str_t* self, bool (*fn) (char));
  * pattern occurrence is detected it is replaced with the provided substring.
  * Function uses greedy strategy and do not support recursive replacement.
  * 
+ * If the result fits the string buffer, occurrences are replaced in place.
+ * Otherwise they are counted first and the result is written to a single
+ * new buffer of the exact size.
+ * 
  * If either @c self or @c pattern is @c NULL function does nothing and returns error code.
  * 
  * @note If @c replacement is @c NULL, it is treated as an empty string
@@ -319,11 +522,29 @@ int str_trim_end_matches_fn(str_t* self, bool (*fn) (char));
  */
 int str_replace(str_t* self, const char* pattern, const char* replacement);
 
+/**
+ * @brief Replaces first @c count occurrences of the pattern with the provided replacement substring
+ * 
+ * Same as @c str_replace , but the scan stops after @c count replacements.
+ * 
+ * If either @c self or @c pattern is @c NULL function does nothing and returns error code.
+ * 
+ * @note If @c replacement is @c NULL, it is treated as an empty string
+ * 
+ * @param self Pointer to the initialized string instance
+ * @param pattern Pattern to be replaced - NULL-terminated byte string of valid ASCII characters
+ * @param replacement Substring to be inserted in the string replacing pattern
+ * @param count Maximum number of occurrences to be replaced
+ * @return On success, returns 0. On failure returns non-zero error code
+ */
+int str_replacen(str_t* self, const char* pattern, const char* replacement, size_t count);
+
 /**
  * @brief Shrinks string buffer to fit its content
  * 
  * Reallocates or truncates the buffer of the string so it occupies
  * only necessary amount of memory to hold string content.
+ * Shared buffers are left untouched.
  * If @c self is @c NULL function does nothing and returns error code.
  * 
  * @param self Pointer to the initialized string instance
@@ -379,6 +600,79 @@ int str_to_lowercase(str_t* self);
  */
 int str_to_uppercase(str_t* self);
 
+/**
+ * @brief Checks two strings for equality ignoring ASCII case
+ * 
+ * Letters are folded on the fly, strings are not modified or copied.
+ * 
+ * @param a,b Pointers to the initialized string instances
+ * @returns @c true if strings are equal ignoring case; @c false otherwise.
+ *      If one of strings is @c NULL, @c false is returned
+ */
+bool str_eq_ignore_case(const str_t* a, const str_t* b);
+
+/**
+ * @brief Compares two strings lexicographically ignoring ASCII case
+ * 
+ * Characters are compared as unsigned bytes after folding letters to
+ * the lower case. If one string is a prefix of the other, the shorter one
+ * is less. @c NULL is less than any string and equal to @c NULL .
+ * 
+ * @param a,b Pointers to the initialized string instances
+ * @returns Negative value if @c a is less than @c b , zero if they are equal
+ *      ignoring case, positive value if @c a is greater than @c b
+ */
+int str_cmp_ignore_case(const str_t* a, const str_t* b);
+
+/**
+ * @brief Checks if the string contains a string pattern ignoring ASCII case
+ * 
+ * Same as @c str_contains , but letters are matched regardless of their case.
+ * Neither the string nor the pattern is copied.
+ * 
+ * @param self Pointer to the initialized string instance
+ * @param pattern Search pattern - NULL-terminated byte string of valid ASCII characters
+ * @return @c true if the string contains @c pattern ignoring case;
+ *      @c false otherwise or if either @c self or @c pattern is @c NULL
+ */
+bool str_contains_ignore_case(const str_t* self, const char* pattern);
+
+/**
+ * @brief Checks if string starts with pattern ignoring ASCII case
+ * 
+ * @param self Pointer to the initialized string instance
+ * @param pattern Pattern to match string prefix - NULL-terminated byte string of valid ASCII characters
+ * @return @c true if string starts with the @c pattern ignoring case;
+ *      @c false otherwise or if either self or pattern are @c NULL
+ */
+bool str_starts_with_ignore_case(const str_t* self, const char* pattern);
+
+/**
+ * @brief Returns 64-bit hash of the string characters
+ * 
+ * Hash is computed with @c STR_HASH_DEFAULT_SEED on the first call
+ * and cached in the string until the string is modified.
+ * Equal strings have equal hashes, which are also equal to
+ * @c str_view_hash of their views with the same seed.
+ * 
+ * @param self Pointer to the initialized string instance
+ * @return Hash of the string characters. If @c self is @c NULL , hash of the empty string is returned
+ * @note Hash values are not guaranteed to be the same across
+ *      library versions and platforms and must not be persisted
+ */
+uint64_t str_hash(const str_t* self);
+
+/**
+ * @brief Returns 64-bit hash of the string characters with the given seed
+ * 
+ * Hash computed with a seed other than @c STR_HASH_DEFAULT_SEED is not cached.
+ * 
+ * @param self Pointer to the initialized string instance
+ * @param seed Hash seed
+ * @return Hash of the string characters. If @c self is @c NULL , hash of the empty string is returned
+ */
+uint64_t str_hash_seeded(const str_t* self, uint64_t seed);
+
 /**
  * @}
  */ /* String */
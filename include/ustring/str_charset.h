@@ -0,0 +1,170 @@
+/**************************************************************************//**
+ *
+ * @file    str_charset.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   Character Set library API
+ *
+ * The library provides character set - class of characters compiled
+ * into lookup tables, which replaces the per-character predicate
+ * callbacks of the string search and trim functions.
+ *
+ *****************************************************************************/
+
+#ifndef __USTRING_STR_CHARSET_H__
+#define __USTRING_STR_CHARSET_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "str.h"
+#include "str_view.h"
+
+/**
+ * @addtogroup API
+ * @{
+ *
+ * @addtogroup StringCharset
+ *
+ * Character Set library API.
+ *
+ * Functions taking the @c bool (*fn)(char) predicate make an indirect call
+ * for every character. Character set answers the membership query with
+ * a single lookup in its 256-bit table, and most sets are also compiled
+ * into nibble lookup tables, which classify 16 or 32 characters at once
+ * with vector shuffle instructions. @c _set variants of the search and trim
+ * functions give the same results as the @c _fn variants with
+ * the equivalent predicate.
+ *
+ * Character set is a plain value: it is not allocated, may be copied
+ * and used by several threads at the same time.
+ *
+ * @code
+ *      const str_charset_t digits = str_charset_digit();
+ *      str_t* phone = str_new("+1 (555) 010-9999");
+ *      if (str_contains_set(phone, &digits)) {
+ *          const str_charset_t punct = str_charset_new("+()- ");
+ *          str_trim_matches_set(phone, &punct); // "15550109999"
+ *      }
+ * @endcode
+ *
+ * @{
+ */
+
+typedef struct __str_class str_charset_t; /**< Character set type */
+
+/**
+ * @brief Creates the set of the given characters
+ *
+ * @param chars NULL-terminated byte string of the set members.
+ *      If @c NULL , the set is empty
+ * @return Character set
+ */
+str_charset_t str_charset_new(const char* chars);
+
+/**
+ * @brief Creates the set of the characters in the range
+ *
+ * Characters are compared as unsigned values.
+ *
+ * @param first First character of the range
+ * @param last Last character of the range, included in the set
+ * @return Character set. If @c first is greater than @c last , the set is empty
+ */
+str_charset_t str_charset_range(char first, char last);
+
+/**
+ * @brief Creates the set of the decimal digits '0' - '9'
+ */
+str_charset_t str_charset_digit(void);
+
+/**
+ * @brief Creates the set of the ASCII letters 'A' - 'Z' and 'a' - 'z'
+ */
+str_charset_t str_charset_alpha(void);
+
+/**
+ * @brief Creates the set of the blank characters: @b space (' ') and @b h-tab (\\t)
+ */
+str_charset_t str_charset_blank(void);
+
+/**
+ * @brief Creates the set of the whitespace characters
+ *
+ * Set contains @b space (' '), @b h-tab (\\t), @b newline (\\n),
+ * @b v-tab (\\v), @b form feed (\\f) and @b carriage return (\\r).
+ */
+str_charset_t str_charset_space(void);
+
+/**
+ * @brief Creates the set of the characters of either set
+ *
+ * @param a,b Pointers to the character sets. @c NULL is treated as an empty set
+ * @return Character set
+ */
+str_charset_t str_charset_union(const str_charset_t* a, const str_charset_t* b);
+
+/**
+ * @brief Checks if character is a member of the set
+ *
+ * @param self Pointer to the character set
+ * @param ch Character
+ * @return @c true if @c ch is a member; @c false otherwise or if @c self is @c NULL
+ */
+bool str_charset_contains(const str_charset_t* self, char ch);
+
+/**
+ * @brief Checks if string contains any character of the set
+ *
+ * Same as @c str_contains_fn .
+ *
+ * @param self Pointer to the initialized string instance
+ * @param set Pointer to the character set
+ * @return @c true if any member is found; @c false otherwise or if either argument is @c NULL
+ */
+bool str_contains_set(const str_t* self, const str_charset_t* set);
+
+/**
+ * @brief Removes all characters of the set from the string
+ *
+ * Same as @c str_trim_matches_fn . Characters before the first member are skipped
+ * with the vector scan, the rest is filtered with table lookups.
+ *
+ * @param self Pointer to the initialized string instance
+ * @param set Pointer to the character set
+ * @return On success, returns 0. On failure returns non-zero error code
+ */
+int str_trim_matches_set(str_t* self, const str_charset_t* set);
+
+/**
+ * @brief Removes leading characters of the set from the string
+ *
+ * Same as @c str_trim_start_matches_fn .
+ *
+ * @param self Pointer to the initialized string instance
+ * @param set Pointer to the character set
+ * @return On success, returns 0. On failure returns non-zero error code
+ */
+int str_trim_start_matches_set(str_t* self, const str_charset_t* set);
+
+/**
+ * @brief Removes trailing characters of the set from the string
+ *
+ * Same as @c str_trim_end_matches_fn .
+ *
+ * @param self Pointer to the initialized string instance
+ * @param set Pointer to the character set
+ * @return On success, returns 0. On failure returns non-zero error code
+ */
+int str_trim_end_matches_set(str_t* self, const str_charset_t* set);
+
+/**
+ * @}
+ */ /* StringCharset */
+
+/**
+ * @}
+ */ /* API */
+
+#endif /* __USTRING_STR_CHARSET_H__ */
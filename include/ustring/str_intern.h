@@ -0,0 +1,147 @@
+/**************************************************************************//**
+ *
+ * @file    str_intern.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   String Interning library API
+ *
+ * The library provides string interning table which stores a single
+ * canonical immutable copy of every distinct string put into it.
+ *
+ *****************************************************************************/
+
+#ifndef __USTRING_STR_INTERN_H__
+#define __USTRING_STR_INTERN_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "alloc.h"
+#include "str.h"
+#include "str_view.h"
+
+/**
+ * @addtogroup API
+ * @{
+ *
+ * @addtogroup StringIntern
+ *
+ * String Interning library API.
+ *
+ * Interning table returns the same handle for all equal strings,
+ * so interned strings are compared by pointer and their hash is computed
+ * only once, when the string is interned first. Handles are owned by the table
+ * and stay valid until it is dropped.
+ *
+ * @code
+ *      str_intern_t* tags = str_intern_new();
+ *      const str_t* a = str_intern_cstr(tags, "service=api");
+ *      const str_t* b = str_intern_view(tags, str_view_new("service=api"));
+ *      if (a == b) {
+ *          // same tag
+ *      }
+ *      str_intern_drop(&tags);
+ * @endcode
+ *
+ * Table created by @c str_intern_new_concurrent may be used by
+ * several threads at once. Its strings are distributed between
+ * @c STR_INTERN_SHARD_COUNT independently locked shards by their hash,
+ * so threads interning different strings rarely wait for each other.
+ *
+ * @{
+ */
+
+#define STR_INTERN_SHARD_COUNT ((size_t) 16) /**< Number of shards of the concurrent table */
+
+typedef struct __str_intern str_intern_t; /**< String interning table type */
+
+/**
+ * @brief Creates new empty string interning table
+ *
+ * Table must be used by one thread at a time.
+ *
+ * @return On success, returns the pointer to the new table instance.
+ *      On failure, returns @c NULL
+ */
+str_intern_t* str_intern_new(void);
+
+/**
+ * @brief Creates new empty string interning table safe to be used by several threads at once
+ *
+ * @return On success, returns the pointer to the new table instance.
+ *      On failure, returns @c NULL
+ */
+str_intern_t* str_intern_new_concurrent(void);
+
+/**
+ * @brief Creates new empty string interning table with the allocator used for the table and its strings
+ *
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used.
+ *      Allocator of the concurrent table must be safe to be called from several threads
+ * @param concurrent If @c true , the table is safe to be used by several threads at once
+ * @return On success, returns the pointer to the new table instance.
+ *      On failure, returns @c NULL
+ */
+str_intern_t* str_intern_new_alloc(const ustring_allocator_t* allocator, bool concurrent);
+
+/**
+ * @brief Drops the string interning table instance
+ *
+ * Frees the table and all interned strings and sets table
+ * instance pointer to @c NULL . All handles returned by the table are invalidated.
+ *
+ * @param self Pointer to the pointer to the initialized table instance
+ * @note If @c self or @c *self is @c NULL, function does nothing
+ */
+void str_intern_drop(str_intern_t** self);
+
+/**
+ * @brief Returns the number of distinct strings in the table
+ *
+ * @return Number of strings. If @c self is @c NULL , 0 is returned
+ */
+size_t str_intern_size(const str_intern_t* self);
+
+/**
+ * @brief Returns the canonical handle of the string, interning its copy if needed
+ *
+ * Handles of equal strings are equal pointers. Hash of the handle is cached,
+ * so @c str_hash of the handle takes constant time.
+ *
+ * @param self Pointer to the initialized table instance
+ * @param string Pointer to the initialized string instance
+ * @return Handle owned by the table. @c NULL on failure or if either @c self or @c string is @c NULL
+ * @warning Handle must not be modified or dropped
+ */
+const str_t* str_intern(str_intern_t* self, const str_t* string);
+
+/**
+ * @brief Same as @c str_intern with the string given as a C string
+ */
+const str_t* str_intern_cstr(str_intern_t* self, const char* string);
+
+/**
+ * @brief Same as @c str_intern with the string given as a string view
+ */
+const str_t* str_intern_view(str_intern_t* self, str_view_t string);
+
+/**
+ * @brief Returns the canonical handle of the string if it is interned
+ *
+ * @param self Pointer to the initialized table instance
+ * @param string View of the string characters
+ * @return Handle owned by the table; @c NULL if the string is not interned
+ *      or if @c self is @c NULL
+ */
+const str_t* str_intern_lookup(const str_intern_t* self, str_view_t string);
+
+/**
+ * @}
+ */ /* StringIntern */
+
+/**
+ * @}
+ */ /* API */
+
+#endif /* __USTRING_STR_INTERN_H__ */
@@ -46,6 +46,26 @@ typedef struct __str_list str_list_t; /**< String list type */
  */
 str_list_t* str_list_new();
 
+/**
+ * @brief Creates new instance of an empty string list in the arena
+ * 
+ * @param arena Pointer to the initialized arena instance. If @c NULL , the global allocator is used
+ * @return On success, returns the pointer to the new string list instance.
+ *      On failure, returns @c NULL
+ */
+str_list_t* str_list_new_in(ustring_arena_t* arena);
+
+/**
+ * @brief Creates new empty string list with the allocator
+ * 
+ * Same as @c str_list_new , but the memory is allocated with the given allocator,
+ * which is then used by the instance for all subsequent operations.
+ * 
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ * @return On success, returns the pointer to the new string list instance. On failure, returns @c NULL
+ */
+str_list_t* str_list_new_alloc(const ustring_allocator_t* allocator);
+
 /**
  * @brief Created an empty string list with the given capacity
  * 
@@ -55,11 +75,33 @@ str_list_t* str_list_new();
  */
 str_list_t* str_list_with_capacity(size_t capacity);
 
+/**
+ * @brief Created an empty string list with the given capacity in the arena
+ * 
+ * @param arena Pointer to the initialized arena instance. If @c NULL , the global allocator is used
+ * @param capacity Capacity of the buffer
+ * @return On success, returns the pointer to the new string list instance. On failure, returns @c NULL
+ */
+str_list_t* str_list_with_capacity_in(ustring_arena_t* arena, size_t capacity);
+
+/**
+ * @brief Creates an empty string list of the given capacity with the allocator
+ * 
+ * Same as @c str_list_with_capacity , but the memory is allocated with the given allocator,
+ * which is then used by the instance for all subsequent operations.
+ * 
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ * @param capacity Capacity of the list buffer
+ * @return On success, returns the pointer to the new string list instance. On failure, returns @c NULL
+ */
+str_list_t* str_list_with_capacity_alloc(const ustring_allocator_t* allocator, size_t capacity);
+
 /**
  * @brief Creates the new copy of the string list
  * 
  * Function creates a copy of the given string list by 
- * creating deep copies of each string in the list buffer.
+ * creating copies of each string in the list buffer.
+ * Shared strings (see @c str_list_make_shared ) are copied in O(1) time.
  * 
  * @param other Pointer to the initialized string list instance to be copied
  * @return On success, returns the pointer to the new string list instance. On failure, returns @c NULL
@@ -67,9 +109,24 @@ str_list_t* str_list_with_capacity(size_t capacity);
  */
 str_list_t* str_list_copy(const str_list_t* other);
 
+/**
+ * @brief Moves characters of each string in the list to shared buffers
+ * 
+ * After the call @c str_list_copy creates a copy of the list without copying
+ * any characters, so the copy may be handed to another thread as a read-only
+ * snapshot. See @c str_make_shared for details.
+ * 
+ * @param self Pointer to the initialized string list instance
+ * @return On success, returns 0. On failure returns non-zero error code
+ */
+int str_list_make_shared(str_list_t* self);
+
 /**
  * @brief Deallocates string list instance and all its contents
  * 
+ * Memory of the string list and strings created in an arena is
+ * released when the arena is reset or dropped.
+ * 
  * @param self Pointer to the pointer to the initialized string list instance
  * @warning After string list is dropped it must not be used,
  *      the string list pointer passed to the funcion will be set to @c NULL
@@ -83,6 +140,7 @@ void str_list_drop(str_list_t** self);
  * @param string Pointer to the initialized string instance to be added
  * @return On success returns zero. On failure returns non-zero value
  * @warning String list takes ownership of the string, string must not be dropped externally
+ * @note String list created in an arena grows in the arena
  */
 int str_list_push(str_list_t* self, str_t* string);
 
@@ -158,6 +216,56 @@ str_t* str_list_at(const str_list_t* self, const size_t idx);
  */
 str_list_t* str_split(const str_t* string, const char* delim);
 
+/**
+ * @brief Splits the string around the given delimeter into the string list in the arena
+ * 
+ * Same as @c str_split , but the resulting string list and
+ * all string chunks are allocated in the arena.
+ * 
+ * @param arena Pointer to the initialized arena instance. If @c NULL , the global allocator is used
+ * @param string Pointer to the initialized string instance
+ * @param delim Delimeter - NULL-terminated byte string of valid ASCII characters
+ * @return Pointer to the new string list that contains all resulting string chunks.
+ *      Empty string list if @c self is @c NULL or empty.
+ *      On failure returns @c NULL
+ */
+str_list_t* str_split_in(ustring_arena_t* arena, const str_t* string, const char* delim);
+
+/**
+ * @brief Same as @c str_split with the allocator used for the list and its strings
+ * 
+ * Allocator is used by the created instances for all subsequent operations.
+ * 
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ */
+str_list_t* str_split_alloc(const ustring_allocator_t* allocator, const str_t* string, const char* delim);
+
+/**
+ * @brief Splits the string around the given delimeter on several threads
+ *
+ * String is cut at delimeter characters into chunks of about the same length,
+ * chunks are split by the worker threads and their strings are gathered
+ * into the list in the original order. The result is the same as the one of @c str_split .
+ * Each thread gets at least 64 KiB of characters.
+ *
+ * @param string Pointer to the initialized string instance
+ * @param delim Delimeter - NULL-terminated byte string of valid ASCII characters
+ * @param threads Number of threads. If 0, the number of online processors is used
+ * @return Pointer to the new string list that contains all resulting string chunks.
+ *      Empty string list if @c string is @c NULL or empty.
+ *      On failure returns @c NULL
+ */
+str_list_t* str_par_split(const str_t* string, const char* delim, size_t threads);
+
+/**
+ * @brief Same as @c str_par_split with the allocator used for the list and its strings
+ *
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ * @warning Allocator is called from several threads
+ */
+str_list_t* str_par_split_alloc(const ustring_allocator_t* allocator, const str_t* string,
+                                const char* delim, size_t threads);
+
 /**
  * @brief Joins all provided strings and puts delimeter sequence between them
  * 
@@ -173,6 +281,54 @@ str_list_t* str_split(const str_t* string, const char* delim);
  */
 str_t* str_list_join(const str_list_t* self, const char* delim);
 
+/**
+ * @brief Joins all provided strings into the new string in the arena
+ * 
+ * Same as @c str_list_join , but the resulting string is allocated in the arena.
+ * 
+ * @param arena Pointer to the initialized arena instance. If @c NULL , the global allocator is used
+ * @param self Pointer to the initialized string list instance
+ * @param delim Delimeter - NULL-terminated byte string of valid ASCII characters
+ * @return Pointer to the new instance of the string that contains joined strings.
+ *      Empty string if @c self is @c NULL.
+ *      On failure returns @c NULL
+ */
+str_t* str_list_join_in(ustring_arena_t* arena, const str_list_t* self, const char* delim);
+
+/**
+ * @brief Same as @c str_list_join with the allocator used for the joined string
+ * 
+ * Allocator is used by the created instances for all subsequent operations.
+ * 
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ */
+str_t* str_list_join_alloc(const ustring_allocator_t* allocator, const str_list_t* self, const char* delim);
+
+/**
+ * @brief Appends all strings of the list and delimeter sequences between them to the string
+ * 
+ * Same as @c str_list_join , but the joined characters are appended to
+ * the existing string, so its buffer may be reused for many joins:
+ * 
+ * @code
+ *      str_t* line = str_new(NULL);
+ *      for (...) {
+ *          str_clear(line);
+ *          str_list_join_into(line, row, ",");
+ *          // emit line
+ *      }
+ * @endcode
+ * 
+ * @param dst Pointer to the initialized string instance the joined characters are appended to
+ * @param self Pointer to the initialized string list instance
+ * @param delim Delimeter - NULL-terminated byte string of valid ASCII characters
+ * @return On success returns zero. On failure returns non-zero value,
+ *      @c dst is left unchanged
+ * @note If @c self is @c NULL or empty, @c dst is left unchanged
+ * @note @c dst may be one of the strings of the list
+ */
+int str_list_join_into(str_t* dst, const str_list_t* self, const char* delim);
+
 /**
  * @brief Same as @c str_split with whitespace characters as separartor
  * 
@@ -187,6 +343,26 @@ str_t* str_list_join(const str_list_t* self, const char* delim);
  */
 str_list_t* str_split_whitespace(const str_t* string);
 
+/**
+ * @brief Same as @c str_split_in with whitespace characters as separartor
+ * 
+ * @param arena Pointer to the initialized arena instance. If @c NULL , the global allocator is used
+ * @param string Pointer to the initialized string instance
+ * @return Pointer to the new string list that contains all resulting string chunks.
+ *      Empty string list if @c self is @c NULL or empty.
+ *      On failure returns @c NULL
+ */
+str_list_t* str_split_whitespace_in(ustring_arena_t* arena, const str_t* string);
+
+/**
+ * @brief Same as @c str_split_whitespace with the allocator used for the list and its strings
+ * 
+ * Allocator is used by the created instances for all subsequent operations.
+ * 
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ */
+str_list_t* str_split_whitespace_alloc(const ustring_allocator_t* allocator, const str_t* string);
+
 /**
  * @brief Checks is string list contains specified string
  * 
@@ -200,6 +376,64 @@ str_list_t* str_split_whitespace(const str_t* string);
  */
 bool str_list_contains(const str_list_t* self, const str_t* string);
 
+/**
+ * @brief Sorts the string list in ascending order
+ *
+ * Strings are compared character by character as unsigned bytes,
+ * a string goes before all longer strings it is a prefix of.
+ * Sort is a multikey quicksort: strings are partitioned by
+ * 8 characters at once and common prefixes are compared only once.
+ * Order of equal strings is unspecified.
+ *
+ * @param self Pointer to the initialized string list instance
+ * @return On success returns zero. On failure returns non-zero value,
+ *      the list is left unchanged
+ */
+int str_list_sort(str_list_t* self);
+
+/**
+ * @brief Same as @c str_list_sort but keeps the order of equal strings
+ *
+ * Sort is an MSD radix sort, which uses additional memory
+ * for the copy of the list.
+ *
+ * @param self Pointer to the initialized string list instance
+ * @return On success returns zero. On failure returns non-zero value,
+ *      the list is left unchanged
+ */
+int str_list_sort_stable(str_list_t* self);
+
+/**
+ * @brief Sorts the string list on several threads
+ *
+ * List is partitioned into buckets by the strings sampled from it,
+ * buckets are sorted by the worker threads. The result is the same as
+ * the one of @c str_list_sort_stable regardless of the number of threads.
+ * Short lists are sorted by the calling thread.
+ *
+ * @param self Pointer to the initialized string list instance
+ * @param threads Number of threads. If 0, the number of online processors is used
+ * @return On success returns zero. On failure returns non-zero value,
+ *      the list is left unchanged
+ * @warning Allocator of the list is called from several threads
+ */
+int str_list_par_sort(str_list_t* self, size_t threads);
+
+/**
+ * @brief Sorts the string list on several threads and removes repeated strings
+ *
+ * Same as @c str_list_par_sort , then of each group of equal strings
+ * only the first one in the original list order is kept, the rest are dropped.
+ *
+ * @param self Pointer to the initialized string list instance
+ * @param threads Number of threads. If 0, the number of online processors is used
+ * @return On success returns zero. On failure returns non-zero value,
+ *      the list is left unchanged
+ * @warning Allocator of the list is called from several threads.
+ *      Repeated strings are dropped by the calling thread
+ */
+int str_list_par_dedup(str_list_t* self, size_t threads);
+
 /**
  * @}
  */ /* StringList */
@@ -0,0 +1,197 @@
+/**************************************************************************//**
+ *
+ * @file    str_list_flat.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   Flat String List library API
+ *
+ * Flat string list keeps characters of all its strings in a single
+ * contiguous buffer, items are described by their offset and length
+ * in the buffer.
+ *
+ *****************************************************************************/
+
+#ifndef __USTRING_STR_LIST_FLAT_H__
+#define __USTRING_STR_LIST_FLAT_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "str.h"
+#include "str_view.h"
+
+/**
+ * @addtogroup API
+ * @{
+ *
+ * @addtogroup FlatStringList
+ *
+ * Flat String List library API.
+ *
+ * Unlike @c str_list_t , flat string list does not allocate separate
+ * string instances for its items. Characters of all items are stored
+ * one after another in a single growable buffer, so iterating over
+ * the list reads memory sequentially, and adding items only allocates
+ * when the buffer grows. Items are accessed as string views.
+ *
+ * @code
+ *      str_list_flat_t* list = str_list_flat_new();
+ *      str_split_into(list, str_view_new("One, Two; Three"), " ,;");
+ *      for (size_t i = 0; i < str_list_flat_size(list); i++) {
+ *          str_view_t item = str_list_flat_at(list, i);
+ *          // ...
+ *      }
+ *      str_t* joined = str_list_flat_join(list, "-"); // "One-Two-Three"
+ * @endcode
+ *
+ * @{
+ */
+
+typedef struct __str_list_flat str_list_flat_t; /**< Flat string list type */
+
+/**
+ * @brief Creates new instance of an empty flat string list
+ *
+ * @return On success, returns the pointer to the new flat string list instance.
+ *      On failure, returns @c NULL
+ */
+str_list_flat_t* str_list_flat_new(void);
+
+/**
+ * @brief Creates an empty flat string list with the buffers of the given capacity
+ *
+ * @param capacity Number of items the list can hold without reallocation
+ * @param bytes Number of characters the list can hold without reallocation
+ * @return On success, returns the pointer to the new flat string list instance.
+ *      On failure, returns @c NULL
+ */
+str_list_flat_t* str_list_flat_with_capacity(size_t capacity, size_t bytes);
+
+/**
+ * @brief Creates an empty flat string list with the buffers of the given capacity with the allocator
+ *
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ * @param capacity Number of items the list can hold without reallocation
+ * @param bytes Number of characters the list can hold without reallocation
+ * @return On success, returns the pointer to the new flat string list instance.
+ *      On failure, returns @c NULL
+ */
+str_list_flat_t* str_list_flat_with_capacity_alloc(const ustring_allocator_t* allocator,
+                                                   size_t capacity, size_t bytes);
+
+/**
+ * @brief Drops the flat string list instance
+ *
+ * Frees the allocated memory and sets flat string list
+ * instance pointer to @c NULL
+ *
+ * @param self Pointer to the pointer to the initialized flat string list instance
+ * @note If @c self or @c *self is @c NULL, function does nothing
+ */
+void str_list_flat_drop(str_list_flat_t** self);
+
+/**
+ * @brief Adds copy of the characters to the end of the list
+ *
+ * @param self Pointer to the initialized flat string list instance
+ * @param string View of the characters to be added
+ * @return On success returns zero. On failure returns non-zero value
+ * @warning Views previously returned by @c str_list_flat_at
+ *      are invalidated if the list buffer is reallocated
+ */
+int str_list_flat_push(str_list_flat_t* self, str_view_t string);
+
+/**
+ * @brief Removes all items from the list keeping the buffers in place
+ *
+ * @param self Pointer to the initialized flat string list instance
+ * @return On success returns zero. On failure returns non-zero value
+ */
+int str_list_flat_clear(str_list_flat_t* self);
+
+/**
+ * @brief Returns the number of items in the list
+ *
+ * @return Number of items in the list. If @c self is @c NULL , 0 is returned
+ */
+size_t str_list_flat_size(const str_list_flat_t* self);
+
+/**
+ * @brief Checks if list is empty
+ *
+ * @return @c true if list is empty or if @c self is @c NULL ; @c false otherwise
+ */
+bool str_list_flat_is_empty(const str_list_flat_t* self);
+
+/**
+ * @brief Returns the item of the list at the given index
+ *
+ * @param self Pointer to the initialized flat string list instance
+ * @param idx Index of the item starting from 0
+ * @return View of the item characters. Empty view if index violates the bounds
+ *      or if @c self is @c NULL
+ * @note Item characters are followed by the null terminator,
+ *      so @c ptr of the view may be used as a C string
+ */
+str_view_t str_list_flat_at(const str_list_flat_t* self, size_t idx);
+
+/**
+ * @brief Splits the characters around the given delimeter into the flat string list
+ *
+ * Appends tokens to the end of the list. Tokens are the same as the items
+ * of the string list built by @c str_split : empty tokens are skipped.
+ *
+ * @param self Pointer to the initialized flat string list instance
+ * @param string View of the characters to be split
+ * @param delim Delimeter - NULL-terminated byte string of valid ASCII characters
+ * @return On success returns zero. On failure returns non-zero value,
+ *      the list keeps the tokens appended before the failure
+ */
+int str_split_into(str_list_flat_t* self, str_view_t string, const char* delim);
+
+/**
+ * @brief Splits the characters around the given delimeter into the flat string list on several threads
+ *
+ * Characters are cut at delimeter characters into chunks of about the same length,
+ * chunks are split by the worker threads and their tokens are appended
+ * to the list in the original order. The result is the same as the one of @c str_split_into .
+ * Each thread gets at least 64 KiB of characters.
+ *
+ * @param self Pointer to the initialized flat string list instance
+ * @param string View of the characters to be split
+ * @param delim Delimeter - NULL-terminated byte string of valid ASCII characters
+ * @param threads Number of threads. If 0, the number of online processors is used
+ * @return On success returns zero. On failure returns non-zero value, the list is left unchanged
+ * @warning Allocator of the list is called from several threads
+ */
+int str_par_split_into(str_list_flat_t* self, str_view_t string, const char* delim, size_t threads);
+
+/**
+ * @brief Joins all items of the list and puts delimeter sequence between them
+ *
+ * @param self Pointer to the initialized flat string list instance
+ * @param delim Delimeter - NULL-terminated byte string of valid ASCII characters
+ * @return Pointer to the new instance of the string that contains joined items.
+ *      Empty string if @c self is @c NULL.
+ *      On failure returns @c NULL
+ */
+str_t* str_list_flat_join(const str_list_flat_t* self, const char* delim);
+
+/**
+ * @brief Same as @c str_list_flat_join with the allocator used for the joined string
+ *
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ */
+str_t* str_list_flat_join_alloc(const ustring_allocator_t* allocator,
+                                const str_list_flat_t* self, const char* delim);
+
+/**
+ * @}
+ */ /* FlatStringList */
+
+/**
+ * @}
+ */ /* API */
+
+#endif /* __USTRING_STR_LIST_FLAT_H__ */
@@ -0,0 +1,349 @@
+/**************************************************************************//**
+ *
+ * @file    str_map.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   String Map and String Set library API
+ *
+ * The library provides hash map from strings to user pointers
+ * and hash set of strings with constant average time
+ * insertion, lookup and removal.
+ *
+ *****************************************************************************/
+
+#ifndef __USTRING_STR_MAP_H__
+#define __USTRING_STR_MAP_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "str.h"
+#include "str_list.h"
+#include "str_view.h"
+
+/**
+ * @addtogroup API
+ * @{
+ *
+ * @addtogroup StringMap
+ *
+ * String Map and String Set library API.
+ *
+ * Both containers are open addressing hash tables: every slot has
+ * a metadata byte holding 7 bits of the key hash, a lookup compares
+ * metadata of 16 slots at once and compares keys only on metadata match.
+ *
+ * Containers own copies of their keys. Keys may be given as string
+ * instances, C strings or string views, all three forms of the same
+ * characters refer to the same key.
+ *
+ * @code
+ *      str_set_t* seen = str_set_new();
+ *      str_split_iter_t it = str_split_whitespace_iter(str_view_new("a b a c b"));
+ *      str_view_t word;
+ *      while (str_split_iter_next(&it, &word)) {
+ *          if (!str_set_contains_view(seen, word)) {
+ *              str_set_insert_view(seen, word); // "a", "b", "c"
+ *          }
+ *      }
+ * @endcode
+ *
+ * @{
+ */
+
+typedef struct __str_map str_map_t; /**< String map type */
+typedef struct __str_set str_set_t; /**< String set type */
+
+/**
+ * @brief Creates new instance of an empty string map
+ *
+ * @return On success, returns the pointer to the new string map instance.
+ *      On failure, returns @c NULL
+ */
+str_map_t* str_map_new(void);
+
+/**
+ * @brief Creates an empty string map able to hold the given number of keys without rehashing
+ *
+ * @param capacity Number of keys
+ * @return On success, returns the pointer to the new string map instance.
+ *      On failure, returns @c NULL
+ */
+str_map_t* str_map_with_capacity(size_t capacity);
+
+/**
+ * @brief Same as @c str_map_with_capacity with the allocator used for the map and its keys
+ *
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ * @param capacity Number of keys
+ */
+str_map_t* str_map_with_capacity_alloc(const ustring_allocator_t* allocator, size_t capacity);
+
+/**
+ * @brief Drops the string map instance
+ *
+ * Frees the map and all its keys and sets string map
+ * instance pointer to @c NULL . Values are not touched.
+ *
+ * @param self Pointer to the pointer to the initialized string map instance
+ * @note If @c self or @c *self is @c NULL, function does nothing
+ */
+void str_map_drop(str_map_t** self);
+
+/**
+ * @brief Returns the number of keys in the map
+ *
+ * @return Number of keys. If @c self is @c NULL , 0 is returned
+ */
+size_t str_map_size(const str_map_t* self);
+
+/**
+ * @brief Checks if map is empty
+ *
+ * @return @c true if map is empty or if @c self is @c NULL ; @c false otherwise
+ */
+bool str_map_is_empty(const str_map_t* self);
+
+/**
+ * @brief Removes all keys from the map keeping the table in place
+ *
+ * @param self Pointer to the initialized string map instance
+ * @return On success returns zero. On failure returns non-zero value
+ */
+int str_map_clear(str_map_t* self);
+
+/**
+ * @brief Inserts the key with the value or replaces the value of the existing key
+ *
+ * @param self Pointer to the initialized string map instance
+ * @param key Pointer to the initialized string instance. Map stores its own copy of the key
+ * @param value Value associated with the key
+ * @return On success returns zero. On failure returns non-zero value
+ */
+int str_map_insert(str_map_t* self, const str_t* key, void* value);
+
+/**
+ * @brief Same as @c str_map_insert with the key given as a C string
+ */
+int str_map_insert_cstr(str_map_t* self, const char* key, void* value);
+
+/**
+ * @brief Same as @c str_map_insert with the key given as a string view
+ */
+int str_map_insert_view(str_map_t* self, str_view_t key, void* value);
+
+/**
+ * @brief Finds the value associated with the key
+ *
+ * @param self Pointer to the initialized string map instance
+ * @param key Pointer to the initialized string instance
+ * @return Pointer to the value associated with the key, which may be used to
+ *      update the value; @c NULL if the key is not found or if either @c self or @c key is @c NULL
+ * @warning Pointer is invalidated by the next insertion into the map
+ */
+void** str_map_find(const str_map_t* self, const str_t* key);
+
+/**
+ * @brief Same as @c str_map_find with the key given as a C string
+ */
+void** str_map_find_cstr(const str_map_t* self, const char* key);
+
+/**
+ * @brief Same as @c str_map_find with the key given as a string view
+ */
+void** str_map_find_view(const str_map_t* self, str_view_t key);
+
+/**
+ * @brief Removes the key from the map
+ *
+ * @param self Pointer to the initialized string map instance
+ * @param key Pointer to the initialized string instance
+ * @return @c true if the key was removed; @c false if it is not found
+ *      or if either @c self or @c key is @c NULL
+ */
+bool str_map_erase(str_map_t* self, const str_t* key);
+
+/**
+ * @brief Same as @c str_map_erase with the key given as a C string
+ */
+bool str_map_erase_cstr(str_map_t* self, const char* key);
+
+/**
+ * @brief Same as @c str_map_erase with the key given as a string view
+ */
+bool str_map_erase_view(str_map_t* self, str_view_t key);
+
+/**
+ * @brief Advances the iteration over the map entries
+ *
+ * Entries are visited in unspecified order:
+ *
+ * @code
+ *      size_t pos = 0;
+ *      const str_t* key;
+ *      void* value;
+ *      while (str_map_next(map, &pos, &key, &value)) {
+ *          // ...
+ *      }
+ * @endcode
+ *
+ * @param self Pointer to the initialized string map instance
+ * @param pos Pointer to the iteration position, must be set to 0 before the first call
+ * @param key Pointer receiving the key owned by the map. May be @c NULL
+ * @param value Pointer receiving the value. May be @c NULL
+ * @return @c true if the entry is yielded; @c false if there are no more entries
+ * @warning Map must not be modified during the iteration
+ */
+bool str_map_next(const str_map_t* self, size_t* pos, const str_t** key, void** value);
+
+/**
+ * @brief Creates new instance of an empty string set
+ *
+ * @return On success, returns the pointer to the new string set instance.
+ *      On failure, returns @c NULL
+ */
+str_set_t* str_set_new(void);
+
+/**
+ * @brief Creates an empty string set able to hold the given number of keys without rehashing
+ *
+ * @param capacity Number of keys
+ * @return On success, returns the pointer to the new string set instance.
+ *      On failure, returns @c NULL
+ */
+str_set_t* str_set_with_capacity(size_t capacity);
+
+/**
+ * @brief Same as @c str_set_with_capacity with the allocator used for the set and its keys
+ *
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ * @param capacity Number of keys
+ */
+str_set_t* str_set_with_capacity_alloc(const ustring_allocator_t* allocator, size_t capacity);
+
+/**
+ * @brief Creates new string set of all distinct strings of the list
+ *
+ * @param list Pointer to the initialized string list instance
+ * @return On success, returns the pointer to the new string set instance.
+ *      Empty set if @c list is @c NULL .
+ *      On failure, returns @c NULL
+ */
+str_set_t* str_set_from_list(const str_list_t* list);
+
+/**
+ * @brief Drops the string set instance
+ *
+ * Frees the set and all its keys and sets string set
+ * instance pointer to @c NULL
+ *
+ * @param self Pointer to the pointer to the initialized string set instance
+ * @note If @c self or @c *self is @c NULL, function does nothing
+ */
+void str_set_drop(str_set_t** self);
+
+/**
+ * @brief Returns the number of keys in the set
+ *
+ * @return Number of keys. If @c self is @c NULL , 0 is returned
+ */
+size_t str_set_size(const str_set_t* self);
+
+/**
+ * @brief Checks if set is empty
+ *
+ * @return @c true if set is empty or if @c self is @c NULL ; @c false otherwise
+ */
+bool str_set_is_empty(const str_set_t* self);
+
+/**
+ * @brief Removes all keys from the set keeping the table in place
+ *
+ * @param self Pointer to the initialized string set instance
+ * @return On success returns zero. On failure returns non-zero value
+ */
+int str_set_clear(str_set_t* self);
+
+/**
+ * @brief Inserts the key into the set
+ *
+ * @param self Pointer to the initialized string set instance
+ * @param key Pointer to the initialized string instance. Set stores its own copy of the key
+ * @return On success, including the case when the key is already in the set, returns zero.
+ *      On failure returns non-zero value
+ */
+int str_set_insert(str_set_t* self, const str_t* key);
+
+/**
+ * @brief Same as @c str_set_insert with the key given as a C string
+ */
+int str_set_insert_cstr(str_set_t* self, const char* key);
+
+/**
+ * @brief Same as @c str_set_insert with the key given as a string view
+ */
+int str_set_insert_view(str_set_t* self, str_view_t key);
+
+/**
+ * @brief Checks if the key is in the set
+ *
+ * @param self Pointer to the initialized string set instance
+ * @param key Pointer to the initialized string instance
+ * @return @c true if the key is in the set; @c false otherwise
+ *      or if either @c self or @c key is @c NULL
+ */
+bool str_set_contains(const str_set_t* self, const str_t* key);
+
+/**
+ * @brief Same as @c str_set_contains with the key given as a C string
+ */
+bool str_set_contains_cstr(const str_set_t* self, const char* key);
+
+/**
+ * @brief Same as @c str_set_contains with the key given as a string view
+ */
+bool str_set_contains_view(const str_set_t* self, str_view_t key);
+
+/**
+ * @brief Removes the key from the set
+ *
+ * @param self Pointer to the initialized string set instance
+ * @param key Pointer to the initialized string instance
+ * @return @c true if the key was removed; @c false if it is not found
+ *      or if either @c self or @c key is @c NULL
+ */
+bool str_set_erase(str_set_t* self, const str_t* key);
+
+/**
+ * @brief Same as @c str_set_erase with the key given as a C string
+ */
+bool str_set_erase_cstr(str_set_t* self, const char* key);
+
+/**
+ * @brief Same as @c str_set_erase with the key given as a string view
+ */
+bool str_set_erase_view(str_set_t* self, str_view_t key);
+
+/**
+ * @brief Advances the iteration over the set keys
+ *
+ * Same as @c str_map_next for the set.
+ *
+ * @param self Pointer to the initialized string set instance
+ * @param pos Pointer to the iteration position, must be set to 0 before the first call
+ * @param key Pointer receiving the key owned by the set
+ * @return @c true if the key is yielded; @c false if there are no more keys
+ * @warning Set must not be modified during the iteration
+ */
+bool str_set_next(const str_set_t* self, size_t* pos, const str_t** key);
+
+/**
+ * @}
+ */ /* StringMap */
+
+/**
+ * @}
+ */ /* API */
+
+#endif /* __USTRING_STR_MAP_H__ */
@@ -0,0 +1,151 @@
+/**************************************************************************//**
+ *
+ * @file    str_matcher.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   Multi-pattern Matcher library API
+ *
+ * The library provides matcher - set of patterns compiled into
+ * an automaton, which finds and replaces all patterns in a single
+ * pass over the string.
+ *
+ *****************************************************************************/
+
+#ifndef __USTRING_STR_MATCHER_H__
+#define __USTRING_STR_MATCHER_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "alloc.h"
+#include "str.h"
+
+/**
+ * @addtogroup API
+ * @{
+ *
+ * @addtogroup StringMatcher
+ *
+ * Multi-pattern Matcher library API.
+ *
+ * Patterns are compiled into the Aho-Corasick automaton: every character
+ * of the string is examined once with a single table lookup, regardless of
+ * the number of patterns. Matches follow the leftmost-longest rule: the match
+ * starting first wins, of the matches starting at the same position the longest
+ * one wins. Matches do not overlap.
+ *
+ * Matcher is immutable after compilation, so it may be used by
+ * several threads at the same time.
+ *
+ * @code
+ *      const char* patterns[] = {"password", "pass", "token"};
+ *      const char* replacements[] = {"********", "****", "*****"};
+ *      str_matcher_t* matcher = str_matcher_new(patterns, 3);
+ *      str_t* line = str_new("user=bob password=123 token=abc");
+ *      str_replace_many(line, matcher, replacements); // "user=bob ********=123 *****=abc"
+ * @endcode
+ *
+ * @{
+ */
+
+typedef struct __str_matcher str_matcher_t; /**< Multi-pattern matcher type */
+
+/**
+ * @brief Compiles the patterns into a new matcher
+ *
+ * Empty and @c NULL patterns never match. If the same pattern is given
+ * several times, the first occurrence is reported.
+ *
+ * @param patterns Array of NULL-terminated byte strings of valid ASCII characters
+ * @param count Number of patterns
+ * @return On success, returns the pointer to the new matcher instance. On failure, returns @c NULL
+ */
+str_matcher_t* str_matcher_new(const char* const* patterns, size_t count);
+
+/**
+ * @brief Compiles the patterns into a new matcher with the allocator
+ *
+ * Same as @c str_matcher_new , but the memory is allocated with the given allocator.
+ *
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ * @param patterns Array of NULL-terminated byte strings of valid ASCII characters
+ * @param count Number of patterns
+ * @return On success, returns the pointer to the new matcher instance. On failure, returns @c NULL
+ */
+str_matcher_t* str_matcher_new_alloc(const ustring_allocator_t* allocator,
+                                     const char* const* patterns, size_t count);
+
+/**
+ * @brief Drops the matcher instance
+ *
+ * @param self Pointer to the pointer to the initialized matcher instance
+ * @note If @c self or @c *self is @c NULL, function does nothing
+ * @warning After matcher is dropped it must not be used,
+ *      the matcher pointer passed to the function will be set to @c NULL
+ */
+void str_matcher_drop(str_matcher_t** self);
+
+/**
+ * @brief Returns the number of patterns of the matcher
+ *
+ * @param self Pointer to the initialized matcher instance
+ * @return Number of patterns. If @c self is @c NULL , 0 is returned
+ */
+size_t str_matcher_size(const str_matcher_t* self);
+
+/**
+ * @brief Checks if string contains any of the matcher patterns
+ *
+ * Scan stops at the first occurrence of any pattern.
+ *
+ * @param self Pointer to the initialized string instance
+ * @param matcher Pointer to the initialized matcher instance
+ * @return @c true if any pattern is found; @c false otherwise or if either argument is @c NULL
+ */
+bool str_contains_any(const str_t* self, const str_matcher_t* matcher);
+
+/**
+ * @brief Finds the leftmost-longest occurrence of the matcher patterns in the string
+ *
+ * @param self Pointer to the initialized string instance
+ * @param matcher Pointer to the initialized matcher instance
+ * @param pattern Pointer receiving the index of the found pattern. May be @c NULL
+ * @return Index of the first character of the occurrence; @c STR_NPOS if not found
+ *      or if either @c self or @c matcher is @c NULL
+ */
+size_t str_find_any(const str_t* self, const str_matcher_t* matcher, size_t* pattern);
+
+/**
+ * @brief Replaces all occurrences of the matcher patterns in a single pass
+ *
+ * Occurrence of the pattern @c i is replaced with @c replacements[i] .
+ * Occurrences are found with the leftmost-longest rule, replacements
+ * are not scanned again.
+ *
+ * If no replacement is longer than its pattern, string is modified in place.
+ * Otherwise occurrences are collected during the scan and the result is
+ * written to a single buffer of the exact size.
+ *
+ * If either @c self , @c matcher or @c replacements is @c NULL function
+ * does nothing and returns error code.
+ *
+ * @note If replacement is @c NULL, it is treated as an empty string
+ *
+ * @param self Pointer to the initialized string instance
+ * @param matcher Pointer to the initialized matcher instance
+ * @param replacements Array of @c str_matcher_size(matcher) NULL-terminated byte strings
+ *      of valid ASCII characters. Replacements must not point into the string buffer
+ * @return On success, returns 0. On failure returns non-zero error code
+ */
+int str_replace_many(str_t* self, const str_matcher_t* matcher, const char* const* replacements);
+
+/**
+ * @}
+ */ /* StringMatcher */
+
+/**
+ * @}
+ */ /* API */
+
+#endif /* __USTRING_STR_MATCHER_H__ */
@@ -0,0 +1,229 @@
+/**************************************************************************//**
+ *
+ * @file    str_pattern.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   Compiled Pattern library API
+ *
+ * The library provides compiled pattern - substring prepared once
+ * for the search in many strings.
+ *
+ *****************************************************************************/
+
+#ifndef __USTRING_STR_PATTERN_H__
+#define __USTRING_STR_PATTERN_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "alloc.h"
+#include "str.h"
+
+/**
+ * @addtogroup API
+ * @{
+ *
+ * @addtogroup StringPattern
+ *
+ * Compiled Pattern library API.
+ *
+ * Functions taking a NULL-terminated pattern compute its length and,
+ * for long patterns, the search shift table on every call. Compiled pattern
+ * keeps both, so @c _pat variants of the search, trim and replace functions
+ * start the search right away. Results are the same as of the functions
+ * taking the pattern characters.
+ *
+ * Pattern is immutable after compilation, so it may be used by
+ * several threads at the same time.
+ *
+ * @code
+ *      str_pattern_t* secret = str_pattern_compile("password=");
+ *      for (size_t i = 0; i < str_list_size(lines); i++) {
+ *          str_t* line = str_list_at(lines, i);
+ *          if (str_contains_pat(line, secret)) {
+ *              str_replace_pat(line, secret, "***=");
+ *          }
+ *      }
+ *      str_pattern_drop(&secret);
+ * @endcode
+ *
+ * @{
+ */
+
+typedef struct __str_pattern str_pattern_t; /**< Compiled pattern type */
+
+/**
+ * @brief Compiles the pattern
+ *
+ * @param pattern NULL-terminated byte string of valid ASCII characters
+ * @return On success, returns the pointer to the new pattern instance.
+ *      On failure or if @c pattern is @c NULL , returns @c NULL
+ */
+str_pattern_t* str_pattern_compile(const char* pattern);
+
+/**
+ * @brief Compiles the pattern with the allocator
+ *
+ * Same as @c str_pattern_compile , but the memory is allocated with the given allocator.
+ *
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ * @param pattern NULL-terminated byte string of valid ASCII characters
+ * @return On success, returns the pointer to the new pattern instance.
+ *      On failure or if @c pattern is @c NULL , returns @c NULL
+ */
+str_pattern_t* str_pattern_compile_alloc(const ustring_allocator_t* allocator, const char* pattern);
+
+/**
+ * @brief Drops the pattern instance
+ *
+ * @param self Pointer to the pointer to the initialized pattern instance
+ * @note If @c self or @c *self is @c NULL, function does nothing
+ * @warning After pattern is dropped it must not be used,
+ *      the pattern pointer passed to the function will be set to @c NULL
+ */
+void str_pattern_drop(str_pattern_t** self);
+
+/**
+ * @brief Returns the pattern length
+ *
+ * @param self Pointer to the initialized pattern instance
+ * @return Number of pattern characters. If @c self is @c NULL , 0 is returned
+ */
+size_t str_pattern_len(const str_pattern_t* self);
+
+/**
+ * @brief Returns the pointer to the NULL-terminated pattern characters
+ *
+ * @param self Pointer to the initialized pattern instance
+ * @return Pattern characters. If @c self is @c NULL , @c NULL is returned
+ */
+const char* str_pattern_as_ptr(const str_pattern_t* self);
+
+/**
+ * @brief Checks if string contains the compiled pattern
+ *
+ * Same as @c str_contains .
+ *
+ * @param self Pointer to the initialized string instance
+ * @param pattern Pointer to the compiled pattern
+ * @return @c true if pattern is found; @c false otherwise or if either argument is @c NULL
+ */
+bool str_contains_pat(const str_t* self, const str_pattern_t* pattern);
+
+/**
+ * @brief Finds the first occurrence of the compiled pattern
+ *
+ * Same as @c str_find .
+ *
+ * @param self Pointer to the initialized string instance
+ * @param pattern Pointer to the compiled pattern
+ * @return Index of the first character of the occurrence; @c STR_NPOS if not found
+ *      or if either argument is @c NULL
+ */
+size_t str_find_pat(const str_t* self, const str_pattern_t* pattern);
+
+/**
+ * @brief Finds the first occurrence of the compiled pattern starting at or after the position
+ *
+ * Same as @c str_find_from .
+ *
+ * @param self Pointer to the initialized string instance
+ * @param pattern Pointer to the compiled pattern
+ * @param from Position to start the search at
+ * @return Index of the first character of the occurrence; @c STR_NPOS if not found,
+ *      if either argument is @c NULL or if @c from is greater than the string length
+ */
+size_t str_find_from_pat(const str_t* self, const str_pattern_t* pattern, size_t from);
+
+/**
+ * @brief Checks if string starts with the compiled pattern
+ *
+ * Same as @c str_starts_with .
+ *
+ * @param self Pointer to the initialized string instance
+ * @param pattern Pointer to the compiled pattern
+ * @return @c true if string starts with the pattern; @c false otherwise or if either argument is @c NULL
+ */
+bool str_starts_with_pat(const str_t* self, const str_pattern_t* pattern);
+
+/**
+ * @brief Checks if string ends with the compiled pattern
+ *
+ * Same as @c str_ends_with .
+ *
+ * @param self Pointer to the initialized string instance
+ * @param pattern Pointer to the compiled pattern
+ * @return @c true if string ends with the pattern; @c false otherwise or if either argument is @c NULL
+ */
+bool str_ends_with_pat(const str_t* self, const str_pattern_t* pattern);
+
+/**
+ * @brief Removes all occurrences of the compiled pattern
+ *
+ * Same as @c str_trim_matches .
+ *
+ * @param self Pointer to the initialized string instance
+ * @param pattern Pointer to the compiled pattern
+ * @return On success, returns 0. On failure returns non-zero error code
+ */
+int str_trim_matches_pat(str_t* self, const str_pattern_t* pattern);
+
+/**
+ * @brief Removes the compiled pattern from the start of the string
+ *
+ * Same as @c str_trim_start_matches .
+ *
+ * @param self Pointer to the initialized string instance
+ * @param pattern Pointer to the compiled pattern
+ * @return On success, returns 0. On failure returns non-zero error code
+ */
+int str_trim_start_matches_pat(str_t* self, const str_pattern_t* pattern);
+
+/**
+ * @brief Removes the compiled pattern from the end of the string
+ *
+ * Same as @c str_trim_end_matches .
+ *
+ * @param self Pointer to the initialized string instance
+ * @param pattern Pointer to the compiled pattern
+ * @return On success, returns 0. On failure returns non-zero error code
+ */
+int str_trim_end_matches_pat(str_t* self, const str_pattern_t* pattern);
+
+/**
+ * @brief Replaces all occurrences of the compiled pattern with the provided replacement substring
+ *
+ * Same as @c str_replace .
+ *
+ * @param self Pointer to the initialized string instance
+ * @param pattern Pointer to the compiled pattern
+ * @param replacement Substring to be inserted in the string replacing pattern.
+ *      If @c NULL , it is treated as an empty string
+ * @return On success, returns 0. On failure returns non-zero error code
+ */
+int str_replace_pat(str_t* self, const str_pattern_t* pattern, const char* replacement);
+
+/**
+ * @brief Replaces first @c count occurrences of the compiled pattern with the provided replacement substring
+ *
+ * Same as @c str_replacen .
+ *
+ * @param self Pointer to the initialized string instance
+ * @param pattern Pointer to the compiled pattern
+ * @param replacement Substring to be inserted in the string replacing pattern.
+ *      If @c NULL , it is treated as an empty string
+ * @param count Maximum number of occurrences to be replaced
+ * @return On success, returns 0. On failure returns non-zero error code
+ */
+int str_replacen_pat(str_t* self, const str_pattern_t* pattern, const char* replacement, size_t count);
+
+/**
+ * @}
+ */ /* StringPattern */
+
+/**
+ * @}
+ */ /* API */
+
+#endif /* __USTRING_STR_PATTERN_H__ */
@@ -0,0 +1,242 @@
+/**************************************************************************//**
+ *
+ * @file    str_rope.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   String Rope library API
+ *
+ * The library provides rope - string stored as a balanced tree of
+ * character chunks, with logarithmic time editing in any position.
+ *
+ *****************************************************************************/
+
+#ifndef __USTRING_STR_ROPE_H__
+#define __USTRING_STR_ROPE_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "alloc.h"
+#include "str.h"
+#include "str_view.h"
+
+/**
+ * @addtogroup API
+ * @{
+ *
+ * @addtogroup StringRope
+ *
+ * String Rope library API.
+ *
+ * Rope keeps characters in chunks of up to @c STR_ROPE_CHUNK_SIZE characters,
+ * chunks are nodes of a balanced search tree ordered by the character position.
+ * Insertion, removal, concatenation and splitting take O(log n) expected time
+ * plus the time to copy the inserted characters, regardless of the rope length.
+ * Rope is meant for large strings edited in the middle, the result is flattened
+ * into a string once the editing is done.
+ *
+ * @code
+ *      str_rope_t* rope = str_rope_from_view(str_view_new("Hello !"));
+ *      str_rope_insert(rope, 6, str_view_new("world"));
+ *      str_rope_erase(rope, 0, 5);
+ *      str_rope_insert(rope, 0, str_view_new("Goodbye"));
+ *      str_t* text = str_rope_to_str(rope); // "Goodbye world!"
+ * @endcode
+ *
+ * @{
+ */
+
+typedef struct __str_rope str_rope_t; /**< String rope type */
+
+#define STR_ROPE_CHUNK_SIZE ((size_t) 1024) /**< Maximum number of characters in a rope chunk */
+
+/**
+ * @brief Creates new instance of an empty rope
+ *
+ * @return On success, returns the pointer to the new rope instance. On failure, returns @c NULL
+ */
+str_rope_t* str_rope_new(void);
+
+/**
+ * @brief Creates new instance of an empty rope with the allocator
+ *
+ * Same as @c str_rope_new , but the memory is allocated with the given allocator,
+ * which is then used by the instance for all subsequent operations.
+ *
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ * @return On success, returns the pointer to the new rope instance. On failure, returns @c NULL
+ */
+str_rope_t* str_rope_new_alloc(const ustring_allocator_t* allocator);
+
+/**
+ * @brief Creates new rope holding the characters of the view
+ *
+ * @param view View of the characters
+ * @return On success, returns the pointer to the new rope instance. On failure, returns @c NULL
+ */
+str_rope_t* str_rope_from_view(str_view_t view);
+
+/**
+ * @brief Creates new rope holding the characters of the view with the allocator
+ *
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ * @param view View of the characters
+ * @return On success, returns the pointer to the new rope instance. On failure, returns @c NULL
+ */
+str_rope_t* str_rope_from_view_alloc(const ustring_allocator_t* allocator, str_view_t view);
+
+/**
+ * @brief Drops the rope instance
+ *
+ * @param self Pointer to the pointer to the initialized rope instance
+ * @note If @c self or @c *self is @c NULL, function does nothing
+ * @warning After rope is dropped it must not be used,
+ *      the rope pointer passed to the function will be set to @c NULL
+ */
+void str_rope_drop(str_rope_t** self);
+
+/**
+ * @brief Returns the number of characters in the rope
+ *
+ * @param self Pointer to the initialized rope instance
+ * @return Length of the rope. If @c self is @c NULL , 0 is returned
+ */
+size_t str_rope_len(const str_rope_t* self);
+
+/**
+ * @brief Returns character of the rope at the given position starting from 0
+ *
+ * @param self Pointer to the initialized rope instance
+ * @param pos Position of the character
+ * @return Character at the given position; 0 is returned if position
+ *      violates the bounds or if @c self is @c NULL
+ */
+char str_rope_at(const str_rope_t* self, size_t pos);
+
+/**
+ * @brief Inserts characters into the rope at the given position
+ *
+ * Characters are copied into the chunk containing the position if it has
+ * enough room, otherwise the chunk is cut in two and the characters are
+ * inserted as new chunks. Adjacent short chunks are merged.
+ *
+ * @param self Pointer to the initialized rope instance
+ * @param pos Position of the first inserted character, at most the rope length
+ * @param text View of the inserted characters. Must not refer to the rope chunks
+ * @return On success, returns 0. On failure returns non-zero error code,
+ *      the rope is left unchanged
+ */
+int str_rope_insert(str_rope_t* self, size_t pos, str_view_t text);
+
+/**
+ * @brief Appends characters to the end of the rope
+ *
+ * Same as @c str_rope_insert at the rope length.
+ */
+int str_rope_append(str_rope_t* self, str_view_t text);
+
+/**
+ * @brief Removes characters from the rope
+ *
+ * @param self Pointer to the initialized rope instance
+ * @param pos Position of the first removed character, at most the rope length
+ * @param len Number of removed characters. Range is clamped to the end of the rope
+ * @return On success, returns 0. On failure returns non-zero error code,
+ *      the rope is left unchanged
+ */
+int str_rope_erase(str_rope_t* self, size_t pos, size_t len);
+
+/**
+ * @brief Replaces range of characters of the rope with the given characters
+ *
+ * Same as @c str_rope_erase followed by @c str_rope_insert at @c pos .
+ *
+ * @param self Pointer to the initialized rope instance
+ * @param pos Position of the first replaced character, at most the rope length
+ * @param len Number of replaced characters. Range is clamped to the end of the rope
+ * @param text View of the inserted characters. Must not refer to the rope chunks
+ * @return On success, returns 0. On failure returns non-zero error code
+ */
+int str_rope_replace(str_rope_t* self, size_t pos, size_t len, str_view_t text);
+
+/**
+ * @brief Moves all chunks of the other rope to the end of the rope
+ *
+ * No characters are copied, after the call @c other is empty.
+ *
+ * @param self Pointer to the initialized rope instance
+ * @param other Pointer to the initialized rope instance with the same allocator
+ * @return On success, returns 0. On failure returns non-zero error code.
+ *      Function fails if either rope is @c NULL , if ropes are the same
+ *      or have different allocators
+ */
+int str_rope_concat(str_rope_t* self, str_rope_t* other);
+
+/**
+ * @brief Splits the rope in two at the given position
+ *
+ * Characters starting from @c pos are moved to the new rope,
+ * only the chunk containing the position is copied.
+ *
+ * @param self Pointer to the initialized rope instance
+ * @param pos Position of the split, at most the rope length
+ * @return On success, returns the pointer to the new rope holding the tail of the rope.
+ *      On failure, returns @c NULL and the rope is left unchanged
+ */
+str_rope_t* str_rope_split_off(str_rope_t* self, size_t pos);
+
+/**
+ * @brief Creates new rope holding a copy of the range of the rope characters
+ *
+ * Function takes O(log n) time to find the range plus the time to copy it.
+ *
+ * @param self Pointer to the initialized rope instance
+ * @param pos Position of the first character, at most the rope length
+ * @param len Number of characters. Range is clamped to the end of the rope
+ * @return On success, returns the pointer to the new rope instance. On failure, returns @c NULL
+ */
+str_rope_t* str_rope_substr(const str_rope_t* self, size_t pos, size_t len);
+
+/**
+ * @brief Advances the iteration over the rope chunks
+ *
+ * Chunks are visited in order, each call takes O(log n) time:
+ *
+ * @code
+ *      size_t pos = 0;
+ *      str_view_t chunk;
+ *      while (str_rope_next_chunk(rope, &pos, &chunk)) {
+ *          fwrite(chunk.ptr, 1, chunk.len, file);
+ *      }
+ * @endcode
+ *
+ * @param self Pointer to the initialized rope instance
+ * @param pos Pointer to the position of the next character, must be set to 0 before the first call
+ * @param chunk Pointer to the view receiving characters of the chunk starting from @c *pos
+ * @return @c true if the chunk is yielded; @c false if there are no more chunks
+ *      or if either argument is @c NULL
+ * @warning Rope must not be modified during the iteration
+ */
+bool str_rope_next_chunk(const str_rope_t* self, size_t* pos, str_view_t* chunk);
+
+/**
+ * @brief Flattens the rope into a new string
+ *
+ * String is allocated with the rope allocator.
+ *
+ * @param self Pointer to the initialized rope instance
+ * @return On success, returns the pointer to the new string instance. On failure, returns @c NULL
+ * @note If @c self is @c NULL , an empty string is created
+ */
+str_t* str_rope_to_str(const str_rope_t* self);
+
+/**
+ * @}
+ */ /* StringRope */
+
+/**
+ * @}
+ */ /* API */
+
+#endif /* __USTRING_STR_ROPE_H__ */
@@ -0,0 +1,290 @@
+/**************************************************************************//**
+ *
+ * @file    str_view.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   String view API
+ *
+ * String view is a non-owning reference to a sequence of characters:
+ * a pointer and a length. Views are passed by value and none of the
+ * view operations allocate memory.
+ *
+ *****************************************************************************/
+
+#ifndef __USTRING_STR_VIEW_H__
+#define __USTRING_STR_VIEW_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "str.h"
+
+/**
+ * @addtogroup API
+ * @{
+ *
+ * @addtogroup StringView
+ *
+ * String view API.
+ *
+ * View refers to characters owned by someone else: a string instance,
+ * a C string or any other buffer. View stays valid as long as the
+ * referred characters are neither modified nor released. View is not
+ * null-terminated, use @c str_from_view to get a C-compatible string.
+ *
+ * @code
+ *      str_view_t line = str_view_new("  key = value  ");
+ *      size_t eq = str_view_find(line, str_view_new("="));
+ *      str_view_t key = str_view_trim(str_view_slice(line, 0, eq));
+ *      str_view_t value = str_view_trim(str_view_slice(line, eq + 1, STR_NPOS));
+ *      str_t* owned = str_from_view(value); // "value"
+ * @endcode
+ *
+ * @{
+ */
+
+/**
+ * @brief String view type
+ *
+ * @note @c ptr may be @c NULL only if @c len is zero
+ */
+typedef struct str_view {
+    const char* ptr;    /**< Pointer to the first character */
+    size_t len;         /**< Number of characters */
+} str_view_t;
+
+/**
+ * @brief Creates view of the C string
+ *
+ * @param string Null-terminated byte string
+ * @return View of all characters of @c string .
+ *      Empty view if @c string is @c NULL
+ */
+str_view_t str_view_new(const char* string);
+
+/**
+ * @brief Creates view of the given characters
+ *
+ * @param ptr Pointer to the first character
+ * @param len Number of characters
+ * @return View of @c len characters starting at @c ptr .
+ *      Empty view if @c ptr is @c NULL
+ */
+str_view_t str_view_from_parts(const char* ptr, size_t len);
+
+/**
+ * @brief Creates view of the whole string
+ *
+ * @param self Pointer to the initialized string instance
+ * @return View of all characters of the string.
+ *      Empty view if @c self is @c NULL
+ * @warning View is invalidated by any operation modifying the string
+ */
+str_view_t str_as_view(const str_t* self);
+
+/**
+ * @brief Creates new instance of string from the view
+ *
+ * Same as @c str_new , but the length of the characters is already known.
+ *
+ * @param view View of the characters to be copied
+ * @return On success, returns the pointer to the new string instance. On failure, returns @c NULL
+ * @note Non-ASCII characters will be replaced with the '?' character
+ */
+str_t* str_from_view(str_view_t view);
+
+/**
+ * @brief Creates new instance of string from the view in the arena
+ *
+ * @param arena Pointer to the initialized arena instance. If @c NULL , the global allocator is used
+ * @param view View of the characters to be copied
+ * @return On success, returns the pointer to the new string instance. On failure, returns @c NULL
+ */
+str_t* str_from_view_in(ustring_arena_t* arena, str_view_t view);
+
+/**
+ * @brief Creates new instance of string from the view with the allocator
+ *
+ * @param allocator Pointer to the allocator vtable. If @c NULL , the global allocator is used
+ * @param view View of the characters to be copied
+ * @return On success, returns the pointer to the new string instance. On failure, returns @c NULL
+ */
+str_t* str_from_view_alloc(const ustring_allocator_t* allocator, str_view_t view);
+
+/**
+ * @brief Returns the length of the view
+ */
+size_t str_view_len(str_view_t self);
+
+/**
+ * @brief Checks if view is empty
+ */
+bool str_view_is_empty(str_view_t self);
+
+/**
+ * @brief Returns character of the view at the given position starting from 0
+ *
+ * @return Character on the given position; 0 is returned if position violates the bounds
+ */
+char str_view_at(str_view_t self, size_t pos);
+
+/**
+ * @brief Returns view of the characters in range [start, end)
+ *
+ * Bounds are clamped to the view: @c end greater than the view length
+ * (e.g. @c STR_NPOS ) denotes the end of the view,
+ * @c start greater than @c end gives an empty view.
+ *
+ * @param self View to be sliced
+ * @param start Index of the first character of the slice
+ * @param end Index past the last character of the slice
+ * @return View of the characters in range
+ */
+str_view_t str_view_slice(str_view_t self, size_t start, size_t end);
+
+/**
+ * @brief Checks if two views refer to equal character sequences
+ */
+bool str_view_eq(str_view_t a, str_view_t b);
+
+/**
+ * @brief Compares two views lexicographically
+ *
+ * Characters are compared as unsigned values. Shorter view
+ * is less than the longer one it is a prefix of.
+ *
+ * @return Negative value if @c a is less than @c b , zero if views are equal,
+ *      positive value if @c a is greater than @c b
+ */
+int str_view_cmp(str_view_t a, str_view_t b);
+
+/**
+ * @brief Finds the first occurrence of the pattern in the view
+ *
+ * @note Empty pattern is found at index 0 of any view
+ *
+ * @param self View to search in
+ * @param pattern Search pattern
+ * @return Index of the first character of the first pattern occurrence;
+ *      @c STR_NPOS if the pattern is not found
+ */
+size_t str_view_find(str_view_t self, str_view_t pattern);
+
+/**
+ * @brief Checks if view starts with the pattern
+ *
+ * @note Every view begins with an empty pattern
+ */
+bool str_view_starts_with(str_view_t self, str_view_t pattern);
+
+/**
+ * @brief Checks if view ends with the pattern
+ *
+ * @note Every view ends with an empty pattern
+ */
+bool str_view_ends_with(str_view_t self, str_view_t pattern);
+
+/**
+ * @brief Returns 64-bit hash of the view characters
+ *
+ * @param self View to hash
+ * @param seed Hash seed, @c STR_HASH_DEFAULT_SEED gives the same hash as @c str_hash
+ * @return Hash of the view characters
+ */
+uint64_t str_view_hash(str_view_t self, uint64_t seed);
+
+/**
+ * @brief Returns view without leading and trailing whitespace characters
+ *
+ * Whitespace characters are the same as for @c str_trim .
+ */
+str_view_t str_view_trim(str_view_t self);
+
+/**
+ * @brief Returns view without leading whitespace characters
+ */
+str_view_t str_view_trim_start(str_view_t self);
+
+/**
+ * @brief Returns view without trailing whitespace characters
+ */
+str_view_t str_view_trim_end(str_view_t self);
+
+/**
+ * @brief Character class
+ *
+ * Set of characters compiled into a 256-bit membership table and,
+ * if possible, into a pair of nibble lookup tables used to classify
+ * blocks of characters with vector shuffle instructions.
+ *
+ * @note Class fields are private and must not be accessed directly
+ */
+struct __str_class {
+    unsigned char bitmap[32];       /**< Membership bit of every character */
+    unsigned char lo_nibble[16];    /**< Class bits selected by the low nibble */
+    unsigned char hi_nibble[16];    /**< Class bits selected by the high nibble */
+    bool vectorized;                /**< Nibble tables represent the class exactly */
+};
+
+/**
+ * @brief Lazy split iterator
+ *
+ * Yields views of the tokens one at a time without allocating memory.
+ * Tokens are the same as the items of the string list built by
+ * @c str_split : empty tokens are skipped.
+ *
+ * @code
+ *      str_split_iter_t it = str_split_iter(str_view_new("One, Two; Three"), " ,;");
+ *      str_view_t token;
+ *      while (str_split_iter_next(&it, &token)) {
+ *          // token = "One", "Two", "Three"
+ *      }
+ * @endcode
+ *
+ * @note Iterator fields are private and must not be accessed directly
+ */
+typedef struct str_split_iter {
+    const char* ptr;            /**< Next character to be scanned */
+    const char* end;            /**< End of the characters being split */
+    struct __str_class delim;   /**< Compiled delimiter characters */
+} str_split_iter_t;
+
+/**
+ * @brief Creates split iterator over the view
+ *
+ * @param string View of the characters to be split
+ * @param delim Delimeter - NULL-terminated byte string of valid ASCII characters.
+ *      If @c NULL or empty, the whole non-empty view is yielded as a single token
+ * @return Split iterator
+ * @warning Iterator refers to @c string characters, they must stay valid
+ *      while the iterator is in use. @c delim is compiled into the iterator
+ *      and may be released after the call
+ */
+str_split_iter_t str_split_iter(str_view_t string, const char* delim);
+
+/**
+ * @brief Same as @c str_split_iter with whitespace characters as separator
+ */
+str_split_iter_t str_split_whitespace_iter(str_view_t string);
+
+/**
+ * @brief Advances the split iterator to the next token
+ *
+ * @param self Pointer to the split iterator
+ * @param token Pointer to the view receiving the next token
+ * @return @c true if the token is yielded;
+ *      @c false if there are no more tokens or if either @c self or @c token is @c NULL
+ */
+bool str_split_iter_next(str_split_iter_t* self, str_view_t* token);
+
+/**
+ * @}
+ */ /* StringView */
+
+/**
+ * @}
+ */ /* API */
+
+#endif /* __USTRING_STR_VIEW_H__ */
@@ -0,0 +1,45 @@
+/**************************************************************************//**
+ * 
+ * @file    alloc.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ * 
+ *****************************************************************************/
+
+#include <stdlib.h>
+
+#include <ustring/alloc.h>
+#include "alloc_p.h"
+
+static void* __default_alloc(void* ctx, size_t size) {
+    (void) ctx;
+    return malloc(size);
+}
+
+static void* __default_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size) {
+    (void) ctx;
+    (void) old_size;
+    return realloc(ptr, new_size);
+}
+
+static void __default_free(void* ctx, void* ptr) {
+    (void) ctx;
+    free(ptr);
+}
+
+static const ustring_allocator_t default_allocator = {
+    .alloc = __default_alloc,
+    .realloc = __default_realloc,
+    .free = __default_free,
+    .ctx = NULL,
+};
+
+static const ustring_allocator_t* global_allocator = &default_allocator;
+
+void ustring_set_allocator(const ustring_allocator_t* allocator) {
+    global_allocator = (allocator != NULL) ? allocator : &default_allocator;
+}
+
+const ustring_allocator_t* ustring_get_allocator(void) {
+    return global_allocator;
+}
@@ -0,0 +1,43 @@
+/******************************************************************************
+ * 
+ * @file    alloc_p.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ * 
+ * @brief   Memory allocator private header file
+ * 
+ *****************************************************************************/
+
+#ifndef __ALLOC_P_H__
+#define __ALLOC_P_H__
+
+#include <stddef.h>
+
+#include <ustring/alloc.h>
+
+/**
+ * @brief Allocates memory with the allocator
+ */
+static inline void* __ustring_malloc(const ustring_allocator_t* allocator, size_t size) {
+    return allocator->alloc(allocator->ctx, size);
+}
+
+/**
+ * @brief Resizes memory allocated with the allocator
+ */
+static inline void* __ustring_realloc(const ustring_allocator_t* allocator, void* ptr,
+                                      size_t old_size, size_t new_size)
+{
+    return allocator->realloc(allocator->ctx, ptr, old_size, new_size);
+}
+
+/**
+ * @brief Releases memory allocated with the allocator
+ */
+static inline void __ustring_free(const ustring_allocator_t* allocator, void* ptr) {
+    if (ptr != NULL) {
+        allocator->free(allocator->ctx, ptr);
+    }
+}
+
+#endif /* __ALLOC_P_H__ */
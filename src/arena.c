@@ -0,0 +1,209 @@
+/**************************************************************************//**
+ * 
+ * @file    arena.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ * 
+ *****************************************************************************/
+
+#include <string.h>
+#include <stdint.h>
+
+#include <ustring/arena.h>
+#include "arena_p.h"
+#include "alloc_p.h"
+
+#define ARENA_ALIGNMENT (_Alignof(max_align_t))
+
+static inline size_t __align_up(size_t size) {
+    return (size + (ARENA_ALIGNMENT - 1)) & ~(ARENA_ALIGNMENT - 1);
+}
+
+static void* __arena_allocator_alloc(void* ctx, size_t size) {
+    return __arena_alloc(ctx, size);
+}
+
+static void* __arena_allocator_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size) {
+    return __arena_realloc(ctx, ptr, old_size, new_size);
+}
+
+static void __arena_allocator_free(void* ctx, void* ptr) {
+    __arena_free(ctx, ptr);
+}
+
+static struct __arena_block* __arena_block_new(ustring_arena_t* self, size_t size) {
+    struct __arena_block* block = __ustring_malloc(self->parent, sizeof(struct __arena_block) + size);
+    if (block == NULL) {
+        return NULL;
+    }
+
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+
+    return block;
+}
+
+ustring_arena_t* ustring_arena_new(size_t block_size) {
+    const ustring_allocator_t* parent = ustring_get_allocator();
+
+    ustring_arena_t* self = __ustring_malloc(parent, sizeof(ustring_arena_t));
+    if (self == NULL) {
+        return NULL;
+    }
+
+    self->allocator.alloc = __arena_allocator_alloc;
+    self->allocator.realloc = __arena_allocator_realloc;
+    self->allocator.free = __arena_allocator_free;
+    self->allocator.ctx = self;
+    self->parent = parent;
+
+    self->head = NULL;
+    self->last_block = NULL;
+    self->last = NULL;
+    self->block_size = __align_up((block_size == 0) ? USTRING_ARENA_DEFAULT_BLOCK_SIZE : block_size);
+    self->used = 0;
+
+    return self;
+}
+
+void ustring_arena_reset(ustring_arena_t* self) {
+    if (self == NULL) {
+        return;
+    }
+
+    /* Keep one regular block for subsequent allocations */
+    struct __arena_block* kept = NULL;
+    struct __arena_block* block = self->head;
+
+    while (block != NULL) {
+        struct __arena_block* next = block->next;
+
+        if ((kept == NULL) && (block->size == self->block_size)) {
+            kept = block;
+            kept->next = NULL;
+            kept->used = 0;
+        } else {
+            __ustring_free(self->parent, block);
+        }
+
+        block = next;
+    }
+
+    self->head = kept;
+    self->last_block = NULL;
+    self->last = NULL;
+    self->used = 0;
+}
+
+void ustring_arena_drop(ustring_arena_t** self) {
+    if ((self == NULL) || (*self == NULL)) {
+        return;
+    }
+
+    const ustring_allocator_t* parent = (*self)->parent;
+
+    struct __arena_block* block = (*self)->head;
+    while (block != NULL) {
+        struct __arena_block* next = block->next;
+        __ustring_free(parent, block);
+        block = next;
+    }
+
+    __ustring_free(parent, *self);
+    *self = NULL;
+}
+
+size_t ustring_arena_used(const ustring_arena_t* self) {
+    return (self != NULL) ? self->used : 0;
+}
+
+const ustring_allocator_t* ustring_arena_allocator(ustring_arena_t* self) {
+    return (self != NULL) ? &self->allocator : NULL;
+}
+
+void* __arena_alloc(ustring_arena_t* self, size_t size) {
+    if (size > (SIZE_MAX - ARENA_ALIGNMENT - sizeof(struct __arena_block))) {
+        return NULL;
+    }
+
+    size = __align_up((size == 0) ? 1 : size);
+
+    struct __arena_block* block = self->head;
+
+    if ((block == NULL) || ((block->size - block->used) < size)) {
+        if (size > self->block_size) {
+            /* Dedicated block, current block keeps serving small allocations */
+            block = __arena_block_new(self, size);
+            if (block == NULL) {
+                return NULL;
+            }
+
+            if (self->head != NULL) {
+                block->next = self->head->next;
+                self->head->next = block;
+            } else {
+                self->head = block;
+            }
+        } else {
+            block = __arena_block_new(self, self->block_size);
+            if (block == NULL) {
+                return NULL;
+            }
+
+            block->next = self->head;
+            self->head = block;
+        }
+    }
+
+    void* ptr = (unsigned char*) block->data + block->used;
+    block->used += size;
+
+    self->last_block = block;
+    self->last = ptr;
+    self->used += size;
+
+    return ptr;
+}
+
+void* __arena_realloc(ustring_arena_t* self, void* ptr, size_t old_size, size_t new_size) {
+    if (ptr == NULL) {
+        return __arena_alloc(self, new_size);
+    }
+
+    if (ptr == self->last) {
+        /* Most recent allocation may be resized in place */
+        struct __arena_block* block = self->last_block;
+        const size_t offset = (size_t) ((unsigned char*) ptr - (unsigned char*) block->data);
+        const size_t aligned_size = __align_up((new_size == 0) ? 1 : new_size);
+
+        if ((new_size <= (SIZE_MAX - ARENA_ALIGNMENT)) && (aligned_size <= (block->size - offset))) {
+            self->used = self->used - (block->used - offset) + aligned_size;
+            block->used = offset + aligned_size;
+            return ptr;
+        }
+    }
+
+    void* new_ptr = __arena_alloc(self, new_size);
+    if (new_ptr == NULL) {
+        return NULL;
+    }
+
+    memcpy(new_ptr, ptr, (old_size < new_size) ? old_size : new_size);
+
+    return new_ptr;
+}
+
+void __arena_free(ustring_arena_t* self, void* ptr) {
+    if ((ptr == NULL) || (ptr != self->last)) {
+        return;
+    }
+
+    struct __arena_block* block = self->last_block;
+    const size_t offset = (size_t) ((unsigned char*) ptr - (unsigned char*) block->data);
+
+    self->used -= block->used - offset;
+    block->used = offset;
+    self->last = NULL;
+    self->last_block = NULL;
+}
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * 
+ * @file    arena_p.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ * 
+ * @brief   Arena allocator private header file
+ * 
+ *****************************************************************************/
+
+#ifndef __ARENA_P_H__
+#define __ARENA_P_H__
+
+#include <stddef.h>
+
+#include <ustring/alloc.h>
+#include <ustring/arena.h>
+
+struct __arena_block {
+    struct __arena_block* next;
+    size_t size;
+    size_t used;
+    max_align_t data[];
+};
+
+struct __ustring_arena {
+    ustring_allocator_t allocator;
+    const ustring_allocator_t* parent;
+    struct __arena_block* head;
+    struct __arena_block* last_block;
+    void* last;
+    size_t block_size;
+    size_t used;
+};
+
+/**
+ * @brief Allocates memory in the arena
+ * 
+ * @param self Pointer to the initialized arena instance
+ * @param size Size of the allocation in bytes
+ * @return Pointer to the memory aligned for any object type; @c NULL on failure
+ */
+void* __arena_alloc(ustring_arena_t* self, size_t size);
+
+/**
+ * @brief Resizes memory allocated in the arena
+ * 
+ * The most recent allocation is resized in place if possible,
+ * otherwise contents are copied to the new allocation.
+ * 
+ * @param self Pointer to the initialized arena instance
+ * @param ptr Pointer to the memory allocated in the arena or @c NULL
+ * @param old_size Current size of the allocation in bytes
+ * @param new_size New size of the allocation in bytes
+ * @return Pointer to the resized memory; @c NULL on failure
+ */
+void* __arena_realloc(ustring_arena_t* self, void* ptr, size_t old_size, size_t new_size);
+
+/**
+ * @brief Releases memory allocated in the arena
+ * 
+ * Only the most recent allocation is actually released,
+ * other allocations are kept until the arena is reset.
+ * 
+ * @param self Pointer to the initialized arena instance
+ * @param ptr Pointer to the memory allocated in the arena or @c NULL
+ */
+void __arena_free(ustring_arena_t* self, void* ptr);
+
+#endif /* __ARENA_P_H__ */
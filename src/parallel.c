@@ -0,0 +1,131 @@
+/**************************************************************************//**
+ *
+ * @file    parallel.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ *****************************************************************************/
+
+#include <unistd.h>
+
+#include "parallel_p.h"
+
+static void __ustring_pool_take(struct __ustring_pool* self) {
+    for (;;) {
+        const size_t idx = atomic_fetch_add_explicit(&self->next, 1, memory_order_relaxed);
+        if (idx >= self->tasks) {
+            return;
+        }
+
+        self->task(self->ctx, idx);
+    }
+}
+
+static void* __ustring_pool_worker(void* arg) {
+    struct __ustring_pool* self = arg;
+    size_t phase = 0;
+
+    pthread_mutex_lock(&self->lock);
+
+    for (;;) {
+        while ((self->phase == phase) && !self->stop) {
+            pthread_cond_wait(&self->phase_started, &self->lock);
+        }
+
+        if (self->stop) {
+            pthread_mutex_unlock(&self->lock);
+            return NULL;
+        }
+
+        phase = self->phase;
+        pthread_mutex_unlock(&self->lock);
+
+        __ustring_pool_take(self);
+
+        pthread_mutex_lock(&self->lock);
+        self->running -= 1;
+        if (self->running == 0) {
+            pthread_cond_signal(&self->phase_done);
+        }
+    }
+}
+
+size_t __ustring_thread_count(size_t threads) {
+    if (threads == 0) {
+#ifdef _SC_NPROCESSORS_ONLN
+        const long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (online > 0) ? (size_t) online : 1;
+#else
+        threads = 1;
+#endif
+    }
+
+    return (threads > USTRING_MAX_THREADS) ? USTRING_MAX_THREADS : threads;
+}
+
+void __ustring_pool_start(struct __ustring_pool* self, size_t threads) {
+    self->started = 0;
+    self->phase = 0;
+    self->running = 0;
+    self->stop = false;
+    atomic_init(&self->next, 0);
+
+    if (threads > USTRING_MAX_THREADS) {
+        threads = USTRING_MAX_THREADS;
+    }
+
+    pthread_mutex_init(&self->lock, NULL);
+    pthread_cond_init(&self->phase_started, NULL);
+    pthread_cond_init(&self->phase_done, NULL);
+
+    while ((self->started + 1 < threads)
+            && (pthread_create(&self->workers[self->started], NULL, __ustring_pool_worker, self) == 0))
+    {
+        self->started += 1;
+    }
+}
+
+void __ustring_pool_run(struct __ustring_pool* self, size_t tasks, void (*task)(void* ctx, size_t idx), void* ctx) {
+    pthread_mutex_lock(&self->lock);
+
+    self->task = task;
+    self->ctx = ctx;
+    self->tasks = tasks;
+    atomic_store_explicit(&self->next, 0, memory_order_relaxed);
+    self->running = self->started;
+    self->phase += 1;
+    pthread_cond_broadcast(&self->phase_started);
+
+    pthread_mutex_unlock(&self->lock);
+
+    __ustring_pool_take(self);
+
+    pthread_mutex_lock(&self->lock);
+    while (self->running != 0) {
+        pthread_cond_wait(&self->phase_done, &self->lock);
+    }
+    pthread_mutex_unlock(&self->lock);
+}
+
+void __ustring_pool_stop(struct __ustring_pool* self) {
+    pthread_mutex_lock(&self->lock);
+    self->stop = true;
+    pthread_cond_broadcast(&self->phase_started);
+    pthread_mutex_unlock(&self->lock);
+
+    for (size_t i = 0; i < self->started; i++) {
+        pthread_join(self->workers[i], NULL);
+    }
+
+    pthread_cond_destroy(&self->phase_done);
+    pthread_cond_destroy(&self->phase_started);
+    pthread_mutex_destroy(&self->lock);
+}
+
+void __ustring_parallel_for(size_t threads, size_t tasks, void (*task)(void* ctx, size_t idx), void* ctx) {
+    struct __ustring_pool pool;
+
+    __ustring_pool_start(&pool, (threads < tasks) ? threads : tasks);
+    __ustring_pool_run(&pool, tasks, task, ctx);
+    __ustring_pool_stop(&pool);
+}
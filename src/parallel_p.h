@@ -0,0 +1,96 @@
+/******************************************************************************
+ *
+ * @file    parallel_p.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   Worker threads private header file
+ *
+ *****************************************************************************/
+
+#ifndef __PARALLEL_P_H__
+#define __PARALLEL_P_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#define USTRING_MAX_THREADS ((size_t) 256)
+
+/* Minimum number of characters processed by one worker */
+#define USTRING_PAR_MIN_CHUNK ((size_t) 1 << 16)
+
+/*
+ * Worker pool of a single call. Workers are started once and wait
+ * for the phases of the call: each phase is a set of tasks, which
+ * the calling thread and the workers take from the shared counter.
+ * Phase ends when all workers are done with it, so the next phase
+ * sees results of the previous one.
+ */
+struct __ustring_pool {
+    pthread_t workers[USTRING_MAX_THREADS - 1];
+    size_t started;
+    pthread_mutex_t lock;
+    pthread_cond_t phase_started;
+    pthread_cond_t phase_done;
+    size_t phase;                   /* guarded by lock */
+    size_t running;                 /* workers in the phase, guarded by lock */
+    bool stop;                      /* guarded by lock */
+    void (*task)(void* ctx, size_t idx);
+    void* ctx;
+    size_t tasks;
+    atomic_size_t next;
+};
+
+/**
+ * @brief Resolves the requested number of worker threads
+ *
+ * @param threads Requested number of threads. If 0, the number of online processors is used
+ * @return Number of threads between 1 and @c USTRING_MAX_THREADS
+ */
+size_t __ustring_thread_count(size_t threads);
+
+/**
+ * @brief Starts the worker pool
+ *
+ * Calling thread is one of the workers, so @c threads - 1 threads are started.
+ * If worker threads cannot be started, remaining workers run all tasks.
+ *
+ * @param self Pointer to the pool
+ * @param threads Number of worker threads
+ */
+void __ustring_pool_start(struct __ustring_pool* self, size_t threads);
+
+/**
+ * @brief Runs tasks on the pool workers and waits for all of them to finish
+ *
+ * Tasks are taken by the workers in ascending order of their indices,
+ * each task is run exactly once.
+ *
+ * @param self Pointer to the started pool
+ * @param tasks Number of tasks
+ * @param task Task function, called with the context and the task index
+ * @param ctx Task context
+ */
+void __ustring_pool_run(struct __ustring_pool* self, size_t tasks, void (*task)(void* ctx, size_t idx), void* ctx);
+
+/**
+ * @brief Stops the pool workers and waits for them to exit
+ */
+void __ustring_pool_stop(struct __ustring_pool* self);
+
+/**
+ * @brief Runs a single phase of tasks on a temporary worker pool
+ *
+ * Same as @c __ustring_pool_run on the pool of at most @c tasks workers,
+ * which is stopped before return.
+ *
+ * @param threads Number of worker threads
+ * @param tasks Number of tasks
+ * @param task Task function, called with the context and the task index
+ * @param ctx Task context
+ */
+void __ustring_parallel_for(size_t threads, size_t tasks, void (*task)(void* ctx, size_t idx), void* ctx);
+
+#endif /* __PARALLEL_P_H__ */
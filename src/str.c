@@ -7,88 +7,415 @@
  *****************************************************************************/
 
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 #include <errno.h>
 
 #include <ustring/str.h>
+#include <ustring/str_view.h>
+#include <ustring/str_pattern.h>
+#include <ustring/str_charset.h>
 #include "str_p.h"
+#include "alloc_p.h"
+#include "str_class_p.h"
+#include "str_search_p.h"
+#include "str_simd_p.h"
 
 #define USTRING_OK  ((int) 0)
 #define USTRING_ERR ((int) 1)
 
-str_t* str_new(const char* string) {   
-    if (string == NULL) {
-        return str_with_capacity(STR_DEFAULT_CAPACITY);
-    }
+/* Occurrence positions kept by str_replace between counting and filling */
+#define STR_REPLACE_STACK_MATCHES ((size_t) 128)
 
-    const size_t len = __str_literal_len(string);
-    size_t cap = STR_DEFAULT_CAPACITY;
+/* Characters converted at once when looking for the ones of the other case */
+#define STR_CASE_SCAN_BLOCK ((size_t) 256)
 
-    while (len >= cap) {
-        cap *= 2;
+/**
+ * @brief Allocates an empty string with the buffer of the given capacity
+ * 
+ * Buffers of capacity up to STR_INLINE_CAPACITY are allocated
+ * in the same memory block as the string header.
+ * If @c allocator is @c NULL , the global allocator is used.
+ */
+static str_t* __str_alloc(const ustring_allocator_t* allocator, size_t cap) {
+    const bool is_inline = (cap <= STR_INLINE_CAPACITY);
+
+    if (allocator == NULL) {
+        allocator = ustring_get_allocator();
     }
-    
-    str_t* self = malloc(sizeof(str_t));
+
+    str_t* self = __ustring_malloc(allocator, sizeof(str_t) + (is_inline ? cap : 0));
     if (self == NULL) {
         return NULL;
     }
 
-    self->len = len;
-    self->cap = cap;
-    self->buffer = malloc(self->cap * sizeof(char));
-    if (self->buffer == NULL) {
-        free(self);
-        return NULL;
+    if (is_inline) {
+        self->buffer = self->inline_buffer;
+    } else {
+        self->buffer = __ustring_malloc(allocator, cap * sizeof(char));
+        if (self->buffer == NULL) {
+            __ustring_free(allocator, self);
+            return NULL;
+        }
     }
 
-    for (size_t i = 0; i < len; i++) {
-        self->buffer[i] = __is_ascii(string[i]) ? string[i] : '?';
-    }
-    self->buffer[len] = '\0';
+    self->allocator = allocator;
+    self->shared = NULL;
+    self->len = 0;
+    self->cap = cap;
+    atomic_init(&self->hash, 0);
+    atomic_init(&self->hashed, false);
+    self->buffer[0] = '\0';
 
     return self;
 }
 
-str_t* str_with_capacity(size_t capacity) {
-    str_t* self = malloc(sizeof(str_t));
+/**
+ * @brief Releases the reference to the shared block
+ * 
+ * The last owner frees the block.
+ */
+static void __str_shared_release(const ustring_allocator_t* allocator, struct __str_shared* shared) {
+    if (atomic_fetch_sub_explicit(&shared->refs, 1, memory_order_acq_rel) == 1) {
+        __ustring_free(allocator, shared);
+    }
+}
+
+/**
+ * @brief Converts the string case, characters are made unique only if some of them change
+ */
+static int __str_case_convert(str_t* self, bool upper) {
     if (self == NULL) {
-        return NULL;
+        return USTRING_ERR;
     }
 
-    self->len = 0;
-    self->cap = (capacity == 0) ? 1 : capacity;
-    self->buffer = malloc(capacity * sizeof(char));
-    if (self->buffer == NULL) {
-        free(self);
+    __str_hash_invalidate(self);
+
+    /*
+     * Blocks of the shared characters are converted aside and compared until
+     * the first changed character, unique ones are converted in place at once
+     */
+    char block[STR_CASE_SCAN_BLOCK];
+    size_t idx = 0;
+
+    while ((self->shared != NULL) && (idx < self->len)) {
+        const size_t block_len = (self->len - idx < STR_CASE_SCAN_BLOCK) ? self->len - idx : STR_CASE_SCAN_BLOCK;
+
+        __simd_case_convert(block, self->buffer + idx, block_len, upper);
+
+        const size_t mismatch = __simd_mismatch(block, self->buffer + idx, block_len);
+        idx += mismatch;
+
+        if (mismatch != block_len) {
+            break;
+        }
+    }
+
+    if (idx == self->len) {
+        return USTRING_OK;
+    }
+
+    if (!__str_make_unique(self)) {
+        return USTRING_ERR;
+    }
+
+    __simd_case_convert(self->buffer + idx, self->buffer + idx, self->len - idx, upper);
+
+    return USTRING_OK;
+}
+
+/**
+ * @brief Counts non-overlapping pattern occurrences following the one at @c matches[0]
+ * 
+ * Counting stops after @c max_count occurrences. Positions of the first
+ * @c cap occurrences are stored in @c matches , so they are not searched again.
+ */
+static size_t __str_replace_count(const char* src, size_t len, const struct __str_pattern* pattern,
+                                  size_t* matches, size_t cap, size_t max_count)
+{
+    size_t match_idx = matches[0];
+    size_t count = 0;
+
+    while ((match_idx != STR_NPOS) && (count != max_count)) {
+        if (count < cap) {
+            matches[count] = match_idx;
+        }
+        count += 1;
+
+        const size_t read_idx = match_idx + pattern->len;
+        match_idx = __str_find_pattern(src + read_idx, len - read_idx, pattern);
+        if (match_idx != STR_NPOS) {
+            match_idx += read_idx;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Copies the characters replacing up to @c max_count pattern occurrences
+ * 
+ * Positions of the first @c known occurrences are taken from @c matches ,
+ * the following ones are searched.
+ * 
+ * @c dst may overlap @c src as long as writing never overtakes reading:
+ * either @c dst equals @c src and the replacement is not longer than the pattern,
+ * or @c src is shifted forward by the total growth of the result.
+ * 
+ * @return Length of the result
+ */
+static size_t __str_replace_fill(char* dst, const char* src, size_t len, const struct __str_pattern* pattern,
+                                 const char* replacement, size_t replacement_len,
+                                 const size_t* matches, size_t known, size_t max_count)
+{
+    size_t read_idx = 0;
+    size_t write_idx = 0;
+    size_t count = 0;
+
+    while (count != max_count) {
+        size_t match_idx = STR_NPOS;
+
+        if (count < known) {
+            match_idx = matches[count];
+        } else {
+            match_idx = __str_find_pattern(src + read_idx, len - read_idx, pattern);
+            if (match_idx == STR_NPOS) {
+                break;
+            }
+            match_idx += read_idx;
+        }
+
+        const size_t chunk_len = match_idx - read_idx;
+
+        if (dst + write_idx != src + read_idx) {
+            memmove(dst + write_idx, src + read_idx, chunk_len);
+        }
+        write_idx += chunk_len;
+
+        __simd_ascii_copy(dst + write_idx, replacement, replacement_len);
+        write_idx += replacement_len;
+        read_idx = match_idx + pattern->len;
+        count += 1;
+    }
+
+    if (dst + write_idx != src + read_idx) {
+        memmove(dst + write_idx, src + read_idx, len - read_idx);
+    }
+    write_idx += len - read_idx;
+
+    return write_idx;
+}
+
+/**
+ * @brief Replaces up to @c max_count pattern occurrences
+ * 
+ * Occurrences are replaced in place if the result fits the buffer,
+ * otherwise they are counted first and the result is written
+ * to a single buffer of the exact size.
+ */
+static int __str_replace_n(str_t* self, const struct __str_pattern* pattern,
+                           const char* replacement, size_t max_count)
+{
+    if ((self == NULL) || (pattern == NULL)) {
+        return USTRING_ERR;
+    }
+
+    __str_hash_invalidate(self);
+
+    if ((self->len == 0) || (pattern->len == 0) || (max_count == 0)) {
+        return USTRING_OK;
+    }
+
+    size_t matches[STR_REPLACE_STACK_MATCHES];
+    matches[0] = __str_find_pattern(self->buffer, self->len, pattern);
+    if (matches[0] == STR_NPOS) {
+        return USTRING_OK;
+    }
+
+    /* Pattern and replacement may point into own buffer, which is moved when made unique */
+    const uintptr_t buffer_addr = (uintptr_t) self->buffer;
+    const uintptr_t pattern_offset = (uintptr_t) pattern->needle - buffer_addr;
+    const uintptr_t replacement_offset = (uintptr_t) replacement - buffer_addr;
+    const bool pattern_self = ((uintptr_t) pattern->needle >= buffer_addr) && (pattern_offset < self->len);
+    const bool replacement_self = (replacement != NULL)
+        && ((uintptr_t) replacement >= buffer_addr) && (replacement_offset < self->len);
+
+    if (!__str_make_unique(self)) {
+        return USTRING_ERR;
+    }
+
+    struct __str_pattern own_pattern = *pattern;
+    if (pattern_self) {
+        own_pattern.needle = self->buffer + pattern_offset;
+    }
+
+    if (replacement_self) {
+        replacement = self->buffer + replacement_offset;
+    }
+
+    /* Own characters are overwritten in place, so aliasing arguments require a new buffer */
+    const bool in_place = !pattern_self && !replacement_self;
+    const size_t replacement_len = __str_literal_len(replacement);
+
+    if (in_place && (replacement_len <= pattern->len)) {
+        self->len = __str_replace_fill(self->buffer, self->buffer, self->len, &own_pattern,
+                                       replacement, replacement_len, matches, 1, max_count);
+        self->buffer[self->len] = '\0';
+
+        return USTRING_OK;
+    }
+
+    const size_t count = __str_replace_count(self->buffer, self->len, &own_pattern,
+                                             matches, STR_REPLACE_STACK_MATCHES, max_count);
+    const size_t known = (count < STR_REPLACE_STACK_MATCHES) ? count : STR_REPLACE_STACK_MATCHES;
+    if ((replacement_len > pattern->len)
+        && (count > (SIZE_MAX - self->len - 1) / (replacement_len - pattern->len)))
+    {
+        return USTRING_ERR;
+    }
+
+    const size_t new_len = self->len - count * pattern->len + count * replacement_len;
+
+    if (in_place && (new_len < self->cap)) {
+        /* Move the string to the end of the buffer, so writing from the start never overtakes reading */
+        const size_t shift = new_len - self->len;
+        memmove(self->buffer + shift, self->buffer, self->len);
+
+        __str_replace_fill(self->buffer, self->buffer + shift, self->len, &own_pattern,
+                           replacement, replacement_len, matches, known, count);
+        self->buffer[new_len] = '\0';
+        self->len = new_len;
+
+        return USTRING_OK;
+    }
+
+    char* new_buffer = __ustring_malloc(self->allocator, (new_len + 1) * sizeof(char));
+    if (new_buffer == NULL) {
+        return USTRING_ERR;
+    }
+
+    __str_replace_fill(new_buffer, self->buffer, self->len, &own_pattern,
+                       replacement, replacement_len, matches, known, count);
+    new_buffer[new_len] = '\0';
+
+    if (!__str_is_inline(self)) {
+        __ustring_free(self->allocator, self->buffer);
+    }
+
+    self->buffer = new_buffer;
+    self->cap = new_len + 1;
+    self->len = new_len;
+
+    return USTRING_OK;
+}
+
+str_t* str_new(const char* string) {
+    return str_new_alloc(NULL, string);
+}
+
+str_t* str_new_in(ustring_arena_t* arena, const char* string) {
+    return str_new_alloc(ustring_arena_allocator(arena), string);
+}
+
+str_t* str_new_alloc(const ustring_allocator_t* allocator, const char* string) {
+    if (string == NULL) {
+        return str_with_capacity_alloc(allocator, STR_DEFAULT_CAPACITY);
+    }
+
+    return str_from_view_alloc(allocator, str_view_from_parts(string, __str_literal_len(string)));
+}
+
+str_t* str_from_view(str_view_t view) {
+    return str_from_view_alloc(NULL, view);
+}
+
+str_t* str_from_view_in(ustring_arena_t* arena, str_view_t view) {
+    return str_from_view_alloc(ustring_arena_allocator(arena), view);
+}
+
+str_t* str_from_view_alloc(const ustring_allocator_t* allocator, str_view_t view) {
+    size_t cap = STR_DEFAULT_CAPACITY;
+
+    while (view.len >= cap) {
+        cap *= 2;
+    }
+    
+    str_t* self = __str_alloc(allocator, cap);
+    if (self == NULL) {
         return NULL;
     }
 
-    self->buffer[0] = '\0';
+    if (view.len != 0) {
+        __simd_ascii_copy(self->buffer, view.ptr, view.len);
+    }
+    self->buffer[view.len] = '\0';
+    self->len = view.len;
 
     return self;
 }
 
+str_t* str_with_capacity(size_t capacity) {
+    return str_with_capacity_alloc(NULL, capacity);
+}
+
+str_t* str_with_capacity_in(ustring_arena_t* arena, size_t capacity) {
+    return str_with_capacity_alloc(ustring_arena_allocator(arena), capacity);
+}
+
+str_t* str_with_capacity_alloc(const ustring_allocator_t* allocator, size_t capacity) {
+    return __str_alloc(allocator, (capacity == 0) ? 1 : capacity);
+}
+
 str_t* str_copy(const str_t* other) {
+    return str_copy_alloc(NULL, other);
+}
+
+str_t* str_copy_in(ustring_arena_t* arena, const str_t* other) {
+    return str_copy_alloc(ustring_arena_allocator(arena), other);
+}
+
+str_t* str_copy_alloc(const ustring_allocator_t* allocator, const str_t* other) {
     if (other == NULL) {
-        return str_with_capacity(STR_DEFAULT_CAPACITY);
+        return str_with_capacity_alloc(allocator, STR_DEFAULT_CAPACITY);
     }
 
-    str_t* self = malloc(sizeof(str_t));
-    if (self == NULL) {
-        return NULL;
+    if (allocator == NULL) {
+        allocator = ustring_get_allocator();
     }
 
-    self->len = other->len;
-    self->cap = other->len + 1;
-    self->buffer = malloc(self->cap * sizeof(char));
-    if (self->buffer == NULL) {
-        free(self);
-        return NULL;
+    /* Shared characters are owned by all copies, only the header is allocated */
+    if ((other->shared != NULL) && (other->allocator == allocator)) {
+        str_t* self = __ustring_malloc(allocator, sizeof(str_t));
+        if (self == NULL) {
+            return NULL;
+        }
+
+        atomic_fetch_add_explicit(&other->shared->refs, 1, memory_order_relaxed);
+
+        self->buffer = other->buffer;
+        self->len = other->len;
+        self->cap = other->cap;
+        self->allocator = allocator;
+        self->shared = other->shared;
+        atomic_init(&self->hash, 0);
+        atomic_init(&self->hashed, false);
+
+        uint64_t hash = 0;
+        if (__str_hash_load(other, &hash)) {
+            __str_hash_store(self, hash);
+        }
+
+        return self;
     }
 
-    for (size_t i = 0; i < self->len; i++) {
-        self->buffer[i] = other->buffer[i];
+    str_t* self = __str_alloc(allocator, other->len + 1);
+    if (self == NULL) {
+        return NULL;
     }
-    self->buffer[self->len] = '\0';
+
+    memcpy(self->buffer, other->buffer, other->len);
+    self->buffer[other->len] = '\0';
+    self->len = other->len;
 
     return self;
 }
@@ -98,14 +425,50 @@ void str_drop(str_t** self) {
         return;
     }
 
-    if ((*self)->buffer != NULL) {
-        free((*self)->buffer);
+    const ustring_allocator_t* allocator = (*self)->allocator;
+
+    if ((*self)->shared != NULL) {
+        __str_shared_release(allocator, (*self)->shared);
+    } else if (!__str_is_inline(*self)) {
+        __ustring_free(allocator, (*self)->buffer);
     }
 
-    free(*self);
+    __ustring_free(allocator, *self);
     *self = NULL;
 }
 
+int str_make_shared(str_t* self) {
+    if (self == NULL) {
+        return USTRING_ERR;
+    }
+
+    if (self->shared != NULL) {
+        return USTRING_OK;
+    }
+
+    struct __str_shared* shared =
+        __ustring_malloc(self->allocator, sizeof(struct __str_shared) + self->cap * sizeof(char));
+    if (shared == NULL) {
+        return USTRING_ERR;
+    }
+
+    atomic_init(&shared->refs, 1);
+    memcpy(shared->data, self->buffer, self->len + 1);
+
+    if (!__str_is_inline(self)) {
+        __ustring_free(self->allocator, self->buffer);
+    }
+
+    self->buffer = shared->data;
+    self->shared = shared;
+
+    return USTRING_OK;
+}
+
+bool str_is_shared(const str_t* self) {
+    return (self != NULL) && (self->shared != NULL);
+}
+
 size_t str_len(const str_t* self) {
     return (self != NULL) ? self->len : 0;
 }
@@ -127,7 +490,7 @@ char str_at(const str_t* self, const size_t pos) {
 }
 
 const char* str_as_ptr(const str_t* self) {
-    return (self->cap == 0) ? NULL : self->buffer; 
+    return (self != NULL) ? self->buffer : NULL;
 }
 
 str_t* str_append(str_t* self, const char* string) {
@@ -137,56 +500,30 @@ str_t* str_append(str_t* self, const char* string) {
         return self;
     }
 
-    const bool append_self = (string == self->buffer);
-    char* buffer_copy = NULL;
-
-    if (append_self) {
-        char* buffer_copy = malloc((string_len + 1) + sizeof(char));
-        if (buffer_copy == NULL) {
-            return NULL;
-        }
+    __str_hash_invalidate(self);
 
-        for (size_t i = 0; i < string_len; i++) {
-            buffer_copy[i] = string[i];
-        }
-        buffer_copy[string_len] = '\0';
-        string = buffer_copy;
-    }
+    /* String may point into own buffer, which can be moved by reallocation */
+    const uintptr_t string_addr = (uintptr_t) string;
+    const uintptr_t buffer_addr = (uintptr_t) self->buffer;
+    const bool append_self =
+        (string_addr >= buffer_addr) && (string_addr < (buffer_addr + self->len));
+    const size_t self_offset = string_addr - buffer_addr;
 
     const size_t new_len = self->len + string_len;
 
-    if (new_len >= self->cap) {
-        while (new_len >= self->cap) {
-            self->cap *= 2;
-        }
-
-        char* new_buffer = NULL;
-        if (self->buffer != NULL) {
-            new_buffer = realloc(self->buffer, self->cap * sizeof(char));
-        } else {
-            new_buffer = malloc(self->cap * sizeof(char));
-        }
-
-        if (new_buffer == NULL) {
-            if (append_self) {
-                free(buffer_copy);
-            }
-            return NULL;
-        } else {
-            self->buffer = new_buffer;
-        }
+    if (!__str_make_unique(self) || !__str_reserve(self, new_len)) {
+        return NULL;
     }
 
-    for (size_t i = 0; i < string_len; i++) {
-        self->buffer[self->len + i] = __is_ascii(string[i]) ? string[i] : '?';
+    if (append_self) {
+        /* Own characters are valid ASCII and do not overlap the appended part */
+        memcpy(self->buffer + self->len, self->buffer + self_offset, string_len);
+    } else {
+        __simd_ascii_copy(self->buffer + self->len, string, string_len);
     }
     self->buffer[new_len] = '\0';
     self->len = new_len;
 
-    if (append_self) {
-        free(buffer_copy);
-    }
-
     return self;
 }
 
@@ -195,6 +532,29 @@ int str_clear(str_t* self) {
         return USTRING_ERR;
     }
 
+    __str_hash_invalidate(self);
+
+    struct __str_shared* shared = self->shared;
+
+    if (shared != NULL) {
+        /* Characters are dropped, so the shared ones are never copied */
+        if (atomic_load_explicit(&shared->refs, memory_order_acquire) == 1) {
+            self->buffer = (char*) shared;
+        } else {
+            const size_t new_cap = (self->cap < STR_DEFAULT_CAPACITY) ? self->cap : STR_DEFAULT_CAPACITY;
+            char* new_buffer = __ustring_malloc(self->allocator, new_cap * sizeof(char));
+            if (new_buffer == NULL) {
+                return USTRING_ERR;
+            }
+
+            self->buffer = new_buffer;
+            self->cap = new_cap;
+            __str_shared_release(self->allocator, shared);
+        }
+
+        self->shared = NULL;
+    }
+
     self->len = 0;
     if (self->cap != 0) {
         self->buffer[0] = '\0';
@@ -204,6 +564,14 @@ int str_clear(str_t* self) {
 }
 
 str_t* str_concat(const str_t* str_a, const str_t* str_b) {
+    return str_concat_alloc(NULL, str_a, str_b);
+}
+
+str_t* str_concat_in(ustring_arena_t* arena, const str_t* str_a, const str_t* str_b) {
+    return str_concat_alloc(ustring_arena_allocator(arena), str_a, str_b);
+}
+
+str_t* str_concat_alloc(const ustring_allocator_t* allocator, const str_t* str_a, const str_t* str_b) {
     const bool is_null_a = str_a == NULL;
     const bool is_null_b = str_b == NULL;
     const bool is_empty_a = is_null_a || (str_a->len == 0);
@@ -212,17 +580,17 @@ str_t* str_concat(const str_t* str_a, const str_t* str_b) {
     /* Case: */
     /* a) Both strings are NULL or empty */
     if ((is_null_a && is_null_b) || (is_empty_a && is_empty_b)) {
-        return str_with_capacity(STR_DEFAULT_CAPACITY);
+        return str_with_capacity_alloc(allocator, STR_DEFAULT_CAPACITY);
     }
 
     /* b) String A normal & other is NULL or empty */
     if ((!is_null_a && !is_empty_a) && (is_null_b || is_empty_b)) {
-        return str_copy(str_a);
+        return str_copy_alloc(allocator, str_a);
     }
 
     /* c) String A normal & other is NULL or empty */
     if ((!is_null_b && !is_empty_b) && (is_null_a || is_empty_a)) {
-        return str_copy(str_b);
+        return str_copy_alloc(allocator, str_b);
     }
 
     /* d) Both strings are normal */
@@ -233,28 +601,16 @@ str_t* str_concat(const str_t* str_a, const str_t* str_b) {
         cap *= 2;
     }
 
-    str_t* result_str = malloc(sizeof(str_t));
+    str_t* result_str = __str_alloc(allocator, cap);
     if (result_str == NULL) {
         return NULL;
     }
 
-    result_str->len = len;
-    result_str->cap = cap;
-    result_str->buffer = malloc(result_str->cap * sizeof(char));
-    if (result_str->buffer == NULL) {
-        free(result_str);
-        return NULL;
-    }
-
-    for (size_t i = 0; i < str_a->len; i++) {
-        result_str->buffer[i] = str_a->buffer[i];
-    }
-
-    for (size_t i = 0; i < str_b->len; i++) {
-        result_str->buffer[str_a->len + i] = str_b->buffer[i];
-    }
+    memcpy(result_str->buffer, str_a->buffer, str_a->len);
+    memcpy(result_str->buffer + str_a->len, str_b->buffer, str_b->len);
 
-    result_str->buffer[result_str->len] = '\0';
+    result_str->buffer[len] = '\0';
+    result_str->len = len;
 
     return result_str;
 }
@@ -264,32 +620,30 @@ int str_trim(str_t* self) {
         return USTRING_ERR;
     }
 
-    if (self->len == 0) {
-        return USTRING_OK;
-    }
+    __str_hash_invalidate(self);
 
-    const char* front_ptr = self->buffer;
-    const char* back_ptr = self->buffer + self->len;
+    size_t start_idx = 0;
+    size_t end_idx = self->len;
 
-    while ((front_ptr != back_ptr) && __is_blank(*front_ptr)) {
-        front_ptr += 1;
+    while ((start_idx != end_idx) && __is_blank(self->buffer[start_idx])) {
+        start_idx += 1;
     }
 
-    while ((back_ptr != front_ptr) && __is_blank(*(back_ptr - 1))) {
-        back_ptr -= 1;
+    while ((end_idx != start_idx) && __is_blank(self->buffer[end_idx - 1])) {
+        end_idx -= 1;
     }
 
-    const size_t new_len = back_ptr - front_ptr;
+    const size_t new_len = end_idx - start_idx;
 
-    if ((new_len != 0) && (front_ptr != self->buffer)) {
-        size_t position = 0;
-        while (front_ptr != back_ptr) {
-            self->buffer[position] = *front_ptr;
-            front_ptr += 1;
-            position += 1;
-        }   
+    if (new_len == self->len) {
+        return USTRING_OK;
     }
-    
+
+    if (!__str_make_unique(self)) {
+        return USTRING_ERR;
+    }
+
+    memmove(self->buffer, self->buffer + start_idx, new_len);
     self->buffer[new_len] = '\0';
     self->len = new_len;
 
@@ -308,73 +662,81 @@ bool str_eq(const str_t* a, const str_t* b) {
         return false;
     }
 
-    for (size_t i = 0; i < a_len; i++) {
-        if (a->buffer[i] != b->buffer[i]) {
-            return false;
-        }
-    }
-    
-    return true;
-}
+    uint64_t a_hash = 0;
+    uint64_t b_hash = 0;
 
-int str_truncate(str_t* self, size_t len) {
-    if (self == NULL) {
-        return USTRING_ERR;
+    if (__str_hash_load(a, &a_hash) && __str_hash_load(b, &b_hash) && (a_hash != b_hash)) {
+        return false;
     }
 
-    if (self->len > len) {
-        self->buffer[len] = '\0';
-        self->len = len;
+    /* Same instance or copies sharing the characters */
+    if (a->buffer == b->buffer) {
+        return true;
     }
 
-    return USTRING_OK;
+    return __simd_mismatch(a->buffer, b->buffer, a_len) == a_len;
 }
 
-bool str_contains(const str_t* self, const char* pattern) {
-    if ((self == NULL) || (pattern == NULL)) {
-        return false;
+int str_cmp(const str_t* a, const str_t* b) {
+    return str_cmp_prefix(a, b, STR_NPOS);
+}
+
+int str_cmp_prefix(const str_t* a, const str_t* b, size_t len) {
+    if ((a == NULL) || (b == NULL)) {
+        return (a == b) ? 0 : ((a == NULL) ? -1 : 1);
     }
 
-    const size_t pattern_len = __str_literal_len(pattern);
+    const size_t a_len = (a->len < len) ? a->len : len;
+    const size_t b_len = (b->len < len) ? b->len : len;
+    const size_t common_len = (a_len < b_len) ? a_len : b_len;
+    const size_t idx = (a->buffer == b->buffer)
+        ? common_len
+        : __simd_mismatch(a->buffer, b->buffer, common_len);
 
-    if (self->len == 0) {
-        /* Empty string contains only empty pattern */
-        return pattern_len == 0;
-    } else if (pattern_len == 0) {
-        /* Non-empty string always contains empty pattern */
-        return true;
-    } else if (pattern_len > self->len) {
-        /* Pattern length can not exceed string length */
-        return false;
-    } else if (pattern_len == 1) {
-        /* If pattern is single character scan string */
-        const char pattern_ch = pattern[0];
-        for (size_t i = 0; i < self->len; i++) {
-            if (self->buffer[i] == pattern_ch) {
-                return true;
-            }
-        }
-        return false;
+    if (idx < common_len) {
+        return ((unsigned char) a->buffer[idx] < (unsigned char) b->buffer[idx]) ? -1 : 1;
     }
 
-    for (size_t i = 0; i < self->len; i++) {
-        if ((i + pattern_len) > self->len) {
-            return false;
-        }
+    return (a_len == b_len) ? 0 : ((a_len < b_len) ? -1 : 1);
+}
 
-        size_t matched_count = 0;
-        while ((matched_count < pattern_len)
-                    && (self->buffer[i + matched_count] == pattern[matched_count]))
-        {
-            matched_count += 1;
-        }
+int str_truncate(str_t* self, size_t len) {
+    if (self == NULL) {
+        return USTRING_ERR;
+    }
 
-        if (matched_count == pattern_len) {
-            return true;
-        }
+    __str_hash_invalidate(self);
+
+    if (self->len <= len) {
+        return USTRING_OK;
     }
 
-    return false;
+    if (!__str_make_unique(self)) {
+        return USTRING_ERR;
+    }
+
+    self->buffer[len] = '\0';
+    self->len = len;
+
+    return USTRING_OK;
+}
+
+bool str_contains(const str_t* self, const char* pattern) {
+    return str_find(self, pattern) != STR_NPOS;
+}
+
+size_t str_find(const str_t* self, const char* pattern) {
+    return str_find_from(self, pattern, 0);
+}
+
+size_t str_find_from(const str_t* self, const char* pattern, size_t from) {
+    if (pattern == NULL) {
+        return STR_NPOS;
+    }
+
+    const struct __str_pattern borrowed = __str_pattern_borrow(pattern, __str_literal_len(pattern));
+
+    return str_find_from_pat(self, &borrowed, from);
 }
 
 bool str_contains_fn(const str_t* self, bool (*fn) (char)) {
@@ -392,62 +754,30 @@ bool str_contains_fn(const str_t* self, bool (*fn) (char)) {
 }
 
 int str_trim_matches(str_t* self, const char* pattern) {
-    if ((self == NULL) || (pattern == NULL)) {
-        return USTRING_ERR;
-    }
+    return str_replace(self, pattern, NULL);
+}
 
-    if (self->len == 0) {
-        return USTRING_OK;
+int str_trim_matches_fn(str_t* self, bool (*fn) (char)) {
+    if ((self == NULL) || (fn == NULL)) {
+        return USTRING_ERR;
     }
 
-    const size_t pattern_len = __str_literal_len(pattern);
-
-    if ((pattern_len == 0) || (pattern_len > self->len)) {
-        return USTRING_OK;
-    }
+    __str_hash_invalidate(self);
 
-    /* Trim all occurrences of the pattern and shift string contents */
     size_t write_idx = 0;
-    size_t read_idx = 0;
-
-    while (read_idx < self->len) {
-        /* Check if pattern is present */
-        if ((read_idx + pattern_len) <= self->len) {
-            size_t matched_count = 0;
-            while ((matched_count < pattern_len)
-                        && (self->buffer[read_idx + matched_count] == pattern[matched_count]))
-            {
-                matched_count += 1;
-            }
-
-            if (matched_count == pattern_len) {
-                read_idx += pattern_len;
-                continue;
-            }
-        }
-
-        self->buffer[write_idx] = self->buffer[read_idx];
+    while ((write_idx < self->len) && !fn(self->buffer[write_idx])) {
         write_idx += 1;
-        read_idx += 1;
     }
 
-    self->buffer[write_idx] = '\0';
-    self->len = write_idx;
-
-    return USTRING_OK;
-}
-
-int str_trim_matches_fn(str_t* self, bool (*fn) (char)) {
-    if ((self == NULL) || (fn == NULL)) {
-        return USTRING_ERR;
+    if (write_idx == self->len) {
+        return USTRING_OK;
     }
 
-    if (self->len == 0) {
-        return USTRING_OK;
+    if (!__str_make_unique(self)) {
+        return USTRING_ERR;
     }
 
-    size_t write_idx = 0;
-    size_t read_idx = 0;
+    size_t read_idx = write_idx;
 
     while (read_idx < self->len) {
         if (!fn(self->buffer[read_idx])) {
@@ -465,38 +795,13 @@ int str_trim_matches_fn(str_t* self, bool (*fn) (char)) {
 }
 
 int str_trim_start_matches(str_t* self, const char* pattern) {
-    if ((self == NULL) || (pattern == NULL)) {
+    if (pattern == NULL) {
         return USTRING_ERR;
     }
 
-    if (self->len == 0) {
-        return USTRING_OK;
-    }
-
-    const size_t pattern_len = __str_literal_len(pattern);
-
-    if ((pattern_len == 0) || (pattern_len > self->len)) {
-        return USTRING_OK;
-    }
-
-    /* Check if string starts with pattern */
-    for (size_t i = 0; i < pattern_len; i++) {
-        if (self->buffer[i] != pattern[i]) {
-            return USTRING_OK;
-        }
-    }
-
-    const size_t new_len = self->len - pattern_len;
-
-    /* Shift rest of the string to the beginning */
-    for (size_t i = 0; i < new_len; i++) {
-        self->buffer[i] = self->buffer[i + pattern_len];
-    }
-
-    self->buffer[new_len] = '\0';
-    self->len = new_len;
+    const struct __str_pattern borrowed = __str_pattern_borrow(pattern, __str_literal_len(pattern));
 
-    return USTRING_OK;
+    return str_trim_start_matches_pat(self, &borrowed);
 }
 
 int str_trim_start_matches_fn(str_t* self, bool (*fn) (char)) {
@@ -504,9 +809,7 @@ int str_trim_start_matches_fn(str_t* self, bool (*fn) (char)) {
         return USTRING_ERR;
     }
 
-    if (self->len == 0) {
-        return USTRING_OK;
-    }
+    __str_hash_invalidate(self);
 
     size_t start_idx = 0;
     while ((start_idx < self->len) && fn(self->buffer[start_idx])) {
@@ -517,13 +820,14 @@ int str_trim_start_matches_fn(str_t* self, bool (*fn) (char)) {
         return USTRING_OK;
     }
 
+    if (!__str_make_unique(self)) {
+        return USTRING_ERR;
+    }
+
     const size_t new_len = self->len - start_idx;
 
     /* Shift rest of the string to the beginning */
-    for (size_t i = 0; i < new_len; i++) {
-        self->buffer[i] = self->buffer[start_idx + i];
-    }
-
+    memmove(self->buffer, self->buffer + start_idx, new_len);
     self->buffer[new_len] = '\0';
     self->len = new_len;
 
@@ -531,279 +835,411 @@ int str_trim_start_matches_fn(str_t* self, bool (*fn) (char)) {
 }
 
 int str_trim_end_matches(str_t* self, const char* pattern) {
-    if ((self == NULL) || (pattern == NULL)) {
+    if (pattern == NULL) {
         return USTRING_ERR;
     }
 
-    if (self->len == 0) {
-        return USTRING_OK;
+    const struct __str_pattern borrowed = __str_pattern_borrow(pattern, __str_literal_len(pattern));
+
+    return str_trim_end_matches_pat(self, &borrowed);
+}
+
+int str_trim_end_matches_fn(str_t* self, bool (*fn) (char)) {
+    if ((self == NULL) || (fn == NULL)) {
+        return USTRING_ERR;
     }
 
-    const size_t pattern_len = __str_literal_len(pattern);
+    __str_hash_invalidate(self);
 
-    if ((pattern_len == 0) || (pattern_len > self->len)) {
-        return USTRING_OK;
+    size_t match_start_idx = self->len;
+    while ((match_start_idx > 0) && fn(self->buffer[match_start_idx - 1])) {
+        match_start_idx -= 1;
     }
 
-    const size_t match_start_idx = self->len - pattern_len;
+    if (match_start_idx == self->len) {
+        return USTRING_OK;
+    }
 
-    /* Check if string ends with pattern */
-    for (size_t i = 0; i < pattern_len; i++) {
-        if (self->buffer[match_start_idx + i] != pattern[i]) {
-            return USTRING_OK;
-        }
+    if (!__str_make_unique(self)) {
+        return USTRING_ERR;
     }
-    
-    /* Truncate matched suffix */
+
     self->buffer[match_start_idx] = '\0';
     self->len = match_start_idx;
 
     return USTRING_OK;
 }
 
-int str_trim_end_matches_fn(str_t* self, bool (*fn) (char)) {
-    if ((self == NULL) || (fn == NULL)) {
+int str_replace(str_t* self, const char* pattern, const char* replacement) {
+    return str_replacen(self, pattern, replacement, SIZE_MAX);
+}
+
+int str_replacen(str_t* self, const char* pattern, const char* replacement, size_t count) {
+    if (pattern == NULL) {
         return USTRING_ERR;
     }
 
-    if (self->len == 0) {
+    const struct __str_pattern borrowed = __str_pattern_borrow(pattern, __str_literal_len(pattern));
+
+    return __str_replace_n(self, &borrowed, replacement, count);
+}
+
+int str_shrink_to_fit(str_t* self) {
+    if (self == NULL) {
+        return USTRING_ERR;
+    }
+
+    /* Inline buffer can not be shrunk without moving the string header */
+    if (__str_is_inline(self) || (self->shared != NULL)) {
         return USTRING_OK;
     }
 
-    size_t match_start_idx = self->len;
-    while ((match_start_idx > 0) && fn(self->buffer[match_start_idx - 1])) {
-        match_start_idx -= 1;
+    const size_t new_cap = self->len + 1;
+
+    char* new_buffer = __ustring_realloc(self->allocator, self->buffer, self->cap, new_cap * sizeof(char));
+    if (new_buffer == NULL) {
+        return USTRING_ERR;
     }
 
-    self->buffer[match_start_idx] = '\0';
-    self->len = match_start_idx;
+    self->buffer = new_buffer;
+    self->cap = new_cap;
 
     return USTRING_OK;
 }
 
-int str_replace(str_t* self, const char* pattern, const char* replacement) {
-    if ((self == NULL) || (pattern == NULL)) {
-        return USTRING_ERR;
+bool str_starts_with(const str_t* self, const char* pattern) {
+    if (pattern == NULL) {
+        return false;
     }
 
-    if (self->len == 0) {
-        return USTRING_OK;
+    const struct __str_pattern borrowed = __str_pattern_borrow(pattern, __str_literal_len(pattern));
+
+    return str_starts_with_pat(self, &borrowed);
+}
+
+bool str_ends_with(const str_t* self, const char* pattern) {
+    if (pattern == NULL) {
+        return false;
     }
 
-    const size_t pattern_len = __str_literal_len(pattern);
-    if ((pattern_len == 0) || !str_contains(self, pattern)) {
-        return USTRING_OK;
+    const struct __str_pattern borrowed = __str_pattern_borrow(pattern, __str_literal_len(pattern));
+
+    return str_ends_with_pat(self, &borrowed);
+}
+
+int str_to_lowercase(str_t* self) {
+    return __str_case_convert(self, false);
+}
+
+int str_to_uppercase(str_t* self) {
+    return __str_case_convert(self, true);
+}
+
+bool str_eq_ignore_case(const str_t* a, const str_t* b) {
+    if ((a == NULL) || (b == NULL) || (a->len != b->len)) {
+        return false;
     }
 
-    const size_t replacement_len = __str_literal_len(replacement);
-    if (replacement_len == 0) {
-        return str_trim_matches(self, pattern);
+    return __simd_mismatch_ignore_case(a->buffer, b->buffer, a->len) == a->len;
+}
+
+int str_cmp_ignore_case(const str_t* a, const str_t* b) {
+    if ((a == NULL) || (b == NULL)) {
+        return (a == b) ? 0 : ((a == NULL) ? -1 : 1);
     }
 
-    /* Normalize replacement string */
-    char replacement_norm[replacement_len + 1];
-    for (size_t i = 0; i < replacement_len; i++) {
-        replacement_norm[i] = __is_ascii(replacement[i]) ? replacement[i] : '?';
+    const size_t len = (a->len < b->len) ? a->len : b->len;
+    const size_t idx = __simd_mismatch_ignore_case(a->buffer, b->buffer, len);
+
+    if (idx < len) {
+        const unsigned char a_ch = (unsigned char) __to_lower(a->buffer[idx]);
+        const unsigned char b_ch = (unsigned char) __to_lower(b->buffer[idx]);
+        return (a_ch < b_ch) ? -1 : 1;
     }
-    replacement_norm[replacement_len] = '\0';
 
-    /* Create new string buffer */
-    size_t new_cap = self->cap;
-    char* new_buffer = malloc(new_cap * sizeof(char));
-    if (new_buffer == NULL) {
-        return USTRING_ERR;
+    return (a->len == b->len) ? 0 : ((a->len < b->len) ? -1 : 1);
+}
+
+bool str_contains_ignore_case(const str_t* self, const char* pattern) {
+    if ((self == NULL) || (pattern == NULL)) {
+        return false;
     }
 
-    size_t read_idx = 0;
-    size_t write_idx = 0;
-    while (read_idx < self->len) {
-        /* Detect pattern */
-        bool is_replacement = false;
-        if (read_idx + pattern_len <= self->len) {
-            size_t matched_count = 0;
-            while ((matched_count < pattern_len)
-                        && (self->buffer[read_idx + matched_count] == pattern[matched_count]))
-            {
-                matched_count += 1;
-            }
+    const size_t pattern_len = __str_literal_len(pattern);
 
-            if (matched_count == pattern_len) {
-                is_replacement = true;
-                read_idx += pattern_len;
-            }
-        }
+    if (pattern_len == 0) {
+        return true;
+    }
 
-        if (is_replacement) {
-            /* Write replacement to the buffer */
-            const size_t current_len = write_idx + replacement_len;
-
-            if (current_len >= new_cap) {
-                while (current_len >= new_cap) {
-                    new_cap *= 2;
-                }
-
-                char* expanded_new_buffer = realloc(new_buffer, new_cap * sizeof(char));
-                if (expanded_new_buffer == NULL) {
-                    free(new_buffer);
-                    return false;
-                } else {
-                    new_buffer = expanded_new_buffer;
-                }
-            }
+    return __simd_find_substr_ignore_case(self->buffer, self->len, pattern, pattern_len) != NULL;
+}
 
-            for (size_t i = 0; i < replacement_len; i++) {
-                new_buffer[write_idx + i] = replacement_norm[i];
-            }
+bool str_starts_with_ignore_case(const str_t* self, const char* pattern) {
+    if ((self == NULL) || (pattern == NULL)) {
+        return false;
+    }
 
-            write_idx += replacement_len;
-        } else {
-            /* Write character to the buffer */
-            if (write_idx == new_cap) {
-                new_cap *= 2;
-                char* expanded_new_buffer = realloc(new_buffer, sizeof(char) * new_cap);
-                if (expanded_new_buffer == NULL) {
-                    free(new_buffer);
-                    return USTRING_ERR;
-                } else {
-                    new_buffer = expanded_new_buffer;
-                }
-            }
+    const size_t pattern_len = __str_literal_len(pattern);
 
-            new_buffer[write_idx] = self->buffer[read_idx];
-            write_idx += 1;
-            read_idx += 1;
-        }
+    if (pattern_len > self->len) {
+        return false;
     }
 
-    new_buffer[write_idx] = '\0';
+    return __simd_mismatch_ignore_case(self->buffer, pattern, pattern_len) == pattern_len;
+}
 
-    free(self->buffer);
+/* Compiled pattern */
 
-    self->buffer = new_buffer;
-    self->cap = new_cap;
-    self->len = write_idx;
+bool str_contains_pat(const str_t* self, const str_pattern_t* pattern) {
+    return str_find_from_pat(self, pattern, 0) != STR_NPOS;
+}
 
-    return USTRING_OK;
+size_t str_find_pat(const str_t* self, const str_pattern_t* pattern) {
+    return str_find_from_pat(self, pattern, 0);
 }
 
-int str_shrink_to_fit(str_t* self) {
-    if (self == NULL) {
+size_t str_find_from_pat(const str_t* self, const str_pattern_t* pattern, size_t from) {
+    if ((self == NULL) || (pattern == NULL) || (from > self->len)) {
+        return STR_NPOS;
+    }
+
+    const size_t idx = __str_find_pattern(self->buffer + from, self->len - from, pattern);
+
+    return (idx != STR_NPOS) ? from + idx : STR_NPOS;
+}
+
+bool str_starts_with_pat(const str_t* self, const str_pattern_t* pattern) {
+    if ((self == NULL) || (pattern == NULL)) {
+        return false;
+    }
+
+    return (pattern->len <= self->len) && (memcmp(self->buffer, pattern->needle, pattern->len) == 0);
+}
+
+bool str_ends_with_pat(const str_t* self, const str_pattern_t* pattern) {
+    if ((self == NULL) || (pattern == NULL)) {
+        return false;
+    }
+
+    return (pattern->len <= self->len)
+        && (memcmp(self->buffer + self->len - pattern->len, pattern->needle, pattern->len) == 0);
+}
+
+int str_trim_matches_pat(str_t* self, const str_pattern_t* pattern) {
+    return __str_replace_n(self, pattern, NULL, SIZE_MAX);
+}
+
+int str_trim_start_matches_pat(str_t* self, const str_pattern_t* pattern) {
+    if ((self == NULL) || (pattern == NULL)) {
         return USTRING_ERR;
     }
 
-    if (self->cap == 0) {
+    __str_hash_invalidate(self);
+
+    if ((pattern->len == 0) || !str_starts_with_pat(self, pattern)) {
         return USTRING_OK;
     }
 
-    char* new_buffer = realloc(self->buffer, (self->len + 1) * sizeof(char));
-    if (new_buffer == NULL) {
+    const size_t new_len = self->len - pattern->len;
+
+    if (!__str_make_unique(self)) {
         return USTRING_ERR;
-    } else {
-        self->buffer = new_buffer;
     }
 
+    memmove(self->buffer, self->buffer + pattern->len, new_len);
+    self->buffer[new_len] = '\0';
+    self->len = new_len;
+
     return USTRING_OK;
 }
 
-bool str_starts_with(const str_t* self, const char* pattern) {
+int str_trim_end_matches_pat(str_t* self, const str_pattern_t* pattern) {
     if ((self == NULL) || (pattern == NULL)) {
-        return false;
+        return USTRING_ERR;
     }
 
-    const size_t pattern_len = __str_literal_len(pattern);
+    __str_hash_invalidate(self);
 
-    if (self->len == 0) {
-        /* Empty string starts only with empty pattern */
-        return pattern_len == 0;
-    } else if (pattern_len == 0) {
-        /* Non-empty string always starts with empty pattern */
-        return true;
-    } else if (pattern_len > self->len) {
-        /* Pattern length can not exceed string length */
-        return false;
+    if ((pattern->len == 0) || !str_ends_with_pat(self, pattern)) {
+        return USTRING_OK;
     }
 
-    for (size_t i = 0; i < pattern_len; i++) {
-        if (self->buffer[i] != pattern[i]) {
-            return false;
-        }
+    const size_t new_len = self->len - pattern->len;
+
+    if (!__str_make_unique(self)) {
+        return USTRING_ERR;
     }
 
-    return true;
+    self->buffer[new_len] = '\0';
+    self->len = new_len;
+
+    return USTRING_OK;
 }
 
-bool str_ends_with(const str_t* self, const char* pattern) {
-    if ((self == NULL) || (pattern == NULL)) {
+int str_replace_pat(str_t* self, const str_pattern_t* pattern, const char* replacement) {
+    return __str_replace_n(self, pattern, replacement, SIZE_MAX);
+}
+
+int str_replacen_pat(str_t* self, const str_pattern_t* pattern, const char* replacement, size_t count) {
+    return __str_replace_n(self, pattern, replacement, count);
+}
+
+/* Character set */
+
+bool str_contains_set(const str_t* self, const str_charset_t* set) {
+    if ((self == NULL) || (set == NULL)) {
         return false;
     }
 
-    const size_t pattern_len = __str_literal_len(pattern);
+    return __str_class_cspan(set, self->buffer, self->len) != self->len;
+}
 
-    if (self->len == 0) {
-        /* Empty string ends only with empty pattern */
-        return pattern_len == 0;
-    } else if (pattern_len == 0) {
-        /* Non-empty string always ends with empty pattern */
-        return true;
-    } else if (pattern_len > self->len) {
-        /* Pattern length can not exceed string length */
-        return false;
+int str_trim_matches_set(str_t* self, const str_charset_t* set) {
+    if ((self == NULL) || (set == NULL)) {
+        return USTRING_ERR;
     }
 
-    const size_t pattern_start_idx = self->len - pattern_len;
+    __str_hash_invalidate(self);
 
-    for (size_t i = 0; i < pattern_len; i++) {
-        if (self->buffer[pattern_start_idx + i] != pattern[i]) {
-            return false;
-        }
+    size_t write_idx = __str_class_cspan(set, self->buffer, self->len);
+
+    if (write_idx == self->len) {
+        return USTRING_OK;
     }
 
-    return true;
+    if (!__str_make_unique(self)) {
+        return USTRING_ERR;
+    }
+
+    /* Every character is written, the write position advances only past the kept ones */
+    for (size_t read_idx = write_idx; read_idx < self->len; read_idx++) {
+        const char ch = self->buffer[read_idx];
+        self->buffer[write_idx] = ch;
+        write_idx += !__str_class_contains(set, ch);
+    }
+
+    self->buffer[write_idx] = '\0';
+    self->len = write_idx;
+
+    return USTRING_OK;
 }
 
-int str_to_lowercase(str_t* self) {
-    if (self == NULL) {
+int str_trim_start_matches_set(str_t* self, const str_charset_t* set) {
+    if ((self == NULL) || (set == NULL)) {
         return USTRING_ERR;
     }
 
-    if (self->len == 0) {
+    __str_hash_invalidate(self);
+
+    const size_t start_idx = __str_class_span(set, self->buffer, self->len);
+
+    if (start_idx == 0) {
         return USTRING_OK;
     }
 
-    for (size_t i = 0; i < self->len; i++) {
-        self->buffer[i] = __to_lower(self->buffer[i]);
+    if (!__str_make_unique(self)) {
+        return USTRING_ERR;
     }
 
+    const size_t new_len = self->len - start_idx;
+
+    memmove(self->buffer, self->buffer + start_idx, new_len);
+    self->buffer[new_len] = '\0';
+    self->len = new_len;
+
     return USTRING_OK;
 }
 
-int str_to_uppercase(str_t* self) {
-    if (self == NULL) {
+int str_trim_end_matches_set(str_t* self, const str_charset_t* set) {
+    if ((self == NULL) || (set == NULL)) {
         return USTRING_ERR;
     }
 
-    if (self->len == 0) {
+    __str_hash_invalidate(self);
+
+    size_t new_len = self->len;
+
+    while ((new_len > 0) && __str_class_contains(set, self->buffer[new_len - 1])) {
+        new_len -= 1;
+    }
+
+    if (new_len == self->len) {
         return USTRING_OK;
     }
 
-    for (size_t i = 0; i < self->len; i++) {
-        self->buffer[i] = __to_upper(self->buffer[i]);
+    if (!__str_make_unique(self)) {
+        return USTRING_ERR;
     }
 
+    self->buffer[new_len] = '\0';
+    self->len = new_len;
+
     return USTRING_OK;
 }
 
+bool __str_make_unique(str_t* self) {
+    struct __str_shared* shared = self->shared;
+
+    if (shared == NULL) {
+        return true;
+    }
+
+    if (atomic_load_explicit(&shared->refs, memory_order_acquire) == 1) {
+        /* Sole owner: block becomes a plain heap buffer of at least the same capacity */
+        memmove(shared, self->buffer, self->len + 1);
+        self->buffer = (char*) shared;
+    } else {
+        char* new_buffer = __ustring_malloc(self->allocator, self->cap * sizeof(char));
+        if (new_buffer == NULL) {
+            return false;
+        }
+
+        memcpy(new_buffer, self->buffer, self->len + 1);
+        self->buffer = new_buffer;
+        __str_shared_release(self->allocator, shared);
+    }
+
+    self->shared = NULL;
+
+    return true;
+}
+
+bool __str_reserve(str_t* self, size_t len) {
+    if (len < self->cap) {
+        return true;
+    }
+
+    size_t new_cap = self->cap;
+    while (len >= new_cap) {
+        new_cap *= 2;
+    }
+
+    char* new_buffer = NULL;
+    if (__str_is_inline(self)) {
+        new_buffer = __ustring_malloc(self->allocator, new_cap * sizeof(char));
+        if (new_buffer != NULL) {
+            memcpy(new_buffer, self->buffer, self->len + 1);
+        }
+    } else {
+        new_buffer = __ustring_realloc(self->allocator, self->buffer, self->cap, new_cap * sizeof(char));
+    }
+
+    if (new_buffer == NULL) {
+        return false;
+    }
+
+    self->buffer = new_buffer;
+    self->cap = new_cap;
+
+    return true;
+}
+
 size_t __str_literal_len(const char* string) {
     if ((string == NULL) || (*string == '\0')) {
         return 0;
     }
 
-    size_t len = 0;
-    while (*(string + len) != '\0') {
-        len++;
-    }
-    
-    return len;
+    return __simd_strlen(string);
 }
 
 bool __str_literal_contains(const char* string, char ch) {
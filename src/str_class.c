@@ -0,0 +1,203 @@
+/**************************************************************************//**
+ *
+ * @file    str_class.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ *****************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+#include <ustring/str_charset.h>
+#include "str_class_p.h"
+#include "str_simd_p.h"
+
+/* Runs shorter than this are usually found by the scalar scan alone */
+#define STR_CLASS_SCALAR_PROBE ((size_t) 4)
+
+/*
+ * Class members are grouped by their high nibble. Each group is described
+ * by the set of low nibbles of its members, every distinct set gets its own
+ * bit in the nibble tables. Eight bits allow up to eight distinct sets,
+ * which covers delimiters like whitespace, punctuation or digit ranges.
+ */
+static void __str_class_init_nibbles(__str_class_t* self) {
+    uint16_t lo_sets[16] = {0};
+    uint16_t distinct_sets[8] = {0};
+    size_t distinct_count = 0;
+
+    for (size_t ch = 0; ch < 256; ch++) {
+        if (__str_class_contains(self, ch)) {
+            lo_sets[ch >> 4] |= (uint16_t) (1u << (ch & 0x0F));
+        }
+    }
+
+    self->vectorized = false;
+    memset(self->lo_nibble, 0, sizeof(self->lo_nibble));
+    memset(self->hi_nibble, 0, sizeof(self->hi_nibble));
+
+    for (size_t hi = 0; hi < 16; hi++) {
+        if (lo_sets[hi] == 0) {
+            continue;
+        }
+
+        size_t bit = 0;
+        while ((bit < distinct_count) && (distinct_sets[bit] != lo_sets[hi])) {
+            bit += 1;
+        }
+
+        if (bit == distinct_count) {
+            if (distinct_count == 8) {
+                return;
+            }
+
+            distinct_sets[distinct_count] = lo_sets[hi];
+            distinct_count += 1;
+
+            for (size_t lo = 0; lo < 16; lo++) {
+                if ((lo_sets[hi] >> lo) & 1) {
+                    self->lo_nibble[lo] |= (unsigned char) (1u << bit);
+                }
+            }
+        }
+
+        self->hi_nibble[hi] = (unsigned char) (1u << bit);
+    }
+
+    self->vectorized = true;
+}
+
+void __str_class_init(__str_class_t* self, const char* chars) {
+    memset(self->bitmap, 0, sizeof(self->bitmap));
+
+    if (chars != NULL) {
+        for (const unsigned char* ch = (const unsigned char*) chars; *ch != '\0'; ch++) {
+            self->bitmap[*ch >> 3] |= (unsigned char) (1u << (*ch & 7));
+        }
+    }
+
+    __str_class_init_nibbles(self);
+}
+
+static void __str_class_add_range(__str_class_t* self, unsigned char first, unsigned char last) {
+    for (size_t ch = first; ch <= last; ch++) {
+        self->bitmap[ch >> 3] |= (unsigned char) (1u << (ch & 7));
+    }
+}
+
+static inline size_t __str_class_run(const __str_class_t* self, const char* ptr, size_t len, bool member) {
+    size_t i = 0;
+
+    while ((i != len) && (i != STR_CLASS_SCALAR_PROBE)) {
+        if (__str_class_contains(self, ptr[i]) != member) {
+            return i;
+        }
+        i += 1;
+    }
+
+    if (self->vectorized) {
+        i += __simd_class_span(self->lo_nibble, self->hi_nibble, ptr + i, len - i, member);
+    }
+
+    while ((i != len) && (__str_class_contains(self, ptr[i]) == member)) {
+        i += 1;
+    }
+
+    return i;
+}
+
+size_t __str_class_span(const __str_class_t* self, const char* ptr, size_t len) {
+    return __str_class_run(self, ptr, len, true);
+}
+
+size_t __str_class_cspan(const __str_class_t* self, const char* ptr, size_t len) {
+    return __str_class_run(self, ptr, len, false);
+}
+
+size_t __str_class_chunks(const __str_class_t* self, str_view_t string,
+                          size_t max_chunks, size_t min_len, size_t* bounds)
+{
+    size_t count = string.len / min_len;
+
+    if (count > max_chunks) {
+        count = max_chunks;
+    }
+
+    if (count == 0) {
+        count = 1;
+    }
+
+    bounds[0] = 0;
+
+    for (size_t i = 1; i < count; i++) {
+        size_t pos = (string.len / count) * i;
+
+        if (pos < bounds[i - 1]) {
+            pos = bounds[i - 1];
+        }
+
+        bounds[i] = pos + __str_class_cspan(self, string.ptr + pos, string.len - pos);
+    }
+
+    bounds[count] = string.len;
+
+    return count;
+}
+
+/* Character set */
+
+str_charset_t str_charset_new(const char* chars) {
+    str_charset_t self;
+    __str_class_init(&self, chars);
+    return self;
+}
+
+str_charset_t str_charset_range(char first, char last) {
+    str_charset_t self;
+
+    memset(self.bitmap, 0, sizeof(self.bitmap));
+
+    if ((unsigned char) first <= (unsigned char) last) {
+        __str_class_add_range(&self, (unsigned char) first, (unsigned char) last);
+    }
+
+    __str_class_init_nibbles(&self);
+
+    return self;
+}
+
+str_charset_t str_charset_digit(void) {
+    return str_charset_range('0', '9');
+}
+
+str_charset_t str_charset_alpha(void) {
+    str_charset_t self = str_charset_range('A', 'Z');
+    __str_class_add_range(&self, 'a', 'z');
+    __str_class_init_nibbles(&self);
+    return self;
+}
+
+str_charset_t str_charset_blank(void) {
+    return str_charset_new(" \t");
+}
+
+str_charset_t str_charset_space(void) {
+    return str_charset_new(" \t\n\v\f\r");
+}
+
+str_charset_t str_charset_union(const str_charset_t* a, const str_charset_t* b) {
+    str_charset_t self;
+
+    for (size_t i = 0; i < sizeof(self.bitmap); i++) {
+        self.bitmap[i] = ((a != NULL) ? a->bitmap[i] : 0) | ((b != NULL) ? b->bitmap[i] : 0);
+    }
+
+    __str_class_init_nibbles(&self);
+
+    return self;
+}
+
+bool str_charset_contains(const str_charset_t* self, char ch) {
+    return (self != NULL) && __str_class_contains(self, ch);
+}
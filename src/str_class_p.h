@@ -0,0 +1,80 @@
+/******************************************************************************
+ *
+ * @file    str_class_p.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   Character class private header file
+ *
+ * Character class answers the membership query for any character with
+ * a single table lookup, regardless of the number of characters in
+ * the class. Runs of members and non-members are scanned 16 or 32
+ * characters at a time when the class fits the nibble lookup tables.
+ *
+ *****************************************************************************/
+
+#ifndef __STR_CLASS_P_H__
+#define __STR_CLASS_P_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <ustring/str_view.h>
+
+typedef struct __str_class __str_class_t;
+
+/**
+ * @brief Checks if character is a member of the class
+ */
+#define __str_class_contains(self, ch) (                                      \
+    (((self)->bitmap[(unsigned char) (ch) >> 3] >> ((unsigned char) (ch) & 7)) & 1) != 0 \
+)
+
+/**
+ * @brief Compiles the set of characters into the class
+ *
+ * @param self Pointer to the class to be initialized
+ * @param chars Null-terminated byte string of the class members.
+ *      If @c NULL , the class is empty
+ */
+void __str_class_init(__str_class_t* self, const char* chars);
+
+/**
+ * @brief Returns the length of the initial run of class members
+ *
+ * @param self Pointer to the initialized class
+ * @param ptr Characters to scan
+ * @param len Number of characters in @c ptr
+ * @return Index of the first non-member character; @c len if there is none
+ */
+size_t __str_class_span(const __str_class_t* self, const char* ptr, size_t len);
+
+/**
+ * @brief Returns the length of the initial run of non-member characters
+ *
+ * @param self Pointer to the initialized class
+ * @param ptr Characters to scan
+ * @param len Number of characters in @c ptr
+ * @return Index of the first member character; @c len if there is none
+ */
+size_t __str_class_cspan(const __str_class_t* self, const char* ptr, size_t len);
+
+/**
+ * @brief Cuts the characters into chunks ending at class members
+ *
+ * Chunks are about the same length, each chunk boundary is moved forward
+ * to the nearest class member, so a run of non-members is never cut.
+ * Some chunks may be empty.
+ *
+ * @param self Pointer to the initialized class
+ * @param string Characters to cut
+ * @param max_chunks Maximum number of chunks
+ * @param min_len Minimum nominal length of the chunk
+ * @param bounds Array of at least @c max_chunks + 1 elements receiving
+ *      chunk boundaries: chunk @c i spans from @c bounds[i] to @c bounds[i + 1]
+ * @return Number of chunks, at least 1
+ */
+size_t __str_class_chunks(const __str_class_t* self, str_view_t string,
+                          size_t max_chunks, size_t min_len, size_t* bounds);
+
+#endif /* __STR_CLASS_P_H__ */
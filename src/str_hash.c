@@ -0,0 +1,155 @@
+/**************************************************************************//**
+ *
+ * @file    str_hash.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ *****************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+#include <ustring/str.h>
+#include <ustring/str_view.h>
+#include "str_p.h"
+#include "str_hash_p.h"
+
+static const uint64_t hash_secret[4] = {
+    0x2d358dccaa6c78a5ULL,
+    0x8bb84b93962eacc9ULL,
+    0x4b33a62ed433d4a3ULL,
+    0x4d5a2da51de1aa47ULL,
+};
+
+/**
+ * @brief Multiplies two 64-bit values into 128-bit product
+ *
+ * Low half of the product is stored to @c a , high half to @c b .
+ */
+static inline void __hash_mum(uint64_t* a, uint64_t* b) {
+#if defined(__SIZEOF_INT128__)
+    const __uint128_t product = (__uint128_t) *a * *b;
+    *a = (uint64_t) product;
+    *b = (uint64_t) (product >> 64);
+#else
+    const uint64_t a_hi = *a >> 32;
+    const uint64_t a_lo = (uint32_t) *a;
+    const uint64_t b_hi = *b >> 32;
+    const uint64_t b_lo = (uint32_t) *b;
+
+    const uint64_t hh = a_hi * b_hi;
+    const uint64_t hl = a_hi * b_lo;
+    const uint64_t lh = a_lo * b_hi;
+    const uint64_t ll = a_lo * b_lo;
+
+    const uint64_t lo = ll + (hl << 32);
+    const uint64_t carry = (lo < ll);
+    const uint64_t result_lo = lo + (lh << 32);
+
+    *b = hh + (hl >> 32) + (lh >> 32) + carry + (result_lo < lo);
+    *a = result_lo;
+#endif
+}
+
+static inline uint64_t __hash_mix(uint64_t a, uint64_t b) {
+    __hash_mum(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t __hash_read8(const unsigned char* ptr) {
+    uint64_t value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+static inline uint64_t __hash_read4(const unsigned char* ptr) {
+    uint32_t value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+/* Reads 1 to 3 bytes */
+static inline uint64_t __hash_read3(const unsigned char* ptr, size_t len) {
+    return ((uint64_t) ptr[0] << 16) | ((uint64_t) ptr[len >> 1] << 8) | ptr[len - 1];
+}
+
+uint64_t __str_hash_bytes(const char* ptr, size_t len, uint64_t seed) {
+    const unsigned char* p = (const unsigned char*) ptr;
+    uint64_t a = 0;
+    uint64_t b = 0;
+
+    seed ^= __hash_mix(seed ^ hash_secret[0], hash_secret[1]);
+
+    if (len <= 16) {
+        if (len >= 4) {
+            /* Two overlapping pairs of 4-byte reads cover 4 to 16 bytes */
+            const size_t shift = (len >> 3) << 2;
+            a = (__hash_read4(p) << 32) | __hash_read4(p + shift);
+            b = (__hash_read4(p + len - 4) << 32) | __hash_read4(p + len - 4 - shift);
+        } else if (len > 0) {
+            a = __hash_read3(p, len);
+        }
+    } else {
+        size_t remaining = len;
+
+        if (remaining > 48) {
+            uint64_t seed_1 = seed;
+            uint64_t seed_2 = seed;
+
+            do {
+                seed = __hash_mix(__hash_read8(p) ^ hash_secret[1], __hash_read8(p + 8) ^ seed);
+                seed_1 = __hash_mix(__hash_read8(p + 16) ^ hash_secret[2], __hash_read8(p + 24) ^ seed_1);
+                seed_2 = __hash_mix(__hash_read8(p + 32) ^ hash_secret[3], __hash_read8(p + 40) ^ seed_2);
+                p += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+
+            seed ^= seed_1 ^ seed_2;
+        }
+
+        while (remaining > 16) {
+            seed = __hash_mix(__hash_read8(p) ^ hash_secret[1], __hash_read8(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+
+        /* Last 16 bytes, may overlap already hashed ones */
+        a = __hash_read8(p + remaining - 16);
+        b = __hash_read8(p + remaining - 8);
+    }
+
+    a ^= hash_secret[1];
+    b ^= seed;
+    __hash_mum(&a, &b);
+
+    return __hash_mix(a ^ hash_secret[0] ^ len, b ^ hash_secret[1]);
+}
+
+uint64_t str_hash(const str_t* self) {
+    if (self == NULL) {
+        return __str_hash_bytes(NULL, 0, STR_HASH_DEFAULT_SEED);
+    }
+
+    uint64_t hash = 0;
+
+    if (!__str_hash_load(self, &hash)) {
+        hash = __str_hash_bytes(self->buffer, self->len, STR_HASH_DEFAULT_SEED);
+        __str_hash_store(self, hash);
+    }
+
+    return hash;
+}
+
+uint64_t str_hash_seeded(const str_t* self, uint64_t seed) {
+    if (seed == STR_HASH_DEFAULT_SEED) {
+        return str_hash(self);
+    }
+
+    return (self == NULL)
+        ? __str_hash_bytes(NULL, 0, seed)
+        : __str_hash_bytes(self->buffer, self->len, seed);
+}
+
+uint64_t str_view_hash(str_view_t self, uint64_t seed) {
+    return __str_hash_bytes(self.ptr, self.len, seed);
+}
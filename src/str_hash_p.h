@@ -0,0 +1,31 @@
+/******************************************************************************
+ *
+ * @file    str_hash_p.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   String hash private header file
+ *
+ *****************************************************************************/
+
+#ifndef __STR_HASH_P_H__
+#define __STR_HASH_P_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Computes 64-bit hash of the characters
+ *
+ * Hash function belongs to the wyhash family: input is consumed
+ * 48 bytes per round by three independent 64x64->128-bit multiply-mix
+ * lanes, inputs of up to 16 bytes are hashed without a loop.
+ *
+ * @param ptr Characters to hash, may be @c NULL if @c len is zero
+ * @param len Number of characters
+ * @param seed Hash seed
+ * @return Hash value
+ */
+uint64_t __str_hash_bytes(const char* ptr, size_t len, uint64_t seed);
+
+#endif /* __STR_HASH_P_H__ */
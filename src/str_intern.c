@@ -0,0 +1,181 @@
+/**************************************************************************//**
+ *
+ * @file    str_intern.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ *****************************************************************************/
+
+#include <ustring/str_intern.h>
+#include "str_intern_p.h"
+#include "alloc_p.h"
+
+static inline struct __str_intern_shard* __str_intern_shard(const str_intern_t* self, uint64_t hash) {
+    return &self->shards[(size_t) (hash >> 56) & (self->shard_count - 1)];
+}
+
+static inline void __str_intern_lock(const str_intern_t* self, struct __str_intern_shard* shard) {
+    if (self->concurrent) {
+        pthread_mutex_lock(&shard->lock);
+    }
+}
+
+static inline void __str_intern_unlock(const str_intern_t* self, struct __str_intern_shard* shard) {
+    if (self->concurrent) {
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+/**
+ * @brief Interns the key with the known table hash
+ */
+static const str_t* __str_intern(str_intern_t* self, str_view_t key, uint64_t hash) {
+    struct __str_intern_shard* shard = __str_intern_shard(self, hash);
+
+    __str_intern_lock(self, shard);
+    const size_t idx = __str_table_insert(&shard->table, key, hash);
+    const str_t* handle = (idx == STR_TABLE_NPOS) ? NULL : shard->table.slots[idx].key;
+    __str_intern_unlock(self, shard);
+
+    return handle;
+}
+
+str_intern_t* str_intern_new(void) {
+    return str_intern_new_alloc(NULL, false);
+}
+
+str_intern_t* str_intern_new_concurrent(void) {
+    return str_intern_new_alloc(NULL, true);
+}
+
+str_intern_t* str_intern_new_alloc(const ustring_allocator_t* allocator, bool concurrent) {
+    if (allocator == NULL) {
+        allocator = ustring_get_allocator();
+    }
+
+    str_intern_t* self = __ustring_malloc(allocator, sizeof(str_intern_t));
+    if (self == NULL) {
+        return NULL;
+    }
+
+    self->shard_count = concurrent ? STR_INTERN_SHARD_COUNT : 1;
+    self->concurrent = concurrent;
+    self->allocator = allocator;
+    self->shards = __ustring_malloc(allocator, self->shard_count * sizeof(struct __str_intern_shard));
+
+    if (self->shards == NULL) {
+        __ustring_free(allocator, self);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < self->shard_count; i++) {
+        __str_table_init(&self->shards[i].table, allocator);
+
+        if (concurrent && (pthread_mutex_init(&self->shards[i].lock, NULL) != 0)) {
+            /* Only the shards initialized so far are released */
+            self->shard_count = i;
+            str_intern_drop(&self);
+            return NULL;
+        }
+    }
+
+    return self;
+}
+
+void str_intern_drop(str_intern_t** self) {
+    if ((self == NULL) || (*self == NULL)) {
+        return;
+    }
+
+    str_intern_t* intern = *self;
+
+    for (size_t i = 0; i < intern->shard_count; i++) {
+        __str_table_free(&intern->shards[i].table);
+
+        if (intern->concurrent) {
+            pthread_mutex_destroy(&intern->shards[i].lock);
+        }
+    }
+
+    __ustring_free(intern->allocator, intern->shards);
+    __ustring_free(intern->allocator, intern);
+
+    *self = NULL;
+}
+
+size_t str_intern_size(const str_intern_t* self) {
+    if (self == NULL) {
+        return 0;
+    }
+
+    size_t size = 0;
+
+    for (size_t i = 0; i < self->shard_count; i++) {
+        struct __str_intern_shard* shard = &self->shards[i];
+
+        __str_intern_lock(self, shard);
+        size += shard->table.size;
+        __str_intern_unlock(self, shard);
+    }
+
+    return size;
+}
+
+const str_t* str_intern(str_intern_t* self, const str_t* string) {
+    if ((self == NULL) || (string == NULL)) {
+        return NULL;
+    }
+
+    /* Hash is computed before the shard is locked */
+    return __str_intern(self, str_as_view(string), str_hash(string));
+}
+
+const str_t* str_intern_cstr(str_intern_t* self, const char* string) {
+    if (string == NULL) {
+        return NULL;
+    }
+
+    return str_intern_view(self, str_view_new(string));
+}
+
+const str_t* str_intern_view(str_intern_t* self, str_view_t string) {
+    if (self == NULL) {
+        return NULL;
+    }
+
+    uint64_t hash;
+    str_t* normalized;
+
+    if (!__str_table_key(self->allocator, &string, &hash, &normalized)) {
+        return NULL;
+    }
+
+    const str_t* handle = __str_intern(self, string, hash);
+    str_drop(&normalized);
+
+    return handle;
+}
+
+const str_t* str_intern_lookup(const str_intern_t* self, str_view_t string) {
+    if (self == NULL) {
+        return NULL;
+    }
+
+    uint64_t hash;
+    str_t* normalized;
+
+    if (!__str_table_key(self->allocator, &string, &hash, &normalized)) {
+        return NULL;
+    }
+
+    struct __str_intern_shard* shard = __str_intern_shard(self, hash);
+
+    __str_intern_lock(self, shard);
+    const size_t idx = __str_table_find(&shard->table, string, hash);
+    const str_t* handle = (idx == STR_TABLE_NPOS) ? NULL : shard->table.slots[idx].key;
+    __str_intern_unlock(self, shard);
+
+    str_drop(&normalized);
+
+    return handle;
+}
@@ -0,0 +1,38 @@
+/******************************************************************************
+ *
+ * @file    str_intern_p.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   String Interning library private header file
+ *
+ * Interning table is a set of string hash tables (shards). String is
+ * stored in the shard selected by the high byte of its hash, which is
+ * not used by the table probing. Shards of the concurrent table are
+ * protected by their own mutexes.
+ *
+ *****************************************************************************/
+
+#ifndef __STR_INTERN_P_H__
+#define __STR_INTERN_P_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include <ustring/str_intern.h>
+#include "str_map_p.h"
+
+struct __str_intern_shard {
+    struct __str_table table;
+    pthread_mutex_t lock;
+};
+
+struct __str_intern {
+    struct __str_intern_shard* shards;
+    size_t shard_count;                 /**< Power of two not greater than 256 */
+    bool concurrent;
+    const ustring_allocator_t* allocator;
+};
+
+#endif /* __STR_INTERN_P_H__ */
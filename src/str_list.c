@@ -7,32 +7,59 @@
  *****************************************************************************/
 
 #include <stdlib.h>
+#include <string.h>
 
 #include <ustring/str_list.h>
+#include <ustring/str_view.h>
 #include "str_list_p.h"
+#include "alloc_p.h"
+#include "parallel_p.h"
+#include "str_class_p.h"
+#include "str_simd_p.h"
 
 #define USTRING_OK  ((int) 0)
 #define USTRING_ERR ((int) 1)
 
 str_list_t* str_list_new() {
-    return str_list_with_capacity(STR_LIST_DEFAULT_CAPACITY);
+    return str_list_with_capacity_alloc(NULL, STR_LIST_DEFAULT_CAPACITY);
+}
+
+str_list_t* str_list_new_in(ustring_arena_t* arena) {
+    return str_list_new_alloc(ustring_arena_allocator(arena));
+}
+
+str_list_t* str_list_new_alloc(const ustring_allocator_t* allocator) {
+    return str_list_with_capacity_alloc(allocator, STR_LIST_DEFAULT_CAPACITY);
 }
 
 str_list_t* str_list_with_capacity(size_t capacity) {
-    str_list_t* self = malloc(sizeof(str_list_t));
+    return str_list_with_capacity_alloc(NULL, capacity);
+}
+
+str_list_t* str_list_with_capacity_in(ustring_arena_t* arena, size_t capacity) {
+    return str_list_with_capacity_alloc(ustring_arena_allocator(arena), capacity);
+}
+
+str_list_t* str_list_with_capacity_alloc(const ustring_allocator_t* allocator, size_t capacity) {
+    if (allocator == NULL) {
+        allocator = ustring_get_allocator();
+    }
+
+    str_list_t* self = __ustring_malloc(allocator, sizeof(str_list_t));
     if (self == NULL) {
         return NULL;
     }
 
+    self->allocator = allocator;
     self->size = 0;
     if (capacity == 0) {
         self->cap = 0;
         self->buffer = NULL;
     } else {
         self->cap = capacity;
-        self->buffer = malloc(self->cap * sizeof(str_t*));
+        self->buffer = __ustring_malloc(allocator, self->cap * sizeof(str_t*));
         if (self->buffer == NULL) {
-            free(self);
+            __ustring_free(allocator, self);
             return NULL;
         }
         
@@ -49,19 +76,22 @@ str_list_t* str_list_copy(const str_list_t* other) {
         return str_list_with_capacity(STR_LIST_DEFAULT_CAPACITY);
     }
 
-    str_list_t* self = malloc(sizeof(str_list_t));
+    const ustring_allocator_t* allocator = ustring_get_allocator();
+
+    str_list_t* self = __ustring_malloc(allocator, sizeof(str_list_t));
     if (self == NULL) {
         return NULL;
     }
 
+    self->allocator = allocator;
     self->cap = other->size;
     self->size = other->size;
     if (self->cap == 0) {
         self->buffer = NULL;
     } else {
-        self->buffer = malloc(self->cap * sizeof(str_t*));
+        self->buffer = __ustring_malloc(allocator, self->cap * sizeof(str_t*));
         if (self->buffer == NULL) {
-            free(self);
+            __ustring_free(allocator, self);
             return NULL;
         }
 
@@ -73,6 +103,20 @@ str_list_t* str_list_copy(const str_list_t* other) {
     return self;
 }
 
+int str_list_make_shared(str_list_t* self) {
+    if (self == NULL) {
+        return USTRING_ERR;
+    }
+
+    for (size_t i = 0; i < self->size; i++) {
+        if (str_make_shared(self->buffer[i]) != USTRING_OK) {
+            return USTRING_ERR;
+        }
+    }
+
+    return USTRING_OK;
+}
+
 void str_list_drop(str_list_t** self) {
     if ((self == NULL) || (*self == NULL)) {
         return;
@@ -84,10 +128,10 @@ void str_list_drop(str_list_t** self) {
             str_drop(&(*self)->buffer[i]);
         }
 
-        free((*self)->buffer);
+        __ustring_free((*self)->allocator, (*self)->buffer);
     }
 
-    free(*self);
+    __ustring_free((*self)->allocator, *self);
     *self = NULL;
 }
 
@@ -97,12 +141,14 @@ int str_list_push(str_list_t* self, str_t* string) {
     }
 
     if (self->size == self->cap) {
-        self->cap *= 2;
-        str_t** new_buffer = realloc(self->buffer, self->cap * sizeof(str_t*));
+        const size_t new_cap = (self->cap == 0) ? STR_LIST_DEFAULT_CAPACITY : (self->cap * 2);
+        str_t** new_buffer = __ustring_realloc(self->allocator, self->buffer,
+            self->cap * sizeof(str_t*), new_cap * sizeof(str_t*));
         if (new_buffer == NULL) {
             return USTRING_ERR;
         } else {
             self->buffer = new_buffer;
+            self->cap = new_cap;
         }
     }
 
@@ -142,121 +188,234 @@ str_t* str_list_at(const str_list_t* self, const size_t idx) {
 }
 
 str_list_t* str_split(const str_t* string, const char* delim) {
-    if ((string == NULL) || (string->len == 0)) {
-        return str_list_new();
+    return str_split_alloc(NULL, string, delim);
+}
+
+str_list_t* str_split_in(ustring_arena_t* arena, const str_t* string, const char* delim) {
+    return str_split_alloc(ustring_arena_allocator(arena), string, delim);
+}
+
+str_list_t* str_split_alloc(const ustring_allocator_t* allocator, const str_t* string, const char* delim) {
+    str_list_t* result_str_list = str_list_new_alloc(allocator);
+    if (result_str_list == NULL) {
+        return NULL;
     }
 
-    if ((delim == NULL) || (__str_literal_len(delim) == 0)) {
-        str_list_t* new_list = str_list_new();
-        if (new_list == NULL) {
-            return NULL;
-        }
+    str_split_iter_t it = str_split_iter(str_as_view(string), delim);
+    str_view_t token;
 
-        str_t* self_copy = str_copy(string);
-        if (self_copy == NULL) {
-            str_list_drop(&new_list);
+    while (str_split_iter_next(&it, &token)) {
+        str_t* new_str_chunk = str_from_view_alloc(allocator, token);
+        if (new_str_chunk == NULL) {
+            str_list_drop(&result_str_list);
             return NULL;
         }
 
-        const int status = str_list_push(new_list, self_copy);
+        const int status = str_list_push(result_str_list, new_str_chunk);
         if (status != USTRING_OK) {
-            str_drop(&self_copy);
-            str_list_drop(&new_list);
+            str_drop(&new_str_chunk);
+            str_list_drop(&result_str_list);
             return NULL;
         }
+    }
+
+    return result_str_list;
+}
 
-        return new_list;
+struct __str_par_split {
+    const ustring_allocator_t* allocator;
+    str_view_t string;
+    const char* delim;
+    size_t bounds[USTRING_MAX_THREADS + 1];
+    str_list_t* chunks[USTRING_MAX_THREADS];
+};
+
+static void __str_par_split_chunk(void* ctx, size_t chunk) {
+    struct __str_par_split* self = ctx;
+    const size_t begin = self->bounds[chunk];
+    const str_view_t string = str_view_from_parts(self->string.ptr + begin, self->bounds[chunk + 1] - begin);
+
+    str_list_t* list = str_list_new_alloc(self->allocator);
+    if (list == NULL) {
+        return;
     }
 
-    str_list_t* result_str_list = str_list_new();
-    if (result_str_list == NULL) {
+    str_split_iter_t it = str_split_iter(string, self->delim);
+    str_view_t token;
+
+    while (str_split_iter_next(&it, &token)) {
+        str_t* new_str_chunk = str_from_view_alloc(self->allocator, token);
+
+        if ((new_str_chunk == NULL) || (str_list_push(list, new_str_chunk) != USTRING_OK)) {
+            str_drop(&new_str_chunk);
+            str_list_drop(&list);
+            return;
+        }
+    }
+
+    self->chunks[chunk] = list;
+}
+
+str_list_t* str_par_split(const str_t* string, const char* delim, size_t threads) {
+    return str_par_split_alloc(NULL, string, delim, threads);
+}
+
+str_list_t* str_par_split_alloc(const ustring_allocator_t* allocator, const str_t* string,
+                                const char* delim, size_t threads)
+{
+    if (allocator == NULL) {
+        allocator = ustring_get_allocator();
+    }
+
+    struct __str_par_split* split = __ustring_malloc(allocator, sizeof(struct __str_par_split));
+    if (split == NULL) {
         return NULL;
     }
 
-    char str_chunk[string->len + 1];
-    const char* const bound_back = string->buffer + string->len;
+    __str_class_t delim_class;
+    __str_class_init(&delim_class, delim);
 
-    const char* front_ptr = string->buffer;
-    const char* back_ptr = NULL;
+    split->allocator = allocator;
+    split->string = str_as_view(string);
+    split->delim = delim;
 
-    while (front_ptr != bound_back) {
-        while ((front_ptr != bound_back) && __str_literal_contains(delim, *front_ptr)) {
-            front_ptr++;
-        }
+    threads = __ustring_thread_count(threads);
+    const size_t chunk_count = __str_class_chunks(&delim_class, split->string,
+        threads, USTRING_PAR_MIN_CHUNK, split->bounds);
 
-        back_ptr = front_ptr;
+    memset(split->chunks, 0, chunk_count * sizeof(str_list_t*));
+    __ustring_parallel_for(threads, chunk_count, __str_par_split_chunk, split);
 
-        while ((back_ptr != bound_back) && !__str_literal_contains(delim, *back_ptr)) {
-            back_ptr++;
-        }
+    /* Chunk lists are stitched in order, strings are moved to the result */
+    size_t size = 0;
+    bool failed = false;
 
-        if (front_ptr != back_ptr) {
-            size_t i = 0;
-            for (; (front_ptr + i) != back_ptr; i++) {
-                str_chunk[i] = *(front_ptr + i);
-            }
-            str_chunk[i] = '\0';
+    for (size_t i = 0; i < chunk_count; i++) {
+        failed |= (split->chunks[i] == NULL);
+        size += str_list_size(split->chunks[i]);
+    }
 
-            str_t* new_str_chunk = str_new(str_chunk);
-            if (new_str_chunk == NULL) {
-                str_list_drop(&result_str_list);
-                return NULL;
-            }
+    str_list_t* result_str_list = failed ? NULL : str_list_with_capacity_alloc(allocator, size);
 
-            const int status = str_list_push(result_str_list, new_str_chunk);
-            if (status != USTRING_OK) {
-                str_list_drop(&result_str_list);
-                return NULL;
-            }
+    for (size_t i = 0; i < chunk_count; i++) {
+        str_list_t* chunk = split->chunks[i];
 
-            front_ptr = back_ptr;
+        if ((result_str_list != NULL) && (chunk->size != 0)) {
+            memcpy(result_str_list->buffer + result_str_list->size, chunk->buffer, chunk->size * sizeof(str_t*));
+            result_str_list->size += chunk->size;
+            chunk->size = 0;
         }
+
+        str_list_drop(&chunk);
     }
 
+    __ustring_free(allocator, split);
+
     return result_str_list;
 }
 
 str_t* str_list_join(const str_list_t* self, const char* delim) {
-    if ((self == NULL) || (self->size == 0)) {
-        return str_new(NULL);
-    }
+    return str_list_join_alloc(NULL, self, delim);
+}
 
-    const size_t delim_len = __str_literal_len(delim);
+str_t* str_list_join_in(ustring_arena_t* arena, const str_list_t* self, const char* delim) {
+    return str_list_join_alloc(ustring_arena_allocator(arena), self, delim);
+}
+
+/**
+ * @brief Returns the length of the joined string
+ */
+static size_t __str_list_join_len(const str_list_t* self, size_t delim_len) {
     size_t total_len = delim_len * (self->size - 1);
 
     for (size_t i = 0; i < self->size; i++) {
         total_len += self->buffer[i]->len;
     }
 
-    str_t* result_str = str_with_capacity(total_len + 1);
+    return total_len;
+}
+
+/**
+ * @brief Writes joined list items to the buffer of sufficient size
+ *
+ * Buffer may belong to one of the list items as long as
+ * it does not overlap the characters of the items.
+ */
+static void __str_list_join_fill(char* dst, const str_list_t* self, const char* delim, size_t delim_len) {
+    const char* delim_copy = NULL;
+
+    for (size_t i = 0; i < self->size; i++) {
+        if ((i != 0) && (delim_len != 0)) {
+            if (delim_copy == NULL) {
+                /* Delimiter is normalized once, the normalized copy is reused */
+                __simd_ascii_copy(dst, delim, delim_len);
+                delim_copy = dst;
+            } else {
+                memcpy(dst, delim_copy, delim_len);
+            }
+            dst += delim_len;
+        }
+
+        memcpy(dst, self->buffer[i]->buffer, self->buffer[i]->len);
+        dst += self->buffer[i]->len;
+    }
+
+    *dst = '\0';
+}
+
+str_t* str_list_join_alloc(const ustring_allocator_t* allocator, const str_list_t* self, const char* delim) {
+    if ((self == NULL) || (self->size == 0)) {
+        return str_new_alloc(allocator, NULL);
+    }
+
+    const size_t delim_len = (delim == NULL) ? 0 : __str_literal_len(delim);
+    const size_t total_len = __str_list_join_len(self, delim_len);
+
+    str_t* result_str = str_with_capacity_alloc(allocator, total_len + 1);
     if (result_str == NULL) {
         return NULL;
     }
 
-    for (size_t i = 0; i < self->size; i++) {
-        const str_t* status =
-            str_append(result_str, str_as_ptr(self->buffer[i]));
+    __str_list_join_fill(result_str->buffer, self, delim, delim_len);
+    result_str->len = total_len;
 
-        if (status == NULL) {
-            str_drop(&result_str);
-            return NULL;
-        }
+    return result_str;
+}
 
-        if (i < (self->size - 1)) {
-            if (str_append(result_str, delim) == NULL) {
-                str_drop(&result_str);
-                return NULL;
-            }
-        }
+int str_list_join_into(str_t* dst, const str_list_t* self, const char* delim) {
+    if (dst == NULL) {
+        return USTRING_ERR;
     }
 
-    return result_str;
+    if ((self == NULL) || (self->size == 0)) {
+        return USTRING_OK;
+    }
+
+    const size_t delim_len = (delim == NULL) ? 0 : __str_literal_len(delim);
+    const size_t new_len = dst->len + __str_list_join_len(self, delim_len);
+
+    if (!__str_make_unique(dst) || !__str_reserve(dst, new_len)) {
+        return USTRING_ERR;
+    }
+
+    __str_hash_invalidate(dst);
+
+    __str_list_join_fill(dst->buffer + dst->len, self, delim, delim_len);
+    dst->len = new_len;
+
+    return USTRING_OK;
 }
 
 str_list_t* str_split_whitespace(const str_t* string) {
-    const char* whitespace_delim = " \t\v\n\r";
+    return str_split_whitespace_alloc(NULL, string);
+}
+
+str_list_t* str_split_whitespace_in(ustring_arena_t* arena, const str_t* string) {
+    return str_split_whitespace_alloc(ustring_arena_allocator(arena), string);
+}
 
-    return str_split(string, whitespace_delim);
+str_list_t* str_split_whitespace_alloc(const ustring_allocator_t* allocator, const str_t* string) {
+    return str_split_alloc(allocator, string, STR_WHITESPACE_DELIM);
 }
 
 bool str_list_contains(const str_list_t* self, const str_t* string) {
@@ -0,0 +1,355 @@
+/**************************************************************************//**
+ *
+ * @file    str_list_flat.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ *****************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+#include <ustring/str_list_flat.h>
+#include "str_list_flat_p.h"
+#include "alloc_p.h"
+#include "parallel_p.h"
+#include "str_class_p.h"
+#include "str_simd_p.h"
+
+#define USTRING_OK  ((int) 0)
+#define USTRING_ERR ((int) 1)
+
+static size_t __grow_capacity(size_t cap, size_t required) {
+    if (cap == 0) {
+        cap = 1;
+    }
+
+    while (cap < required) {
+        cap *= 2;
+    }
+
+    return cap;
+}
+
+static bool __str_list_flat_reserve(str_list_flat_t* self, size_t items, size_t bytes) {
+    if ((self->size + items) > self->cap) {
+        const size_t new_cap = __grow_capacity(self->cap, self->size + items);
+        struct __str_list_flat_item* new_items = __ustring_realloc(self->allocator, self->items,
+            self->cap * sizeof(*self->items), new_cap * sizeof(*self->items));
+
+        if (new_items == NULL) {
+            return false;
+        }
+
+        self->items = new_items;
+        self->cap = new_cap;
+    }
+
+    if ((self->bytes_len + bytes) > self->bytes_cap) {
+        const size_t new_cap = __grow_capacity(self->bytes_cap, self->bytes_len + bytes);
+        char* new_bytes = __ustring_realloc(self->allocator, self->bytes, self->bytes_cap, new_cap);
+
+        if (new_bytes == NULL) {
+            return false;
+        }
+
+        self->bytes = new_bytes;
+        self->bytes_cap = new_cap;
+    }
+
+    return true;
+}
+
+/*
+ * View may point into own bytes, which can be moved by reallocation.
+ * Such view is re-pointed to the same characters in the new bytes.
+ */
+static bool __str_list_flat_reserve_view(str_list_flat_t* self, size_t items, size_t bytes, str_view_t* string) {
+    const uintptr_t string_addr = (uintptr_t) string->ptr;
+    const uintptr_t bytes_addr = (uintptr_t) self->bytes;
+    const bool own_bytes = (self->bytes != NULL)
+        && (string_addr >= bytes_addr) && (string_addr < (bytes_addr + self->bytes_cap));
+    const size_t own_offset = string_addr - bytes_addr;
+
+    if (!__str_list_flat_reserve(self, items, bytes)) {
+        return false;
+    }
+
+    if (own_bytes) {
+        string->ptr = self->bytes + own_offset;
+    }
+
+    return true;
+}
+
+str_list_flat_t* str_list_flat_new(void) {
+    return str_list_flat_with_capacity_alloc(NULL,
+        STR_LIST_FLAT_DEFAULT_CAPACITY, STR_LIST_FLAT_DEFAULT_BYTES);
+}
+
+str_list_flat_t* str_list_flat_with_capacity(size_t capacity, size_t bytes) {
+    return str_list_flat_with_capacity_alloc(NULL, capacity, bytes);
+}
+
+str_list_flat_t* str_list_flat_with_capacity_alloc(const ustring_allocator_t* allocator,
+                                                   size_t capacity, size_t bytes)
+{
+    if (allocator == NULL) {
+        allocator = ustring_get_allocator();
+    }
+
+    str_list_flat_t* self = __ustring_malloc(allocator, sizeof(str_list_flat_t));
+    if (self == NULL) {
+        return NULL;
+    }
+
+    self->bytes = NULL;
+    self->bytes_len = 0;
+    self->bytes_cap = 0;
+    self->items = NULL;
+    self->size = 0;
+    self->cap = 0;
+    self->allocator = allocator;
+
+    if (!__str_list_flat_reserve(self, capacity, bytes)) {
+        str_list_flat_drop(&self);
+        return NULL;
+    }
+
+    return self;
+}
+
+void str_list_flat_drop(str_list_flat_t** self) {
+    if ((self == NULL) || (*self == NULL)) {
+        return;
+    }
+
+    const ustring_allocator_t* allocator = (*self)->allocator;
+
+    __ustring_free(allocator, (*self)->bytes);
+    __ustring_free(allocator, (*self)->items);
+    __ustring_free(allocator, *self);
+
+    *self = NULL;
+}
+
+int str_list_flat_push(str_list_flat_t* self, str_view_t string) {
+    if (self == NULL) {
+        return USTRING_ERR;
+    }
+
+    if (!__str_list_flat_reserve_view(self, 1, string.len + 1, &string)) {
+        return USTRING_ERR;
+    }
+
+    char* dst = self->bytes + self->bytes_len;
+
+    if (string.len != 0) {
+        __simd_ascii_copy(dst, string.ptr, string.len);
+    }
+    dst[string.len] = '\0';
+
+    self->items[self->size].offset = self->bytes_len;
+    self->items[self->size].len = string.len;
+    self->size += 1;
+    self->bytes_len += string.len + 1;
+
+    return USTRING_OK;
+}
+
+int str_list_flat_clear(str_list_flat_t* self) {
+    if (self == NULL) {
+        return USTRING_ERR;
+    }
+
+    self->size = 0;
+    self->bytes_len = 0;
+
+    return USTRING_OK;
+}
+
+size_t str_list_flat_size(const str_list_flat_t* self) {
+    return (self == NULL) ? 0 : self->size;
+}
+
+bool str_list_flat_is_empty(const str_list_flat_t* self) {
+    return (self == NULL) || (self->size == 0);
+}
+
+str_view_t str_list_flat_at(const str_list_flat_t* self, size_t idx) {
+    if ((self == NULL) || (idx >= self->size)) {
+        return str_view_from_parts(NULL, 0);
+    }
+
+    return str_view_from_parts(self->bytes + self->items[idx].offset, self->items[idx].len);
+}
+
+int str_split_into(str_list_flat_t* self, str_view_t string, const char* delim) {
+    if (self == NULL) {
+        return USTRING_ERR;
+    }
+
+    /* Tokens never take more characters than the input */
+    if (!__str_list_flat_reserve_view(self, 0, string.len + 1, &string)) {
+        return USTRING_ERR;
+    }
+
+    str_split_iter_t it = str_split_iter(string, delim);
+    str_view_t token;
+
+    while (str_split_iter_next(&it, &token)) {
+        if (str_list_flat_push(self, token) != USTRING_OK) {
+            return USTRING_ERR;
+        }
+    }
+
+    return USTRING_OK;
+}
+
+struct __str_par_split_flat {
+    str_list_flat_t* target;
+    str_view_t string;
+    const char* delim;
+    size_t bounds[USTRING_MAX_THREADS + 1];
+    str_list_flat_t* chunks[USTRING_MAX_THREADS];
+    size_t item_offsets[USTRING_MAX_THREADS];
+    size_t byte_offsets[USTRING_MAX_THREADS];
+};
+
+static void __str_par_split_flat_chunk(void* ctx, size_t chunk) {
+    struct __str_par_split_flat* self = ctx;
+    const size_t begin = self->bounds[chunk];
+    const size_t len = self->bounds[chunk + 1] - begin;
+
+    str_list_flat_t* list = str_list_flat_with_capacity_alloc(self->target->allocator,
+        STR_LIST_FLAT_DEFAULT_CAPACITY, len + 1);
+
+    if ((list != NULL)
+            && (str_split_into(list, str_view_from_parts(self->string.ptr + begin, len), self->delim) != USTRING_OK))
+    {
+        str_list_flat_drop(&list);
+    }
+
+    self->chunks[chunk] = list;
+}
+
+static void __str_par_split_flat_stitch(void* ctx, size_t chunk) {
+    struct __str_par_split_flat* self = ctx;
+    const str_list_flat_t* list = self->chunks[chunk];
+    const size_t byte_offset = self->byte_offsets[chunk];
+    struct __str_list_flat_item* items = self->target->items + self->item_offsets[chunk];
+
+    if (list->bytes_len != 0) {
+        memcpy(self->target->bytes + byte_offset, list->bytes, list->bytes_len);
+    }
+
+    for (size_t i = 0; i < list->size; i++) {
+        items[i].offset = list->items[i].offset + byte_offset;
+        items[i].len = list->items[i].len;
+    }
+}
+
+int str_par_split_into(str_list_flat_t* self, str_view_t string, const char* delim, size_t threads) {
+    if (self == NULL) {
+        return USTRING_ERR;
+    }
+
+    struct __str_par_split_flat* split = __ustring_malloc(self->allocator, sizeof(struct __str_par_split_flat));
+    if (split == NULL) {
+        return USTRING_ERR;
+    }
+
+    __str_class_t delim_class;
+    __str_class_init(&delim_class, delim);
+
+    split->target = self;
+    split->string = string;
+    split->delim = delim;
+
+    threads = __ustring_thread_count(threads);
+    const size_t chunk_count = __str_class_chunks(&delim_class, string,
+        threads, USTRING_PAR_MIN_CHUNK, split->bounds);
+
+    __ustring_parallel_for(threads, chunk_count, __str_par_split_flat_chunk, split);
+
+    size_t items = 0;
+    size_t bytes = 0;
+    bool failed = false;
+
+    for (size_t i = 0; i < chunk_count; i++) {
+        if (split->chunks[i] == NULL) {
+            failed = true;
+            continue;
+        }
+
+        split->item_offsets[i] = self->size + items;
+        split->byte_offsets[i] = self->bytes_len + bytes;
+        items += split->chunks[i]->size;
+        bytes += split->chunks[i]->bytes_len;
+    }
+
+    /* Chunk lists are copied to their places in the list at the same time */
+    failed = failed || !__str_list_flat_reserve(self, items, bytes);
+
+    if (!failed) {
+        __ustring_parallel_for(threads, chunk_count, __str_par_split_flat_stitch, split);
+        self->size += items;
+        self->bytes_len += bytes;
+    }
+
+    for (size_t i = 0; i < chunk_count; i++) {
+        str_list_flat_drop(&split->chunks[i]);
+    }
+
+    __ustring_free(self->allocator, split);
+
+    return failed ? USTRING_ERR : USTRING_OK;
+}
+
+str_t* str_list_flat_join(const str_list_flat_t* self, const char* delim) {
+    return str_list_flat_join_alloc(NULL, self, delim);
+}
+
+str_t* str_list_flat_join_alloc(const ustring_allocator_t* allocator,
+                                const str_list_flat_t* self, const char* delim)
+{
+    if ((self == NULL) || (self->size == 0)) {
+        return str_new_alloc(allocator, NULL);
+    }
+
+    const size_t delim_len = (delim == NULL) ? 0 : __str_literal_len(delim);
+    size_t total_len = delim_len * (self->size - 1);
+
+    for (size_t i = 0; i < self->size; i++) {
+        total_len += self->items[i].len;
+    }
+
+    str_t* result_str = str_with_capacity_alloc(allocator, total_len + 1);
+    if (result_str == NULL) {
+        return NULL;
+    }
+
+    char* dst = result_str->buffer;
+    const char* delim_copy = NULL;
+
+    for (size_t i = 0; i < self->size; i++) {
+        if ((i != 0) && (delim_len != 0)) {
+            if (delim_copy == NULL) {
+                /* Delimiter is normalized once, as in str_list_join */
+                __simd_ascii_copy(dst, delim, delim_len);
+                delim_copy = dst;
+            } else {
+                memcpy(dst, delim_copy, delim_len);
+            }
+            dst += delim_len;
+        }
+
+        memcpy(dst, self->bytes + self->items[i].offset, self->items[i].len);
+        dst += self->items[i].len;
+    }
+
+    *dst = '\0';
+    result_str->len = total_len;
+
+    return result_str;
+}
@@ -0,0 +1,35 @@
+/******************************************************************************
+ *
+ * @file    str_list_flat_p.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   Flat String List library private header file
+ *
+ *****************************************************************************/
+
+#ifndef __STR_LIST_FLAT_P_H__
+#define __STR_LIST_FLAT_P_H__
+
+#include <ustring/str_list_flat.h>
+#include "str_p.h"
+
+#define STR_LIST_FLAT_DEFAULT_CAPACITY ((size_t) 32)
+#define STR_LIST_FLAT_DEFAULT_BYTES ((size_t) 256)
+
+struct __str_list_flat_item {
+    size_t offset;
+    size_t len;
+};
+
+struct __str_list_flat {
+    char* bytes;
+    size_t bytes_len;
+    size_t bytes_cap;
+    struct __str_list_flat_item* items;
+    size_t size;
+    size_t cap;
+    const ustring_allocator_t* allocator;
+};
+
+#endif /* __STR_LIST_FLAT_P_H__ */
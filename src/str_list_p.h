@@ -19,6 +19,7 @@ struct __str_list {
     str_t** buffer;
     size_t size;
     size_t cap;
+    const ustring_allocator_t* allocator;
 };
 
 #endif /* __STR_LIST_P_H__ */
@@ -0,0 +1,691 @@
+/**************************************************************************//**
+ *
+ * @file    str_map.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ *****************************************************************************/
+
+#include <string.h>
+
+#include <ustring/str_map.h>
+#include "str_map_p.h"
+#include "str_list_p.h"
+#include "alloc_p.h"
+#include "str_simd_p.h"
+
+#if USTRING_SIMD_X86
+#include <emmintrin.h>
+#endif
+
+#define USTRING_OK  ((int) 0)
+#define USTRING_ERR ((int) 1)
+
+/* Group matching */
+
+static inline unsigned int __bit_ctz(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int) __builtin_ctz(mask);
+#else
+    unsigned int count = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        count += 1;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Returns bit mask of the group slots with the given control byte
+ */
+static inline uint32_t __group_match(const uint8_t* group, uint8_t ctrl) {
+#if USTRING_SIMD_X86
+    const __m128i ctrl_bytes = _mm_loadu_si128((const __m128i*) group);
+    return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl_bytes, _mm_set1_epi8((char) ctrl)));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < STR_TABLE_GROUP_WIDTH; i++) {
+        mask |= (uint32_t) (group[i] == ctrl) << i;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * @brief Returns bit mask of the group slots that are either empty or deleted
+ */
+static inline uint32_t __group_match_free(const uint8_t* group) {
+#if USTRING_SIMD_X86
+    /* High bit is set only for EMPTY and DELETED control bytes */
+    return (uint32_t) _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) group));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < STR_TABLE_GROUP_WIDTH; i++) {
+        mask |= (uint32_t) (group[i] >> 7) << i;
+    }
+    return mask;
+#endif
+}
+
+/* Hash table */
+
+#define __hash_h1(hash) ((size_t) ((hash) >> 7))
+#define __hash_h2(hash) ((uint8_t) ((hash) & 0x7F))
+
+static inline size_t __table_growth(size_t cap) {
+    /* Maximum load factor is 7/8 */
+    return cap - (cap / 8);
+}
+
+static inline void __table_set_ctrl(struct __str_table* self, size_t idx, uint8_t ctrl) {
+    self->ctrl[idx] = ctrl;
+    if (idx < STR_TABLE_GROUP_WIDTH) {
+        self->ctrl[self->cap + idx] = ctrl;
+    }
+}
+
+void __str_table_init(struct __str_table* self, const ustring_allocator_t* allocator) {
+    self->ctrl = NULL;
+    self->slots = NULL;
+    self->cap = 0;
+    self->size = 0;
+    self->growth_left = 0;
+    self->allocator = allocator;
+}
+
+static void __table_clear(struct __str_table* self) {
+    for (size_t i = 0; i < self->cap; i++) {
+        if (self->ctrl[i] < STR_TABLE_CTRL_EMPTY) {
+            str_drop(&self->slots[i].key);
+        }
+    }
+
+    if (self->cap != 0) {
+        memset(self->ctrl, STR_TABLE_CTRL_EMPTY, self->cap + STR_TABLE_GROUP_WIDTH);
+    }
+
+    self->size = 0;
+    self->growth_left = __table_growth(self->cap);
+}
+
+void __str_table_free(struct __str_table* self) {
+    __table_clear(self);
+    /* Control bytes are allocated in the same block after the slots */
+    __ustring_free(self->allocator, self->slots);
+}
+
+/**
+ * @brief Returns the index of the first empty or deleted slot on the probe sequence of the hash
+ */
+static size_t __table_find_free(const struct __str_table* self, uint64_t hash) {
+    const size_t mask = self->cap - 1;
+    size_t offset = __hash_h1(hash) & mask;
+    size_t step = 0;
+
+    for (;;) {
+        const uint32_t free_mask = __group_match_free(self->ctrl + offset);
+        if (free_mask != 0) {
+            return (offset + __bit_ctz(free_mask)) & mask;
+        }
+
+        step += STR_TABLE_GROUP_WIDTH;
+        offset = (offset + step) & mask;
+    }
+}
+
+size_t __str_table_find(const struct __str_table* self, str_view_t key, uint64_t hash) {
+    if (self->size == 0) {
+        return STR_TABLE_NPOS;
+    }
+
+    const size_t mask = self->cap - 1;
+    const uint8_t h2 = __hash_h2(hash);
+    size_t offset = __hash_h1(hash) & mask;
+    size_t step = 0;
+
+    for (;;) {
+        const uint8_t* group = self->ctrl + offset;
+
+        uint32_t match = __group_match(group, h2);
+        while (match != 0) {
+            const size_t idx = (offset + __bit_ctz(match)) & mask;
+            const str_t* slot_key = self->slots[idx].key;
+
+            if ((slot_key->len == key.len)
+                    && ((key.len == 0) || (memcmp(slot_key->buffer, key.ptr, key.len) == 0)))
+            {
+                return idx;
+            }
+
+            match &= match - 1;
+        }
+
+        /* Probe sequence ends at the first group with an empty slot */
+        if (__group_match(group, STR_TABLE_CTRL_EMPTY) != 0) {
+            return STR_TABLE_NPOS;
+        }
+
+        step += STR_TABLE_GROUP_WIDTH;
+        offset = (offset + step) & mask;
+    }
+}
+
+/**
+ * @brief Moves all keys to the new table of the given capacity dropping deleted slots
+ */
+static bool __table_resize(struct __str_table* self, size_t new_cap) {
+    const size_t slots_size = new_cap * sizeof(struct __str_table_slot);
+    struct __str_table_slot* new_slots =
+        __ustring_malloc(self->allocator, slots_size + new_cap + STR_TABLE_GROUP_WIDTH);
+
+    if (new_slots == NULL) {
+        return false;
+    }
+
+    struct __str_table old = *self;
+
+    self->slots = new_slots;
+    self->ctrl = (uint8_t*) new_slots + slots_size;
+    self->cap = new_cap;
+    self->growth_left = __table_growth(new_cap) - old.size;
+
+    memset(self->ctrl, STR_TABLE_CTRL_EMPTY, new_cap + STR_TABLE_GROUP_WIDTH);
+
+    for (size_t i = 0; i < old.cap; i++) {
+        if (old.ctrl[i] < STR_TABLE_CTRL_EMPTY) {
+            /* Hash of the stored key is cached */
+            const uint64_t hash = str_hash(old.slots[i].key);
+            const size_t idx = __table_find_free(self, hash);
+
+            __table_set_ctrl(self, idx, __hash_h2(hash));
+            self->slots[idx] = old.slots[i];
+        }
+    }
+
+    __ustring_free(self->allocator, old.slots);
+
+    return true;
+}
+
+static size_t __table_capacity_for(size_t size) {
+    size_t cap = STR_TABLE_MIN_CAPACITY;
+
+    while (__table_growth(cap) < size) {
+        cap *= 2;
+    }
+
+    return cap;
+}
+
+static bool __table_reserve(struct __str_table* self, size_t size) {
+    const size_t cap = __table_capacity_for(size);
+    return (cap <= self->cap) || __table_resize(self, cap);
+}
+
+size_t __str_table_insert(struct __str_table* self, str_view_t key, uint64_t hash) {
+    size_t idx = __str_table_find(self, key, hash);
+    if (idx != STR_TABLE_NPOS) {
+        return idx;
+    }
+
+    if (self->cap == 0) {
+        if (!__table_resize(self, STR_TABLE_MIN_CAPACITY)) {
+            return STR_TABLE_NPOS;
+        }
+    }
+
+    idx = __table_find_free(self, hash);
+
+    if ((self->ctrl[idx] == STR_TABLE_CTRL_EMPTY) && (self->growth_left == 0)) {
+        /* Table is full of keys and deleted slots: drop deleted slots or grow */
+        const size_t new_cap = (self->size < (__table_growth(self->cap) / 2))
+            ? self->cap
+            : self->cap * 2;
+
+        if (!__table_resize(self, new_cap)) {
+            return STR_TABLE_NPOS;
+        }
+
+        idx = __table_find_free(self, hash);
+    }
+
+    str_t* key_copy = str_from_view_alloc(self->allocator, key);
+    if (key_copy == NULL) {
+        return STR_TABLE_NPOS;
+    }
+
+    /* Hash of the stored key is used when the table is resized */
+    __str_hash_store(key_copy, hash);
+
+    if (self->ctrl[idx] == STR_TABLE_CTRL_EMPTY) {
+        self->growth_left -= 1;
+    }
+
+    __table_set_ctrl(self, idx, __hash_h2(hash));
+    self->slots[idx].key = key_copy;
+    self->slots[idx].value = NULL;
+    self->size += 1;
+
+    return idx;
+}
+
+static bool __table_erase(struct __str_table* self, str_view_t key, uint64_t hash) {
+    const size_t idx = __str_table_find(self, key, hash);
+    if (idx == STR_TABLE_NPOS) {
+        return false;
+    }
+
+    str_drop(&self->slots[idx].key);
+    __table_set_ctrl(self, idx, STR_TABLE_CTRL_DELETED);
+    self->size -= 1;
+
+    return true;
+}
+
+static bool __table_next(const struct __str_table* self, size_t* pos, size_t* idx) {
+    if (pos == NULL) {
+        return false;
+    }
+
+    while (*pos < self->cap) {
+        const size_t i = *pos;
+        *pos += 1;
+
+        if (self->ctrl[i] < STR_TABLE_CTRL_EMPTY) {
+            *idx = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool __view_is_ascii(str_view_t key) {
+    for (size_t i = 0; i < key.len; i++) {
+        if ((unsigned char) key.ptr[i] > 0x7F) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool __str_table_key(const ustring_allocator_t* allocator,
+                     str_view_t* key, uint64_t* hash, str_t** normalized)
+{
+    *normalized = NULL;
+
+    if (__view_is_ascii(*key)) {
+        *hash = str_view_hash(*key, STR_HASH_DEFAULT_SEED);
+        return true;
+    }
+
+    *normalized = str_from_view_alloc(allocator, *key);
+    if (*normalized == NULL) {
+        return false;
+    }
+
+    *key = str_as_view(*normalized);
+    *hash = str_hash(*normalized);
+
+    return true;
+}
+
+static size_t __table_insert_view(struct __str_table* self, str_view_t key) {
+    uint64_t hash;
+    str_t* normalized;
+
+    if (!__str_table_key(self->allocator, &key, &hash, &normalized)) {
+        return STR_TABLE_NPOS;
+    }
+
+    const size_t idx = __str_table_insert(self, key, hash);
+    str_drop(&normalized);
+
+    return idx;
+}
+
+static size_t __table_find_view(const struct __str_table* self, str_view_t key) {
+    uint64_t hash;
+    str_t* normalized;
+
+    if ((self->size == 0) || !__str_table_key(self->allocator, &key, &hash, &normalized)) {
+        return STR_TABLE_NPOS;
+    }
+
+    const size_t idx = __str_table_find(self, key, hash);
+    str_drop(&normalized);
+
+    return idx;
+}
+
+static bool __table_erase_view(struct __str_table* self, str_view_t key) {
+    uint64_t hash;
+    str_t* normalized;
+
+    if ((self->size == 0) || !__str_table_key(self->allocator, &key, &hash, &normalized)) {
+        return false;
+    }
+
+    const bool erased = __table_erase(self, key, hash);
+    str_drop(&normalized);
+
+    return erased;
+}
+
+/* String map */
+
+str_map_t* str_map_new(void) {
+    return str_map_with_capacity_alloc(NULL, 0);
+}
+
+str_map_t* str_map_with_capacity(size_t capacity) {
+    return str_map_with_capacity_alloc(NULL, capacity);
+}
+
+str_map_t* str_map_with_capacity_alloc(const ustring_allocator_t* allocator, size_t capacity) {
+    if (allocator == NULL) {
+        allocator = ustring_get_allocator();
+    }
+
+    str_map_t* self = __ustring_malloc(allocator, sizeof(str_map_t));
+    if (self == NULL) {
+        return NULL;
+    }
+
+    __str_table_init(&self->table, allocator);
+
+    if ((capacity != 0) && !__table_reserve(&self->table, capacity)) {
+        str_map_drop(&self);
+        return NULL;
+    }
+
+    return self;
+}
+
+void str_map_drop(str_map_t** self) {
+    if ((self == NULL) || (*self == NULL)) {
+        return;
+    }
+
+    __str_table_free(&(*self)->table);
+    __ustring_free((*self)->table.allocator, *self);
+
+    *self = NULL;
+}
+
+size_t str_map_size(const str_map_t* self) {
+    return (self == NULL) ? 0 : self->table.size;
+}
+
+bool str_map_is_empty(const str_map_t* self) {
+    return (self == NULL) || (self->table.size == 0);
+}
+
+int str_map_clear(str_map_t* self) {
+    if (self == NULL) {
+        return USTRING_ERR;
+    }
+
+    __table_clear(&self->table);
+
+    return USTRING_OK;
+}
+
+int str_map_insert(str_map_t* self, const str_t* key, void* value) {
+    if ((self == NULL) || (key == NULL)) {
+        return USTRING_ERR;
+    }
+
+    const size_t idx = __str_table_insert(&self->table, str_as_view(key), str_hash(key));
+    if (idx == STR_TABLE_NPOS) {
+        return USTRING_ERR;
+    }
+
+    self->table.slots[idx].value = value;
+
+    return USTRING_OK;
+}
+
+int str_map_insert_cstr(str_map_t* self, const char* key, void* value) {
+    if (key == NULL) {
+        return USTRING_ERR;
+    }
+
+    return str_map_insert_view(self, str_view_new(key), value);
+}
+
+int str_map_insert_view(str_map_t* self, str_view_t key, void* value) {
+    if (self == NULL) {
+        return USTRING_ERR;
+    }
+
+    const size_t idx = __table_insert_view(&self->table, key);
+    if (idx == STR_TABLE_NPOS) {
+        return USTRING_ERR;
+    }
+
+    self->table.slots[idx].value = value;
+
+    return USTRING_OK;
+}
+
+void** str_map_find(const str_map_t* self, const str_t* key) {
+    if ((self == NULL) || (key == NULL)) {
+        return NULL;
+    }
+
+    const size_t idx = __str_table_find(&self->table, str_as_view(key), str_hash(key));
+
+    return (idx == STR_TABLE_NPOS) ? NULL : &self->table.slots[idx].value;
+}
+
+void** str_map_find_cstr(const str_map_t* self, const char* key) {
+    return (key == NULL) ? NULL : str_map_find_view(self, str_view_new(key));
+}
+
+void** str_map_find_view(const str_map_t* self, str_view_t key) {
+    if (self == NULL) {
+        return NULL;
+    }
+
+    const size_t idx = __table_find_view(&self->table, key);
+
+    return (idx == STR_TABLE_NPOS) ? NULL : &self->table.slots[idx].value;
+}
+
+bool str_map_erase(str_map_t* self, const str_t* key) {
+    if ((self == NULL) || (key == NULL)) {
+        return false;
+    }
+
+    return __table_erase(&self->table, str_as_view(key), str_hash(key));
+}
+
+bool str_map_erase_cstr(str_map_t* self, const char* key) {
+    return (key != NULL) && str_map_erase_view(self, str_view_new(key));
+}
+
+bool str_map_erase_view(str_map_t* self, str_view_t key) {
+    if (self == NULL) {
+        return false;
+    }
+
+    return __table_erase_view(&self->table, key);
+}
+
+bool str_map_next(const str_map_t* self, size_t* pos, const str_t** key, void** value) {
+    size_t idx = 0;
+
+    if ((self == NULL) || !__table_next(&self->table, pos, &idx)) {
+        return false;
+    }
+
+    if (key != NULL) {
+        *key = self->table.slots[idx].key;
+    }
+
+    if (value != NULL) {
+        *value = self->table.slots[idx].value;
+    }
+
+    return true;
+}
+
+/* String set */
+
+str_set_t* str_set_new(void) {
+    return str_set_with_capacity_alloc(NULL, 0);
+}
+
+str_set_t* str_set_with_capacity(size_t capacity) {
+    return str_set_with_capacity_alloc(NULL, capacity);
+}
+
+str_set_t* str_set_with_capacity_alloc(const ustring_allocator_t* allocator, size_t capacity) {
+    if (allocator == NULL) {
+        allocator = ustring_get_allocator();
+    }
+
+    str_set_t* self = __ustring_malloc(allocator, sizeof(str_set_t));
+    if (self == NULL) {
+        return NULL;
+    }
+
+    __str_table_init(&self->table, allocator);
+
+    if ((capacity != 0) && !__table_reserve(&self->table, capacity)) {
+        str_set_drop(&self);
+        return NULL;
+    }
+
+    return self;
+}
+
+str_set_t* str_set_from_list(const str_list_t* list) {
+    str_set_t* self = str_set_with_capacity(str_list_size(list));
+    if ((self == NULL) || (list == NULL)) {
+        return self;
+    }
+
+    for (size_t i = 0; i < list->size; i++) {
+        if (str_set_insert(self, list->buffer[i]) != USTRING_OK) {
+            str_set_drop(&self);
+            return NULL;
+        }
+    }
+
+    return self;
+}
+
+void str_set_drop(str_set_t** self) {
+    if ((self == NULL) || (*self == NULL)) {
+        return;
+    }
+
+    __str_table_free(&(*self)->table);
+    __ustring_free((*self)->table.allocator, *self);
+
+    *self = NULL;
+}
+
+size_t str_set_size(const str_set_t* self) {
+    return (self == NULL) ? 0 : self->table.size;
+}
+
+bool str_set_is_empty(const str_set_t* self) {
+    return (self == NULL) || (self->table.size == 0);
+}
+
+int str_set_clear(str_set_t* self) {
+    if (self == NULL) {
+        return USTRING_ERR;
+    }
+
+    __table_clear(&self->table);
+
+    return USTRING_OK;
+}
+
+int str_set_insert(str_set_t* self, const str_t* key) {
+    if ((self == NULL) || (key == NULL)) {
+        return USTRING_ERR;
+    }
+
+    return (__str_table_insert(&self->table, str_as_view(key), str_hash(key)) == STR_TABLE_NPOS)
+        ? USTRING_ERR
+        : USTRING_OK;
+}
+
+int str_set_insert_cstr(str_set_t* self, const char* key) {
+    if (key == NULL) {
+        return USTRING_ERR;
+    }
+
+    return str_set_insert_view(self, str_view_new(key));
+}
+
+int str_set_insert_view(str_set_t* self, str_view_t key) {
+    if (self == NULL) {
+        return USTRING_ERR;
+    }
+
+    return (__table_insert_view(&self->table, key) == STR_TABLE_NPOS)
+        ? USTRING_ERR
+        : USTRING_OK;
+}
+
+bool str_set_contains(const str_set_t* self, const str_t* key) {
+    if ((self == NULL) || (key == NULL)) {
+        return false;
+    }
+
+    return __str_table_find(&self->table, str_as_view(key), str_hash(key)) != STR_TABLE_NPOS;
+}
+
+bool str_set_contains_cstr(const str_set_t* self, const char* key) {
+    return (key != NULL) && str_set_contains_view(self, str_view_new(key));
+}
+
+bool str_set_contains_view(const str_set_t* self, str_view_t key) {
+    if (self == NULL) {
+        return false;
+    }
+
+    return __table_find_view(&self->table, key) != STR_TABLE_NPOS;
+}
+
+bool str_set_erase(str_set_t* self, const str_t* key) {
+    if ((self == NULL) || (key == NULL)) {
+        return false;
+    }
+
+    return __table_erase(&self->table, str_as_view(key), str_hash(key));
+}
+
+bool str_set_erase_cstr(str_set_t* self, const char* key) {
+    return (key != NULL) && str_set_erase_view(self, str_view_new(key));
+}
+
+bool str_set_erase_view(str_set_t* self, str_view_t key) {
+    if (self == NULL) {
+        return false;
+    }
+
+    return __table_erase_view(&self->table, key);
+}
+
+bool str_set_next(const str_set_t* self, size_t* pos, const str_t** key) {
+    size_t idx = 0;
+
+    if ((self == NULL) || !__table_next(&self->table, pos, &idx)) {
+        return false;
+    }
+
+    if (key != NULL) {
+        *key = self->table.slots[idx].key;
+    }
+
+    return true;
+}
@@ -0,0 +1,95 @@
+/******************************************************************************
+ *
+ * @file    str_map_p.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   String Map and String Set library private header file
+ *
+ * Both containers share the hash table with Swiss table layout:
+ * control byte array and slot array. Control byte of every slot is
+ * either EMPTY, DELETED or holds 7 low bits of the key hash (H2),
+ * remaining hash bits (H1) select the group of slots probing starts from.
+ * Control bytes of the first group are mirrored past the end of
+ * the array, so a group may be loaded at any slot index.
+ *
+ *****************************************************************************/
+
+#ifndef __STR_MAP_P_H__
+#define __STR_MAP_P_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <ustring/str_map.h>
+#include "str_p.h"
+
+#define STR_TABLE_GROUP_WIDTH ((size_t) 16)
+#define STR_TABLE_MIN_CAPACITY STR_TABLE_GROUP_WIDTH
+
+#define STR_TABLE_CTRL_EMPTY ((uint8_t) 0x80)
+#define STR_TABLE_CTRL_DELETED ((uint8_t) 0xFE)
+
+#define STR_TABLE_NPOS ((size_t) -1)
+
+struct __str_table_slot {
+    str_t* key;
+    void* value;
+};
+
+struct __str_table {
+    uint8_t* ctrl;                      /**< Control bytes, capacity + group width */
+    struct __str_table_slot* slots;     /**< Slots, capacity */
+    size_t cap;                         /**< Zero or power of two not less than the group width */
+    size_t size;                        /**< Number of keys */
+    size_t growth_left;                 /**< Number of keys that may be inserted into empty slots before rehashing */
+    const ustring_allocator_t* allocator;
+};
+
+struct __str_map {
+    struct __str_table table;
+};
+
+struct __str_set {
+    struct __str_table table;
+};
+
+/**
+ * @brief Initializes an empty table without allocating the slots
+ */
+void __str_table_init(struct __str_table* self, const ustring_allocator_t* allocator);
+
+/**
+ * @brief Drops all keys of the table and frees the slots
+ */
+void __str_table_free(struct __str_table* self);
+
+/**
+ * @brief Computes the table hash of the view key
+ *
+ * Stored keys are strings, so non-ASCII characters of the view are
+ * replaced the same way @c str_from_view does before the key is hashed.
+ * In that case @c key is pointed to the temporary string returned
+ * in @c normalized , which must be dropped by the caller.
+ *
+ * @return @c false on allocation failure
+ */
+bool __str_table_key(const ustring_allocator_t* allocator,
+                     str_view_t* key, uint64_t* hash, str_t** normalized);
+
+/**
+ * @brief Finds the key with the given table hash
+ *
+ * @return Index of the slot of the key; @c STR_TABLE_NPOS if the key is not found
+ */
+size_t __str_table_find(const struct __str_table* self, str_view_t key, uint64_t hash);
+
+/**
+ * @brief Finds the key with the given table hash or inserts its copy into the table
+ *
+ * @return Index of the slot of the key; @c STR_TABLE_NPOS on failure
+ */
+size_t __str_table_insert(struct __str_table* self, str_view_t key, uint64_t hash);
+
+#endif /* __STR_MAP_P_H__ */
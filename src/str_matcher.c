@@ -0,0 +1,500 @@
+/**************************************************************************//**
+ *
+ * @file    str_matcher.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ *****************************************************************************/
+
+#include <string.h>
+
+#include <ustring/str_matcher.h>
+#include "str_matcher_p.h"
+#include "str_p.h"
+#include "str_class_p.h"
+#include "alloc_p.h"
+#include "str_simd_p.h"
+
+#define USTRING_OK  ((int) 0)
+#define USTRING_ERR ((int) 1)
+
+/* Automaton construction */
+
+static uint32_t __matcher_add_state(str_matcher_t* self, uint32_t depth) {
+    const uint32_t state = (uint32_t) (self->state_count * self->row_len);
+    uint32_t* row = &self->table[state];
+
+    row[STR_MATCHER_STOP] = (state == STR_MATCHER_ROOT) ? 1 : 0;
+    row[STR_MATCHER_MATCH_LEN] = 0;
+    row[STR_MATCHER_MATCH_PATTERN] = 0;
+    row[STR_MATCHER_DEPTH] = depth;
+    for (size_t c = 0; c < self->class_count; c++) {
+        row[STR_MATCHER_NEXT + c] = STR_MATCHER_NO_STATE;
+    }
+
+    self->state_count += 1;
+
+    return state;
+}
+
+static void __matcher_insert(str_matcher_t* self, const char* pattern, size_t len, uint32_t idx) {
+    uint32_t state = STR_MATCHER_ROOT;
+
+    for (size_t i = 0; i < len; i++) {
+        const size_t next = state + STR_MATCHER_NEXT + self->byte_class[(unsigned char) pattern[i]];
+
+        if (self->table[next] == STR_MATCHER_NO_STATE) {
+            const uint32_t child = __matcher_add_state(self, self->table[state + STR_MATCHER_DEPTH] + 1);
+            self->table[next] = child;
+        }
+
+        state = self->table[next];
+    }
+
+    /* The first of the equal patterns is reported */
+    if (self->table[state + STR_MATCHER_MATCH_LEN] == 0) {
+        self->table[state + STR_MATCHER_STOP] = 1;
+        self->table[state + STR_MATCHER_MATCH_LEN] = (uint32_t) len;
+        self->table[state + STR_MATCHER_MATCH_PATTERN] = idx;
+    }
+}
+
+/**
+ * @brief Resolves missing trie transitions through the failure links
+ *
+ * States are visited in breadth-first order, so transitions of the
+ * failure state are always resolved before they are borrowed.
+ */
+static bool __matcher_link(str_matcher_t* self) {
+    const size_t class_count = self->class_count;
+    uint32_t* table = self->table;
+    uint32_t* fail = __ustring_malloc(self->allocator, self->state_count * sizeof(uint32_t));
+    uint32_t* queue = __ustring_malloc(self->allocator, self->state_count * sizeof(uint32_t));
+
+    if ((fail == NULL) || (queue == NULL)) {
+        __ustring_free(self->allocator, fail);
+        __ustring_free(self->allocator, queue);
+        return false;
+    }
+
+    size_t head = 0;
+    size_t tail = 0;
+    uint32_t* root_next = &table[STR_MATCHER_ROOT + STR_MATCHER_NEXT];
+
+    for (size_t c = 0; c < class_count; c++) {
+        if (root_next[c] == STR_MATCHER_NO_STATE) {
+            root_next[c] = STR_MATCHER_ROOT;
+        } else {
+            fail[root_next[c] / self->row_len] = STR_MATCHER_ROOT;
+            queue[tail++] = root_next[c];
+        }
+    }
+
+    while (head != tail) {
+        const uint32_t state = queue[head++];
+        const uint32_t state_fail = fail[state / self->row_len];
+        uint32_t* next = &table[state + STR_MATCHER_NEXT];
+        const uint32_t* fail_next = &table[state_fail + STR_MATCHER_NEXT];
+
+        for (size_t c = 0; c < class_count; c++) {
+            const uint32_t child = next[c];
+
+            if (child == STR_MATCHER_NO_STATE) {
+                next[c] = fail_next[c];
+                continue;
+            }
+
+            const uint32_t child_fail = fail_next[c];
+            fail[child / self->row_len] = child_fail;
+
+            if ((table[child + STR_MATCHER_MATCH_LEN] == 0) && (table[child_fail + STR_MATCHER_MATCH_LEN] != 0)) {
+                table[child + STR_MATCHER_STOP] = 1;
+                table[child + STR_MATCHER_MATCH_LEN] = table[child_fail + STR_MATCHER_MATCH_LEN];
+                table[child + STR_MATCHER_MATCH_PATTERN] = table[child_fail + STR_MATCHER_MATCH_PATTERN];
+            }
+
+            queue[tail++] = child;
+        }
+    }
+
+    __ustring_free(self->allocator, fail);
+    __ustring_free(self->allocator, queue);
+
+    return true;
+}
+
+/* Automaton search */
+
+/**
+ * @brief Skips characters no pattern starts with
+ *
+ * Vector span pays off on long gaps only. After a short skip the automaton
+ * runs alone for the next @c STR_MATCHER_SKIP_BACKOFF characters, so dense text
+ * does not pay for the span call at every root state.
+ */
+static inline size_t __matcher_skip(const str_matcher_t* self, const char* text, size_t len,
+                                    size_t idx, size_t* skip_idx)
+{
+    const size_t skipped = __str_class_cspan(&self->first, text + idx, len - idx);
+
+    idx += skipped;
+    *skip_idx = (skipped < STR_MATCHER_SHORT_SKIP) ? idx + STR_MATCHER_SKIP_BACKOFF : idx;
+
+    return idx;
+}
+
+/**
+ * @brief Finds the next leftmost-longest occurrence starting at or after @c search->idx
+ *
+ * First loop runs the automaton until any pattern ends. The earliest
+ * occurrence found is then kept until the automaton depth shows that
+ * no later occurrence can start at or before it. On success search
+ * resumes after the found occurrence.
+ */
+static bool __matcher_find(const str_matcher_t* self, const char* text, size_t len,
+                           struct __str_matcher_search* search, struct __str_matcher_match* match)
+{
+    const uint32_t* table = self->table;
+    const unsigned char* byte_class = self->byte_class;
+    uint32_t state = STR_MATCHER_ROOT;
+    size_t skip_idx = search->skip_idx;
+    size_t idx = search->idx;
+
+    while (table[state + STR_MATCHER_MATCH_LEN] == 0) {
+        if (idx >= len) {
+            search->idx = len;
+            return false;
+        }
+
+        if (idx < skip_idx) {
+            /* Skip suspended: automaton runs alone until a pattern ends */
+            const size_t end = (skip_idx < len) ? skip_idx : len;
+
+            do {
+                state = table[state + STR_MATCHER_NEXT + byte_class[(unsigned char) text[idx]]];
+                idx += 1;
+            } while ((table[state + STR_MATCHER_MATCH_LEN] == 0) && (idx < end));
+
+            continue;
+        }
+
+        if (state == STR_MATCHER_ROOT) {
+            idx = __matcher_skip(self, text, len, idx, &skip_idx);
+            if (idx >= len) {
+                search->idx = len;
+                return false;
+            }
+        }
+
+        /* Automaton runs until a pattern ends or it returns to the root */
+        do {
+            state = table[state + STR_MATCHER_NEXT + byte_class[(unsigned char) text[idx]]];
+            idx += 1;
+        } while ((table[state + STR_MATCHER_STOP] == 0) && (idx < len));
+    }
+
+    match->len = table[state + STR_MATCHER_MATCH_LEN];
+    match->start = idx - match->len;
+    match->pattern = table[state + STR_MATCHER_MATCH_PATTERN];
+
+    while ((idx < len) && (match->start >= idx - table[state + STR_MATCHER_DEPTH])) {
+        state = table[state + STR_MATCHER_NEXT + byte_class[(unsigned char) text[idx]]];
+        idx += 1;
+
+        const size_t match_len = table[state + STR_MATCHER_MATCH_LEN];
+        if ((match_len != 0) && (idx - match_len <= match->start)) {
+            match->start = idx - match_len;
+            match->len = match_len;
+            match->pattern = table[state + STR_MATCHER_MATCH_PATTERN];
+        }
+    }
+
+    search->idx = match->start + match->len;
+    search->skip_idx = skip_idx;
+
+    return true;
+}
+
+/**
+ * @brief Writes the string with the collected occurrences replaced to a new buffer of the exact size
+ *
+ * @return @c true on success; @c false on memory allocation failure
+ */
+static bool __matcher_replace_into(str_t* self, const struct __str_matcher_match* matches, size_t match_count,
+                                   const char* const* replacements, size_t new_len)
+{
+    char* new_buffer = __ustring_malloc(self->allocator, (new_len + 1) * sizeof(char));
+    if (new_buffer == NULL) {
+        return false;
+    }
+
+    size_t read_idx = 0;
+    size_t write_idx = 0;
+
+    for (size_t i = 0; i < match_count; i++) {
+        const size_t chunk_len = matches[i].start - read_idx;
+        const char* replacement = replacements[matches[i].pattern];
+        const size_t replacement_len = __str_literal_len(replacement);
+
+        memcpy(new_buffer + write_idx, self->buffer + read_idx, chunk_len);
+        write_idx += chunk_len;
+
+        __simd_ascii_copy(new_buffer + write_idx, replacement, replacement_len);
+        write_idx += replacement_len;
+        read_idx = matches[i].start + matches[i].len;
+    }
+
+    memcpy(new_buffer + write_idx, self->buffer + read_idx, self->len - read_idx);
+    new_buffer[new_len] = '\0';
+
+    if (!__str_is_inline(self)) {
+        __ustring_free(self->allocator, self->buffer);
+    }
+
+    self->buffer = new_buffer;
+    self->cap = new_len + 1;
+    self->len = new_len;
+
+    return true;
+}
+
+/* Multi-pattern matcher */
+
+str_matcher_t* str_matcher_new(const char* const* patterns, size_t count) {
+    return str_matcher_new_alloc(NULL, patterns, count);
+}
+
+str_matcher_t* str_matcher_new_alloc(const ustring_allocator_t* allocator,
+                                     const char* const* patterns, size_t count)
+{
+    if ((patterns == NULL) && (count != 0)) {
+        return NULL;
+    }
+
+    if (count > (size_t) UINT32_MAX) {
+        return NULL;
+    }
+
+    if (allocator == NULL) {
+        allocator = ustring_get_allocator();
+    }
+
+    str_matcher_t* self = __ustring_malloc(allocator, sizeof(str_matcher_t));
+    if (self == NULL) {
+        return NULL;
+    }
+
+    memset(self, 0, sizeof(str_matcher_t));
+    self->allocator = allocator;
+    self->pattern_count = count;
+
+    self->pattern_len = __ustring_malloc(allocator, ((count == 0) ? 1 : count) * sizeof(size_t));
+    if (self->pattern_len == NULL) {
+        str_matcher_drop(&self);
+        return NULL;
+    }
+
+    /* Characters absent from the patterns share class 0 */
+    char first_chars[256] = {0};
+    size_t first_count = 0;
+    size_t total_len = 0;
+    size_t class_count = 1;
+
+    for (size_t i = 0; i < count; i++) {
+        const char* pattern = patterns[i];
+        const size_t len = __str_literal_len(pattern);
+
+        self->pattern_len[i] = len;
+        total_len += len;
+
+        for (size_t j = 0; j < len; j++) {
+            const unsigned char ch = (unsigned char) pattern[j];
+
+            if (self->byte_class[ch] == 0) {
+                self->byte_class[ch] = (unsigned char) class_count;
+                class_count += 1;
+            }
+        }
+
+        if ((len != 0) && !__str_literal_contains(first_chars, pattern[0])) {
+            first_chars[first_count] = pattern[0];
+            first_count += 1;
+        }
+        first_chars[first_count] = '\0';
+    }
+
+    first_chars[first_count] = '\0';
+    __str_class_init(&self->first, first_chars);
+
+    self->class_count = class_count;
+    self->row_len = STR_MATCHER_NEXT + class_count;
+
+    /* Every character of the patterns adds at most one state, offsets must fit 32 bits */
+    const size_t max_states = total_len + 1;
+    if ((total_len >= (size_t) UINT32_MAX) || (max_states > (size_t) UINT32_MAX / self->row_len)) {
+        str_matcher_drop(&self);
+        return NULL;
+    }
+
+    self->table = __ustring_malloc(allocator, max_states * self->row_len * sizeof(uint32_t));
+    if (self->table == NULL) {
+        str_matcher_drop(&self);
+        return NULL;
+    }
+
+    __matcher_add_state(self, 0);
+
+    for (size_t i = 0; i < count; i++) {
+        if (self->pattern_len[i] != 0) {
+            __matcher_insert(self, patterns[i], self->pattern_len[i], (uint32_t) i);
+        }
+    }
+
+    if (!__matcher_link(self)) {
+        str_matcher_drop(&self);
+        return NULL;
+    }
+
+    return self;
+}
+
+void str_matcher_drop(str_matcher_t** self) {
+    if ((self == NULL) || (*self == NULL)) {
+        return;
+    }
+
+    const ustring_allocator_t* allocator = (*self)->allocator;
+
+    __ustring_free(allocator, (*self)->table);
+    __ustring_free(allocator, (*self)->pattern_len);
+    __ustring_free(allocator, *self);
+    *self = NULL;
+}
+
+size_t str_matcher_size(const str_matcher_t* self) {
+    return (self != NULL) ? self->pattern_count : 0;
+}
+
+bool str_contains_any(const str_t* self, const str_matcher_t* matcher) {
+    if ((self == NULL) || (matcher == NULL)) {
+        return false;
+    }
+
+    struct __str_matcher_search search = {0, 0};
+    struct __str_matcher_match match;
+
+    return __matcher_find(matcher, self->buffer, self->len, &search, &match);
+}
+
+size_t str_find_any(const str_t* self, const str_matcher_t* matcher, size_t* pattern) {
+    if ((self == NULL) || (matcher == NULL)) {
+        return STR_NPOS;
+    }
+
+    struct __str_matcher_search search = {0, 0};
+    struct __str_matcher_match match;
+    if (!__matcher_find(matcher, self->buffer, self->len, &search, &match)) {
+        return STR_NPOS;
+    }
+
+    if (pattern != NULL) {
+        *pattern = match.pattern;
+    }
+
+    return match.start;
+}
+
+int str_replace_many(str_t* self, const str_matcher_t* matcher, const char* const* replacements) {
+    if ((self == NULL) || (matcher == NULL) || (replacements == NULL)) {
+        return USTRING_ERR;
+    }
+
+    __str_hash_invalidate(self);
+
+    struct __str_matcher_search search = {0, 0};
+    struct __str_matcher_match match;
+    if (!__matcher_find(matcher, self->buffer, self->len, &search, &match)) {
+        return USTRING_OK;
+    }
+
+    if (!__str_make_unique(self)) {
+        return USTRING_ERR;
+    }
+
+    bool grows = false;
+    for (size_t i = 0; (i < matcher->pattern_count) && !grows; i++) {
+        grows = __str_literal_len(replacements[i]) > matcher->pattern_len[i];
+    }
+
+    size_t read_idx = 0;
+    size_t write_idx = 0;
+
+    if (!grows) {
+        /* Output never overtakes the input, replace in place */
+        do {
+            const size_t chunk_len = match.start - read_idx;
+            const char* replacement = replacements[match.pattern];
+            const size_t replacement_len = __str_literal_len(replacement);
+
+            if (write_idx != read_idx) {
+                memmove(self->buffer + write_idx, self->buffer + read_idx, chunk_len);
+            }
+            write_idx += chunk_len;
+
+            __simd_ascii_copy(self->buffer + write_idx, replacement, replacement_len);
+            write_idx += replacement_len;
+            read_idx = match.start + match.len;
+        } while (__matcher_find(matcher, self->buffer, self->len, &search, &match));
+
+        memmove(self->buffer + write_idx, self->buffer + read_idx, self->len - read_idx);
+        write_idx += self->len - read_idx;
+
+        self->buffer[write_idx] = '\0';
+        self->len = write_idx;
+
+        return USTRING_OK;
+    }
+
+    /* Collect occurrences to compute the exact length of the result */
+    struct __str_matcher_match stack_matches[STR_MATCHER_STACK_MATCHES];
+    struct __str_matcher_match* matches = stack_matches;
+    size_t match_count = 0;
+    size_t match_cap = STR_MATCHER_STACK_MATCHES;
+    size_t new_len = self->len;
+    bool is_ok = true;
+
+    do {
+        if (match_count == match_cap) {
+            /* Extrapolate the number of occurrences from the scanned part */
+            const size_t estimate = match_count * (self->len / search.idx + 1);
+            const size_t new_cap = (estimate > 2 * match_cap) ? estimate : 2 * match_cap;
+            struct __str_matcher_match* new_matches =
+                __ustring_malloc(self->allocator, new_cap * sizeof(struct __str_matcher_match));
+            if (new_matches == NULL) {
+                is_ok = false;
+                break;
+            }
+
+            memcpy(new_matches, matches, match_count * sizeof(struct __str_matcher_match));
+            if (matches != stack_matches) {
+                __ustring_free(self->allocator, matches);
+            }
+            matches = new_matches;
+            match_cap = new_cap;
+        }
+
+        matches[match_count] = match;
+        match_count += 1;
+        new_len = new_len - match.len + __str_literal_len(replacements[match.pattern]);
+    } while (__matcher_find(matcher, self->buffer, self->len, &search, &match));
+
+    if (is_ok) {
+        is_ok = __matcher_replace_into(self, matches, match_count, replacements, new_len);
+    }
+
+    if (matches != stack_matches) {
+        __ustring_free(self->allocator, matches);
+    }
+
+    return is_ok ? USTRING_OK : USTRING_ERR;
+}
@@ -0,0 +1,72 @@
+/******************************************************************************
+ *
+ * @file    str_matcher_p.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   Multi-pattern Matcher library private header file
+ *
+ * Matcher is the Aho-Corasick automaton compiled into a DFA: trie of
+ * the patterns with failure transitions resolved, so every state has
+ * a transition for every character. Characters are mapped to classes,
+ * all characters absent from the patterns share one class, which keeps
+ * the transition table small. Every state records the longest pattern
+ * ending in it, directly or through the failure links.
+ *
+ * States are rows of the single table: state header followed by
+ * the transitions for every class. State is identified by the offset
+ * of its row, so a transition is a single load without multiplication.
+ *
+ *****************************************************************************/
+
+#ifndef __STR_MATCHER_P_H__
+#define __STR_MATCHER_P_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ustring/str_matcher.h>
+#include <ustring/str_view.h>
+
+#define STR_MATCHER_ROOT ((uint32_t) 0)
+#define STR_MATCHER_NO_STATE ((uint32_t) -1)
+
+/* State row fields */
+#define STR_MATCHER_STOP ((size_t) 0)           /* non-zero for the root and the states ending a pattern */
+#define STR_MATCHER_MATCH_LEN ((size_t) 1)      /* longest pattern ending in the state, 0 if none */
+#define STR_MATCHER_MATCH_PATTERN ((size_t) 2)  /* index of that pattern */
+#define STR_MATCHER_DEPTH ((size_t) 3)          /* length of the state prefix */
+#define STR_MATCHER_NEXT ((size_t) 4)           /* transitions, one per class */
+
+/* Gap shorter than this does not pay off the vector skip ... */
+#define STR_MATCHER_SHORT_SKIP ((size_t) 16)
+/* ... which is then suspended for this many characters */
+#define STR_MATCHER_SKIP_BACKOFF ((size_t) 256)
+
+/* Occurrences collected on the stack before spilling to the heap */
+#define STR_MATCHER_STACK_MATCHES ((size_t) 64)
+
+struct __str_matcher {
+    uint32_t* table;            /* state rows */
+    size_t* pattern_len;        /* length of every pattern */
+    size_t state_count;
+    size_t class_count;
+    size_t row_len;             /* STR_MATCHER_NEXT + class_count */
+    size_t pattern_count;
+    unsigned char byte_class[256];
+    struct __str_class first;   /* first characters of the patterns */
+    const ustring_allocator_t* allocator;
+};
+
+struct __str_matcher_search {
+    size_t idx;                 /* index to resume the search at */
+    size_t skip_idx;            /* index to resume the vector skip at */
+};
+
+struct __str_matcher_match {
+    size_t start;
+    size_t len;
+    size_t pattern;
+};
+
+#endif /* __STR_MATCHER_P_H__ */
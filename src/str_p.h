@@ -11,15 +11,130 @@
 #ifndef __STR_P_H__
 #define __STR_P_H__
 
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include <ustring/str.h>
+#include <ustring/alloc.h>
+
+#ifndef USTRING_INLINE_MAX
+#define USTRING_INLINE_MAX 1024
+#endif
+
 #define STR_DEFAULT_CAPACITY ((size_t) 32)
+#define STR_INLINE_CAPACITY ((size_t) USTRING_INLINE_MAX)
 #define ASCII_LETTER_CASE_CODE_SHIFT ((char) 32)
 
+/*
+ * Strings created with capacity up to STR_INLINE_CAPACITY are allocated
+ * as a single block: the header is followed by the inline buffer of
+ * exactly the string capacity. When such a string outgrows its capacity
+ * characters are moved to a separate heap buffer, the header itself never
+ * moves, so pointers to the string stay valid.
+ * 
+ * Hash of the characters is computed on demand and cached until
+ * the string is modified.
+ * 
+ * Characters of a shared string are stored in the reference-counted
+ * block, which is owned by all copies of the string. Such string buffer
+ * points to the block data and must not be modified until the string
+ * is made unique.
+ */
 struct __str {
     char* buffer;
     size_t len;
     size_t cap;
+    const ustring_allocator_t* allocator;
+    struct __str_shared* shared;
+    _Atomic uint64_t hash;          /* valid if hashed is set */
+    atomic_bool hashed;
+    char inline_buffer[];
 };
 
+/*
+ * Reference-counted block of shared string characters.
+ * Block is freed by the last owner with the owners allocator,
+ * so all owners of the block have the same allocator.
+ */
+struct __str_shared {
+    atomic_size_t refs;
+    char data[];
+};
+
+/**
+ * @brief Checks if string characters are stored in the inline buffer.
+ * 
+ * @param self Pointer to the initialized string instance
+ * @return @c true if string buffer is inline; @c false otherwise
+ */
+#define __str_is_inline(self) ((self)->buffer == (self)->inline_buffer)
+
+/**
+ * @brief Drops the cached hash of the string.
+ * 
+ * Must be called by every function modifying string characters.
+ * 
+ * @param self Pointer to the initialized string instance
+ */
+#define __str_hash_invalidate(self) (                                         \
+    atomic_store_explicit(&(self)->hashed, false, memory_order_relaxed)       \
+)
+
+/**
+ * @brief Reads the cached hash of the string.
+ * 
+ * Cache may be filled by readers of a shared string in other threads,
+ * the flag is acquired so the hash stored before it is visible.
+ * 
+ * @param self Pointer to the initialized string instance
+ * @param hash Pointer receiving the cached hash
+ * @return @c true if the hash is cached; @c false otherwise
+ */
+static inline bool __str_hash_load(const str_t* self, uint64_t* hash) {
+    if (!atomic_load_explicit(&self->hashed, memory_order_acquire)) {
+        return false;
+    }
+
+    *hash = atomic_load_explicit(&self->hash, memory_order_relaxed);
+
+    return true;
+}
+
+/**
+ * @brief Caches the hash of the string.
+ * 
+ * Cache is not a part of the observable string state, so it may be
+ * filled through a const pointer, concurrently with other readers.
+ * The hash is released by the flag store.
+ * 
+ * @param self Pointer to the initialized string instance
+ * @param hash Hash of the string characters
+ */
+static inline void __str_hash_store(const str_t* self, uint64_t hash) {
+    str_t* mutable_self = (str_t*) self;
+    atomic_store_explicit(&mutable_self->hash, hash, memory_order_relaxed);
+    atomic_store_explicit(&mutable_self->hashed, true, memory_order_release);
+}
+
+/**
+ * @brief Gives the string its own characters before modification.
+ * 
+ * Must be called by every function modifying string characters, before
+ * the buffer is written. If string is the only owner of the shared block,
+ * the block is reused as a plain heap buffer, otherwise characters are copied.
+ * 
+ * @param self Pointer to the initialized string instance
+ * @return @c true on success; @c false on memory allocation failure
+ */
+bool __str_make_unique(str_t* self);
+
+/**
+ * Separator characters of @c str_split_whitespace
+ */
+#define STR_WHITESPACE_DELIM " \t\v\n\r"
+
 /**
  * @brief Checks if character is a whitespace character.
  * 
@@ -57,6 +172,19 @@ struct __str {
         && ((unsigned char) (ch) <= 0x7A))                                    \
 )
 
+/**
+ * @brief Ensures the string buffer can hold @c len characters and the null terminator.
+ * 
+ * Buffer capacity is doubled until it fits. Inline buffer
+ * contents are moved to a new heap buffer.
+ * String must not be shared, see @c __str_make_unique .
+ * 
+ * @param self Pointer to the initialized string instance
+ * @param len Required string length
+ * @return @c true on success; @c false on memory allocation failure
+ */
+bool __str_reserve(str_t* self, size_t len);
+
 /**
  * @brief Returns the length of a C string.
  * 
@@ -0,0 +1,602 @@
+/**************************************************************************//**
+ *
+ * @file    str_rope.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ *****************************************************************************/
+
+#include <string.h>
+
+#include <ustring/str_rope.h>
+#include "str_rope_p.h"
+#include "str_p.h"
+#include "alloc_p.h"
+#include "str_simd_p.h"
+
+#define USTRING_OK  ((int) 0)
+#define USTRING_ERR ((int) 1)
+
+typedef struct __str_rope_node __node_t;
+
+#define __node_total(node) (((node) != NULL) ? (node)->total : 0)
+
+/* Tree nodes */
+
+static uint64_t __rope_priority(str_rope_t* self) {
+    /* xorshift64* */
+    self->seed ^= self->seed >> 12;
+    self->seed ^= self->seed << 25;
+    self->seed ^= self->seed >> 27;
+
+    return self->seed * (uint64_t) 0x2545F4914F6CDD1D;
+}
+
+static __node_t* __rope_node_new(str_rope_t* self) {
+    __node_t* node = __ustring_malloc(self->allocator, sizeof(__node_t) + STR_ROPE_CHUNK_SIZE * sizeof(char));
+    if (node == NULL) {
+        return NULL;
+    }
+
+    node->left = NULL;
+    node->right = NULL;
+    node->total = 0;
+    node->len = 0;
+    node->priority = __rope_priority(self);
+
+    return node;
+}
+
+static void __rope_node_free(const ustring_allocator_t* allocator, __node_t* node) {
+    if (node == NULL) {
+        return;
+    }
+
+    __rope_node_free(allocator, node->left);
+    __rope_node_free(allocator, node->right);
+    __ustring_free(allocator, node);
+}
+
+static inline void __rope_update(__node_t* node) {
+    node->total = __node_total(node->left) + node->len + __node_total(node->right);
+}
+
+/**
+ * @brief Merges two trees, all characters of @c a precede characters of @c b
+ */
+static __node_t* __rope_merge(__node_t* a, __node_t* b) {
+    if (a == NULL) {
+        return b;
+    }
+
+    if (b == NULL) {
+        return a;
+    }
+
+    if (a->priority > b->priority) {
+        a->right = __rope_merge(a->right, b);
+        __rope_update(a);
+        return a;
+    } else {
+        b->left = __rope_merge(a, b->left);
+        __rope_update(b);
+        return b;
+    }
+}
+
+/**
+ * @brief Splits the tree into the first @c pos characters and the rest
+ *
+ * If @c pos falls inside a chunk, the tail of the chunk is moved to
+ * the @c spare node, which must be provided in that case.
+ */
+static void __rope_split(__node_t* node, size_t pos, __node_t* spare, __node_t** left, __node_t** right) {
+    if (node == NULL) {
+        *left = NULL;
+        *right = NULL;
+        return;
+    }
+
+    const size_t left_total = __node_total(node->left);
+
+    if (pos <= left_total) {
+        __rope_split(node->left, pos, spare, left, &node->left);
+        __rope_update(node);
+        *right = node;
+    } else if (pos >= left_total + node->len) {
+        __rope_split(node->right, pos - left_total - node->len, spare, &node->right, right);
+        __rope_update(node);
+        *left = node;
+    } else {
+        const size_t offset = pos - left_total;
+
+        spare->len = node->len - offset;
+        memcpy(spare->data, node->data + offset, spare->len);
+        __rope_update(spare);
+
+        node->len = offset;
+        *right = __rope_merge(spare, node->right);
+        node->right = NULL;
+        __rope_update(node);
+        *left = node;
+    }
+}
+
+/**
+ * @brief Finds the chunk holding the character at the given position
+ *
+ * @return Node of the chunk or @c NULL if position is out of bounds
+ */
+static __node_t* __rope_find(__node_t* node, size_t pos, size_t* offset) {
+    while (node != NULL) {
+        const size_t left_total = __node_total(node->left);
+
+        if (pos < left_total) {
+            node = node->left;
+        } else if (pos < left_total + node->len) {
+            *offset = pos - left_total;
+            return node;
+        } else {
+            pos -= left_total + node->len;
+            node = node->right;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Splits the tree at the given position, allocating the spare node if needed
+ *
+ * @return @c true on success; @c false on memory allocation failure, tree is left unchanged
+ */
+static bool __rope_split_at(str_rope_t* self, __node_t* node, size_t pos, __node_t** left, __node_t** right) {
+    size_t offset = 0;
+    __node_t* spare = NULL;
+
+    if ((__rope_find(node, pos, &offset) != NULL) && (offset != 0)) {
+        spare = __rope_node_new(self);
+        if (spare == NULL) {
+            return false;
+        }
+    }
+
+    __rope_split(node, pos, spare, left, right);
+
+    return true;
+}
+
+/**
+ * @brief Inserts characters into the chunk ending at or holding the position if they fit
+ *
+ * The first chunk accepts insertion at position 0.
+ *
+ * @return @c true if characters are inserted; @c false if the chunk has no room
+ */
+static bool __rope_insert_in_place(__node_t* node, size_t pos, const char* chars, size_t len) {
+    if (node == NULL) {
+        return false;
+    }
+
+    const size_t left_total = __node_total(node->left);
+    bool inserted = false;
+
+    if ((node->left != NULL) && (pos <= left_total)) {
+        inserted = __rope_insert_in_place(node->left, pos, chars, len);
+    } else if (pos <= left_total + node->len) {
+        if (node->len + len <= STR_ROPE_CHUNK_SIZE) {
+            const size_t offset = pos - left_total;
+
+            memmove(node->data + offset + len, node->data + offset, node->len - offset);
+            __simd_ascii_copy(node->data + offset, chars, len);
+            node->len += len;
+            inserted = true;
+        }
+    } else {
+        inserted = __rope_insert_in_place(node->right, pos - left_total - node->len, chars, len);
+    }
+
+    if (inserted) {
+        node->total += len;
+    }
+
+    return inserted;
+}
+
+/**
+ * @brief Removes characters from the chunk holding the position if the chunk is not emptied
+ *
+ * @return @c true if characters are removed; @c false if range is not inside the single chunk
+ */
+static bool __rope_erase_in_place(__node_t* node, size_t pos, size_t len) {
+    if (node == NULL) {
+        return false;
+    }
+
+    const size_t left_total = __node_total(node->left);
+    bool erased = false;
+
+    if (pos < left_total) {
+        erased = __rope_erase_in_place(node->left, pos, len);
+    } else if (pos < left_total + node->len) {
+        const size_t offset = pos - left_total;
+
+        if ((offset + len <= node->len) && (len < node->len)) {
+            memmove(node->data + offset, node->data + offset + len, node->len - offset - len);
+            node->len -= len;
+            erased = true;
+        }
+    } else {
+        erased = __rope_erase_in_place(node->right, pos - left_total - node->len, len);
+    }
+
+    if (erased) {
+        node->total -= len;
+    }
+
+    return erased;
+}
+
+/**
+ * @brief Merges two adjacent chunks meeting at the given position if they fit into one
+ */
+static void __rope_coalesce(str_rope_t* self, size_t pos) {
+    if ((pos == 0) || (pos >= __node_total(self->root))) {
+        return;
+    }
+
+    size_t offset_a = 0;
+    size_t offset_b = 0;
+    const __node_t* a = __rope_find(self->root, pos - 1, &offset_a);
+    const __node_t* b = __rope_find(self->root, pos, &offset_b);
+
+    if ((a == b) || (offset_b != 0) || (a->len + b->len > STR_ROPE_CHUNK_SIZE)) {
+        return;
+    }
+
+    /* Characters of B are appended to A, then B is cut out of the tree */
+    const size_t len = b->len;
+    __rope_insert_in_place(self->root, pos, b->data, len);
+
+    __node_t* left = NULL;
+    __node_t* middle = NULL;
+    __node_t* right = NULL;
+
+    __rope_split(self->root, pos + len, NULL, &left, &right);
+    __rope_split(right, len, NULL, &middle, &right);
+    __rope_node_free(self->allocator, middle);
+
+    self->root = __rope_merge(left, right);
+}
+
+/**
+ * @brief Merges chunks around the position after the chunks meeting there were shortened
+ *
+ * Checks the seam at the position and the outer seams of both chunks meeting there.
+ */
+static void __rope_coalesce_around(str_rope_t* self, size_t pos) {
+    size_t offset = 0;
+    const __node_t* node = __rope_find(self->root, pos, &offset);
+
+    if (node != NULL) {
+        __rope_coalesce(self, pos - offset + node->len);
+    }
+
+    __rope_coalesce(self, pos);
+
+    if ((pos != 0) && ((node = __rope_find(self->root, pos - 1, &offset)) != NULL)) {
+        __rope_coalesce(self, pos - 1 - offset);
+    }
+}
+
+/**
+ * @brief Copies characters into a new tree of chunks
+ *
+ * @return @c true on success; @c false on memory allocation failure
+ */
+static bool __rope_build(str_rope_t* self, const char* chars, size_t len, __node_t** tree) {
+    __node_t* result = NULL;
+
+    while (len != 0) {
+        __node_t* node = __rope_node_new(self);
+        if (node == NULL) {
+            __rope_node_free(self->allocator, result);
+            return false;
+        }
+
+        node->len = (len < STR_ROPE_CHUNK_SIZE) ? len : STR_ROPE_CHUNK_SIZE;
+        __simd_ascii_copy(node->data, chars, node->len);
+        __rope_update(node);
+
+        result = __rope_merge(result, node);
+        chars += node->len;
+        len -= node->len;
+    }
+
+    *tree = result;
+
+    return true;
+}
+
+static void __rope_fill(const __node_t* node, char* buffer) {
+    while (node != NULL) {
+        __rope_fill(node->left, buffer);
+        buffer += __node_total(node->left);
+
+        memcpy(buffer, node->data, node->len);
+        buffer += node->len;
+
+        node = node->right;
+    }
+}
+
+/* String rope */
+
+str_rope_t* str_rope_new(void) {
+    return str_rope_new_alloc(NULL);
+}
+
+str_rope_t* str_rope_new_alloc(const ustring_allocator_t* allocator) {
+    if (allocator == NULL) {
+        allocator = ustring_get_allocator();
+    }
+
+    str_rope_t* self = __ustring_malloc(allocator, sizeof(str_rope_t));
+    if (self == NULL) {
+        return NULL;
+    }
+
+    self->root = NULL;
+    self->allocator = allocator;
+    self->seed = STR_ROPE_PRIORITY_SEED;
+
+    return self;
+}
+
+str_rope_t* str_rope_from_view(str_view_t view) {
+    return str_rope_from_view_alloc(NULL, view);
+}
+
+str_rope_t* str_rope_from_view_alloc(const ustring_allocator_t* allocator, str_view_t view) {
+    str_rope_t* self = str_rope_new_alloc(allocator);
+    if (self == NULL) {
+        return NULL;
+    }
+
+    if ((view.ptr != NULL) && !__rope_build(self, view.ptr, view.len, &self->root)) {
+        str_rope_drop(&self);
+        return NULL;
+    }
+
+    return self;
+}
+
+void str_rope_drop(str_rope_t** self) {
+    if ((self == NULL) || (*self == NULL)) {
+        return;
+    }
+
+    const ustring_allocator_t* allocator = (*self)->allocator;
+
+    __rope_node_free(allocator, (*self)->root);
+    __ustring_free(allocator, *self);
+    *self = NULL;
+}
+
+size_t str_rope_len(const str_rope_t* self) {
+    return (self != NULL) ? __node_total(self->root) : 0;
+}
+
+char str_rope_at(const str_rope_t* self, size_t pos) {
+    if (self == NULL) {
+        return 0;
+    }
+
+    size_t offset = 0;
+    const __node_t* node = __rope_find(self->root, pos, &offset);
+
+    return (node != NULL) ? node->data[offset] : 0;
+}
+
+int str_rope_insert(str_rope_t* self, size_t pos, str_view_t text) {
+    if ((self == NULL) || (pos > __node_total(self->root))) {
+        return USTRING_ERR;
+    }
+
+    if ((text.ptr == NULL) || (text.len == 0)) {
+        return USTRING_OK;
+    }
+
+    if (__rope_insert_in_place(self->root, pos, text.ptr, text.len)) {
+        return USTRING_OK;
+    }
+
+    __node_t* middle = NULL;
+    __node_t* left = NULL;
+    __node_t* right = NULL;
+
+    if (!__rope_build(self, text.ptr, text.len, &middle)) {
+        return USTRING_ERR;
+    }
+
+    if (!__rope_split_at(self, self->root, pos, &left, &right)) {
+        __rope_node_free(self->allocator, middle);
+        return USTRING_ERR;
+    }
+
+    self->root = __rope_merge(__rope_merge(left, middle), right);
+
+    __rope_coalesce_around(self, pos + text.len);
+    __rope_coalesce_around(self, pos);
+
+    return USTRING_OK;
+}
+
+int str_rope_append(str_rope_t* self, str_view_t text) {
+    return str_rope_insert(self, str_rope_len(self), text);
+}
+
+int str_rope_erase(str_rope_t* self, size_t pos, size_t len) {
+    if (self == NULL) {
+        return USTRING_ERR;
+    }
+
+    const size_t total = __node_total(self->root);
+
+    if (pos > total) {
+        return USTRING_ERR;
+    }
+
+    if (len > total - pos) {
+        len = total - pos;
+    }
+
+    if (len == 0) {
+        return USTRING_OK;
+    }
+
+    size_t offset = 0;
+    const __node_t* node = __rope_find(self->root, pos, &offset);
+
+    if (__rope_erase_in_place(self->root, pos, len)) {
+        /* Shortened chunk may fit into one of its neighbours */
+        const size_t start = pos - offset;
+        __rope_coalesce(self, start + node->len);
+        __rope_coalesce(self, start);
+        return USTRING_OK;
+    }
+
+    __node_t* left = NULL;
+    __node_t* middle = NULL;
+    __node_t* right = NULL;
+    __node_t* spare = NULL;
+
+    /* Both spare nodes are allocated before the tree is modified */
+    if ((__rope_find(self->root, pos + len, &offset) != NULL) && (offset != 0)) {
+        spare = __rope_node_new(self);
+        if (spare == NULL) {
+            return USTRING_ERR;
+        }
+    }
+
+    if (!__rope_split_at(self, self->root, pos, &left, &middle)) {
+        __rope_node_free(self->allocator, spare);
+        return USTRING_ERR;
+    }
+
+    __rope_split(middle, len, spare, &middle, &right);
+    __rope_node_free(self->allocator, middle);
+
+    self->root = __rope_merge(left, right);
+
+    __rope_coalesce_around(self, pos);
+
+    return USTRING_OK;
+}
+
+int str_rope_replace(str_rope_t* self, size_t pos, size_t len, str_view_t text) {
+    if (str_rope_erase(self, pos, len) != USTRING_OK) {
+        return USTRING_ERR;
+    }
+
+    return str_rope_insert(self, pos, text);
+}
+
+int str_rope_concat(str_rope_t* self, str_rope_t* other) {
+    if ((self == NULL) || (other == NULL) || (self == other) || (self->allocator != other->allocator)) {
+        return USTRING_ERR;
+    }
+
+    const size_t seam = __node_total(self->root);
+
+    self->root = __rope_merge(self->root, other->root);
+    other->root = NULL;
+
+    __rope_coalesce(self, seam);
+
+    return USTRING_OK;
+}
+
+str_rope_t* str_rope_split_off(str_rope_t* self, size_t pos) {
+    if ((self == NULL) || (pos > __node_total(self->root))) {
+        return NULL;
+    }
+
+    str_rope_t* tail = str_rope_new_alloc(self->allocator);
+    if (tail == NULL) {
+        return NULL;
+    }
+
+    if (!__rope_split_at(self, self->root, pos, &self->root, &tail->root)) {
+        str_rope_drop(&tail);
+        return NULL;
+    }
+
+    __rope_coalesce_around(self, pos);
+    __rope_coalesce_around(tail, 0);
+
+    return tail;
+}
+
+str_rope_t* str_rope_substr(const str_rope_t* self, size_t pos, size_t len) {
+    if ((self == NULL) || (pos > __node_total(self->root))) {
+        return NULL;
+    }
+
+    str_rope_t* result = str_rope_new_alloc(self->allocator);
+    if (result == NULL) {
+        return NULL;
+    }
+
+    str_view_t chunk;
+    while ((len != 0) && str_rope_next_chunk(self, &pos, &chunk)) {
+        if (chunk.len > len) {
+            chunk.len = len;
+        }
+
+        if (str_rope_append(result, chunk) != USTRING_OK) {
+            str_rope_drop(&result);
+            return NULL;
+        }
+
+        len -= chunk.len;
+    }
+
+    return result;
+}
+
+bool str_rope_next_chunk(const str_rope_t* self, size_t* pos, str_view_t* chunk) {
+    if ((self == NULL) || (pos == NULL) || (chunk == NULL)) {
+        return false;
+    }
+
+    size_t offset = 0;
+    const __node_t* node = __rope_find(self->root, *pos, &offset);
+    if (node == NULL) {
+        return false;
+    }
+
+    *chunk = str_view_from_parts(node->data + offset, node->len - offset);
+    *pos += chunk->len;
+
+    return true;
+}
+
+str_t* str_rope_to_str(const str_rope_t* self) {
+    if (self == NULL) {
+        return str_new(NULL);
+    }
+
+    const size_t len = __node_total(self->root);
+
+    str_t* result = str_with_capacity_alloc(self->allocator, len + 1);
+    if (result == NULL) {
+        return NULL;
+    }
+
+    __rope_fill(self->root, result->buffer);
+    result->buffer[len] = '\0';
+    result->len = len;
+
+    return result;
+}
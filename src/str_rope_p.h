@@ -0,0 +1,47 @@
+/******************************************************************************
+ *
+ * @file    str_rope_p.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   String Rope library private header file
+ *
+ * Rope is an implicit treap: binary tree of chunks ordered by the
+ * position of their characters, each node keeps the number of characters
+ * in its subtree, so the chunk holding a position is found by a single
+ * descent. Node priorities are random and form a max-heap, which keeps
+ * the expected tree depth logarithmic. Splitting the tree at a position
+ * and merging two trees only relink nodes along one path.
+ *
+ *****************************************************************************/
+
+#ifndef __STR_ROPE_P_H__
+#define __STR_ROPE_P_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ustring/str_rope.h>
+
+#define STR_ROPE_PRIORITY_SEED ((uint64_t) 0x9E3779B97F4A7C15)
+
+/*
+ * Every node has the chunk buffer of STR_ROPE_CHUNK_SIZE characters,
+ * chunks are never empty.
+ */
+struct __str_rope_node {
+    struct __str_rope_node* left;
+    struct __str_rope_node* right;
+    size_t total;
+    size_t len;
+    uint64_t priority;
+    char data[];
+};
+
+struct __str_rope {
+    struct __str_rope_node* root;
+    const ustring_allocator_t* allocator;
+    uint64_t seed;
+};
+
+#endif /* __STR_ROPE_P_H__ */
@@ -0,0 +1,141 @@
+/**************************************************************************//**
+ *
+ * @file    str_search.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ *****************************************************************************/
+
+#include <limits.h>
+#include <string.h>
+
+#include "str_search_p.h"
+#include "str_simd_p.h"
+#include "str_p.h"
+#include "alloc_p.h"
+
+static void __str_horspool_init(size_t* shift, const char* needle, size_t needle_len) {
+    for (size_t i = 0; i <= UCHAR_MAX; i++) {
+        shift[i] = needle_len;
+    }
+
+    for (size_t i = 0; i < (needle_len - 1); i++) {
+        shift[(unsigned char) needle[i]] = needle_len - 1 - i;
+    }
+}
+
+static size_t __str_find_horspool(const char* haystack, size_t haystack_len,
+                                  const char* needle, size_t needle_len, const size_t* shift)
+{
+    const char last = needle[needle_len - 1];
+    size_t pos = 0;
+
+    while (pos <= (haystack_len - needle_len)) {
+        const char ch = haystack[pos + needle_len - 1];
+
+        if ((ch == last) && (memcmp(haystack + pos, needle, needle_len - 1) == 0)) {
+            return pos;
+        }
+
+        pos += shift[(unsigned char) ch];
+    }
+
+    return STR_NPOS;
+}
+
+size_t __str_find_pattern(const char* haystack, size_t haystack_len, const struct __str_pattern* pattern) {
+    const char* needle = pattern->needle;
+    const size_t needle_len = pattern->len;
+
+    if (needle_len == 0) {
+        return 0;
+    } else if (needle_len > haystack_len) {
+        return STR_NPOS;
+    }
+
+    const char* match = NULL;
+
+    if (needle_len == 1) {
+        match = __simd_find_char(haystack, haystack_len, needle[0]);
+    } else if (needle_len <= STR_SEARCH_SHORT_PATTERN_MAX) {
+        match = __simd_find_substr(haystack, haystack_len, needle, needle_len);
+    } else if (pattern->shift != NULL) {
+        return __str_find_horspool(haystack, haystack_len, needle, needle_len, pattern->shift);
+    } else {
+        size_t shift[UCHAR_MAX + 1];
+        __str_horspool_init(shift, needle, needle_len);
+
+        return __str_find_horspool(haystack, haystack_len, needle, needle_len, shift);
+    }
+
+    return (match != NULL) ? (size_t) (match - haystack) : STR_NPOS;
+}
+
+size_t __str_find(const char* haystack, size_t haystack_len,
+                  const char* needle, size_t needle_len)
+{
+    const struct __str_pattern pattern = __str_pattern_borrow(needle, needle_len);
+
+    return __str_find_pattern(haystack, haystack_len, &pattern);
+}
+
+/* Compiled pattern */
+
+str_pattern_t* str_pattern_compile(const char* pattern) {
+    return str_pattern_compile_alloc(NULL, pattern);
+}
+
+str_pattern_t* str_pattern_compile_alloc(const ustring_allocator_t* allocator, const char* pattern) {
+    if (pattern == NULL) {
+        return NULL;
+    }
+
+    if (allocator == NULL) {
+        allocator = ustring_get_allocator();
+    }
+
+    const size_t len = __str_literal_len(pattern);
+    const size_t shift_count = (len > STR_SEARCH_SHORT_PATTERN_MAX) ? (UCHAR_MAX + 1) : 0;
+
+    /* Header, shift table and characters share one memory block */
+    str_pattern_t* self = __ustring_malloc(
+        allocator, sizeof(str_pattern_t) + shift_count * sizeof(size_t) + (len + 1) * sizeof(char));
+    if (self == NULL) {
+        return NULL;
+    }
+
+    size_t* shift = (size_t*) (self + 1);
+    char* needle = (char*) (shift + shift_count);
+
+    /* Raw bytes, as the borrowed patterns of the plain functions */
+    memcpy(needle, pattern, len);
+    needle[len] = '\0';
+
+    if (shift_count != 0) {
+        __str_horspool_init(shift, needle, len);
+    }
+
+    self->needle = needle;
+    self->len = len;
+    self->shift = (shift_count != 0) ? shift : NULL;
+    self->allocator = allocator;
+
+    return self;
+}
+
+void str_pattern_drop(str_pattern_t** self) {
+    if ((self == NULL) || (*self == NULL)) {
+        return;
+    }
+
+    __ustring_free((*self)->allocator, *self);
+    *self = NULL;
+}
+
+size_t str_pattern_len(const str_pattern_t* self) {
+    return (self != NULL) ? self->len : 0;
+}
+
+const char* str_pattern_as_ptr(const str_pattern_t* self) {
+    return (self != NULL) ? self->needle : NULL;
+}
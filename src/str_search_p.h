@@ -0,0 +1,76 @@
+/******************************************************************************
+ *
+ * @file    str_search_p.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   Substring search engine private header file
+ *
+ *****************************************************************************/
+
+#ifndef __STR_SEARCH_P_H__
+#define __STR_SEARCH_P_H__
+
+#include <stddef.h>
+
+#include <ustring/str.h>
+#include <ustring/str_pattern.h>
+
+/**
+ * Patterns longer than this are searched with the Boyer-Moore-Horspool
+ * algorithm, shorter ones with the vectorized first/last character filter.
+ */
+#define STR_SEARCH_SHORT_PATTERN_MAX ((size_t) 32)
+
+/*
+ * Pattern prepared for the search. Compiled patterns own the copy of
+ * their characters and the Horspool shift table of long patterns, which
+ * are stored in the same memory block. Patterns built for a single call
+ * borrow the characters and have no shift table.
+ */
+struct __str_pattern {
+    const char* needle;
+    size_t len;
+    const size_t* shift;                    /* Horspool shift table, NULL if not compiled */
+    const ustring_allocator_t* allocator;   /* NULL if pattern is not owned */
+};
+
+/**
+ * @brief Makes the pattern of the given characters for a single call
+ */
+#define __str_pattern_borrow(needle, needle_len) \
+    ((struct __str_pattern) { (needle), (needle_len), NULL, NULL })
+
+/**
+ * @brief Finds the first occurrence of the pattern in the character sequence
+ *
+ * Same as @c __str_find , but the Horspool shift table of long compiled
+ * patterns is not built again.
+ *
+ * @param haystack Characters to search in
+ * @param haystack_len Number of characters in @c haystack
+ * @param pattern Pattern to search for
+ * @return Index of the first occurrence of the pattern; @c STR_NPOS if not found.
+ *      Empty pattern is found at index 0
+ */
+size_t __str_find_pattern(const char* haystack, size_t haystack_len, const struct __str_pattern* pattern);
+
+/**
+ * @brief Finds the first occurrence of the pattern in the character sequence
+ *
+ * Search strategy depends on the pattern length:
+ *      - single character patterns are searched with vectorized character scan
+ *      - short patterns are searched with vectorized first/last character filter
+ *      - long patterns are searched with the Boyer-Moore-Horspool algorithm
+ *
+ * @param haystack Characters to search in
+ * @param haystack_len Number of characters in @c haystack
+ * @param needle Pattern characters
+ * @param needle_len Pattern length
+ * @return Index of the first occurrence of the pattern; @c STR_NPOS if not found.
+ *      Empty pattern is found at index 0
+ */
+size_t __str_find(const char* haystack, size_t haystack_len,
+                  const char* needle, size_t needle_len);
+
+#endif /* __STR_SEARCH_P_H__ */
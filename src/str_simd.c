@@ -0,0 +1,808 @@
+/**************************************************************************//**
+ *
+ * @file    str_simd.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ *****************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "str_simd_p.h"
+
+#if USTRING_SIMD_X86
+#include <immintrin.h>
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#define SIMD_TARGET_SSSE3 __attribute__((target("ssse3")))
+#endif
+
+/*
+ * Null terminator scans read whole aligned blocks, which may extend past
+ * the terminator but never cross a page boundary. Such reads are reported
+ * by the address sanitizer, so it is disabled for these kernels.
+ */
+#if defined(__clang__) || defined(__GNUC__)
+#define SIMD_NO_SANITIZE __attribute__((no_sanitize_address))
+#else
+#define SIMD_NO_SANITIZE
+#endif
+
+#define SWAR_ONES   ((uint64_t) 0x0101010101010101ULL)
+#define SWAR_HIGHS  ((uint64_t) 0x8080808080808080ULL)
+
+#define ASCII_REPLACEMENT_CHAR ('?')
+#define ASCII_CASE_BIT (0x20)
+
+static inline uint64_t __load_word(const char* ptr) {
+    uint64_t word;
+    memcpy(&word, ptr, sizeof(word));
+    return word;
+}
+
+static inline bool __has_avx2(void) {
+#if USTRING_SIMD_X86
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+static inline bool __has_ssse3(void) {
+#if USTRING_SIMD_X86
+    return __builtin_cpu_supports("ssse3");
+#else
+    return false;
+#endif
+}
+
+/* Portable kernels */
+
+#if !USTRING_SIMD_X86
+SIMD_NO_SANITIZE
+static size_t __strlen_swar(const char* string) {
+    const char* ptr = string;
+    uint64_t word = 0;
+
+    while (((uintptr_t) ptr % sizeof(uint64_t)) != 0) {
+        if (*ptr == '\0') {
+            return ptr - string;
+        }
+        ptr += 1;
+    }
+
+    for (;;) {
+        memcpy(&word, ptr, sizeof(word));
+        if (((word - SWAR_ONES) & ~word & SWAR_HIGHS) != 0) {
+            break;
+        }
+        ptr += sizeof(uint64_t);
+    }
+
+    while (*ptr != '\0') {
+        ptr += 1;
+    }
+
+    return ptr - string;
+}
+#endif /* !USTRING_SIMD_X86 */
+
+static void __ascii_copy_swar(char* dst, const char* src, size_t len) {
+    size_t i = 0;
+
+    for (; (i + sizeof(uint64_t)) <= len; i += sizeof(uint64_t)) {
+        const uint64_t word = __load_word(src + i);
+        if ((word & SWAR_HIGHS) == 0) {
+            memcpy(dst + i, &word, sizeof(word));
+        } else {
+            for (size_t j = i; j < (i + sizeof(uint64_t)); j++) {
+                dst[j] = ((unsigned char) src[j] <= 0x7F) ? src[j] : ASCII_REPLACEMENT_CHAR;
+            }
+        }
+    }
+
+    for (; i < len; i++) {
+        dst[i] = ((unsigned char) src[i] <= 0x7F) ? src[i] : ASCII_REPLACEMENT_CHAR;
+    }
+}
+
+static const char* __find_substr_scalar(const char* haystack, size_t haystack_len,
+                                        const char* needle, size_t needle_len)
+{
+    const char last = needle[needle_len - 1];
+    const char* ptr = haystack;
+    const char* const bound = haystack + (haystack_len - needle_len) + 1;
+
+    while (ptr < bound) {
+        ptr = memchr(ptr, needle[0], bound - ptr);
+        if (ptr == NULL) {
+            return NULL;
+        }
+
+        if ((ptr[needle_len - 1] == last)
+                && (memcmp(ptr + 1, needle + 1, needle_len - 2) == 0))
+        {
+            return ptr;
+        }
+
+        ptr += 1;
+    }
+
+    return NULL;
+}
+
+static size_t __mismatch_swar(const char* a, const char* b, size_t len) {
+    size_t i = 0;
+
+    for (; (i + sizeof(uint64_t)) <= len; i += sizeof(uint64_t)) {
+        if (__load_word(a + i) != __load_word(b + i)) {
+            break;
+        }
+    }
+
+    for (; i < len; i++) {
+        if (a[i] != b[i]) {
+            return i;
+        }
+    }
+
+    return len;
+}
+
+static inline char __fold_case(char ch) {
+    return ((ch >= 'A') && (ch <= 'Z')) ? (char) (ch + ASCII_CASE_BIT) : ch;
+}
+
+/*
+ * Case bit if the character is a letter, zero otherwise. Setting the case bit
+ * of any character gives the lower case letter only for that letter in either case,
+ * so the character is matched ignoring case with a single OR and comparison.
+ */
+static inline char __case_bit(char ch) {
+    return (((ch | ASCII_CASE_BIT) >= 'a') && ((ch | ASCII_CASE_BIT) <= 'z')) ? ASCII_CASE_BIT : 0;
+}
+
+/* Case bit of every ASCII character of the word in the [first, last] range */
+static inline uint64_t __case_bits_swar(uint64_t word, char first, char last) {
+    const uint64_t ascii = word & ~SWAR_HIGHS;
+    const uint64_t not_below = ascii + SWAR_ONES * (uint64_t) (0x80 - first);
+    const uint64_t above = ascii + SWAR_ONES * (uint64_t) (0x7F - last);
+
+    return (not_below & ~above & ~word & SWAR_HIGHS) >> 2;
+}
+
+static void __case_convert_swar(char* dst, const char* src, size_t len, bool upper) {
+    const char first = upper ? 'a' : 'A';
+    const char last = upper ? 'z' : 'Z';
+    size_t i = 0;
+
+    for (; (i + sizeof(uint64_t)) <= len; i += sizeof(uint64_t)) {
+        uint64_t word = __load_word(src + i);
+        word ^= __case_bits_swar(word, first, last);
+        memcpy(dst + i, &word, sizeof(word));
+    }
+
+    for (; i < len; i++) {
+        const char ch = src[i];
+        dst[i] = ((ch >= first) && (ch <= last)) ? (char) (ch ^ ASCII_CASE_BIT) : ch;
+    }
+}
+
+static size_t __mismatch_ignore_case_swar(const char* a, const char* b, size_t len) {
+    size_t i = 0;
+
+    for (; (i + sizeof(uint64_t)) <= len; i += sizeof(uint64_t)) {
+        const uint64_t word_a = __load_word(a + i);
+        const uint64_t word_b = __load_word(b + i);
+
+        if ((word_a != word_b)
+                && ((word_a ^ __case_bits_swar(word_a, 'A', 'Z'))
+                    != (word_b ^ __case_bits_swar(word_b, 'A', 'Z'))))
+        {
+            break;
+        }
+    }
+
+    for (; i < len; i++) {
+        if (__fold_case(a[i]) != __fold_case(b[i])) {
+            return i;
+        }
+    }
+
+    return len;
+}
+
+static const char* __find_substr_ignore_case_scalar(const char* haystack, size_t haystack_len,
+                                                    const char* needle, size_t needle_len)
+{
+    const char first = __fold_case(needle[0]);
+
+    for (size_t i = 0; (i + needle_len) <= haystack_len; i++) {
+        if ((__fold_case(haystack[i]) == first)
+                && (__mismatch_ignore_case_swar(haystack + i, needle, needle_len) == needle_len))
+        {
+            return haystack + i;
+        }
+    }
+
+    return NULL;
+}
+
+#if USTRING_SIMD_X86
+
+/* SSE2 kernels */
+
+SIMD_NO_SANITIZE
+static size_t __strlen_sse2(const char* string) {
+    const size_t misalign = (uintptr_t) string % 16;
+    const __m128i* block = (const __m128i*) (string - misalign);
+    const __m128i zero = _mm_setzero_si128();
+
+    unsigned int mask = (unsigned int) _mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_load_si128(block), zero)) >> misalign;
+
+    if (mask != 0) {
+        return (size_t) __builtin_ctz(mask);
+    }
+
+    for (;;) {
+        block += 1;
+        mask = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(block), zero));
+        if (mask != 0) {
+            return (size_t) ((const char*) block - string) + __builtin_ctz(mask);
+        }
+    }
+}
+
+static inline __m128i __ascii_normalize_sse2(__m128i chunk) {
+    const __m128i non_ascii = _mm_cmplt_epi8(chunk, _mm_setzero_si128());
+    return _mm_or_si128(
+        _mm_andnot_si128(non_ascii, chunk),
+        _mm_and_si128(non_ascii, _mm_set1_epi8(ASCII_REPLACEMENT_CHAR)));
+}
+
+static void __ascii_copy_sse2(char* dst, const char* src, size_t len) {
+    size_t i = 0;
+
+    for (; (i + 16) <= len; i += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*) (src + i));
+        if (_mm_movemask_epi8(chunk) != 0) {
+            chunk = __ascii_normalize_sse2(chunk);
+        }
+        _mm_storeu_si128((__m128i*) (dst + i), chunk);
+    }
+
+    __ascii_copy_swar(dst + i, src + i, len - i);
+}
+
+static const char* __find_char_sse2(const char* haystack, size_t len, char ch) {
+    const __m128i needle = _mm_set1_epi8(ch);
+    size_t i = 0;
+
+    for (; (i + 16) <= len; i += 16) {
+        const __m128i chunk = _mm_loadu_si128((const __m128i*) (haystack + i));
+        const unsigned int mask = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+        if (mask != 0) {
+            return haystack + i + __builtin_ctz(mask);
+        }
+    }
+
+    for (; i < len; i++) {
+        if (haystack[i] == ch) {
+            return haystack + i;
+        }
+    }
+
+    return NULL;
+}
+
+static const char* __find_substr_sse2(const char* haystack, size_t haystack_len,
+                                      const char* needle, size_t needle_len)
+{
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[needle_len - 1]);
+    size_t i = 0;
+
+    for (; (i + needle_len - 1 + 16) <= haystack_len; i += 16) {
+        const __m128i block_first = _mm_loadu_si128((const __m128i*) (haystack + i));
+        const __m128i block_last = _mm_loadu_si128((const __m128i*) (haystack + i + needle_len - 1));
+
+        unsigned int mask = (unsigned int) _mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(block_first, first),
+            _mm_cmpeq_epi8(block_last, last)));
+
+        while (mask != 0) {
+            const char* candidate = haystack + i + __builtin_ctz(mask);
+            if (memcmp(candidate + 1, needle + 1, needle_len - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    if ((i + needle_len) > haystack_len) {
+        return NULL;
+    }
+
+    return __find_substr_scalar(haystack + i, haystack_len - i, needle, needle_len);
+}
+
+static inline unsigned int __diff_mask_sse2(const char* a, const char* b) {
+    const __m128i chunk_a = _mm_loadu_si128((const __m128i*) a);
+    const __m128i chunk_b = _mm_loadu_si128((const __m128i*) b);
+    return ~(unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk_a, chunk_b)) & 0xFFFF;
+}
+
+static size_t __mismatch_sse2(const char* a, const char* b, size_t len) {
+    if (len < 16) {
+        return __mismatch_swar(a, b, len);
+    }
+
+    size_t i = 0;
+    unsigned int mask = 0;
+
+    for (; (i + 16) <= len; i += 16) {
+        mask = __diff_mask_sse2(a + i, b + i);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    /* Partial last block is compared overlapping the previous one */
+    if (i < len) {
+        i = len - 16;
+        mask = __diff_mask_sse2(a + i, b + i);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    return len;
+}
+
+/* Case bit of every character in the [first, last] range, signed compares exclude non-ASCII */
+static inline __m128i __case_bits_sse2(__m128i chunk, char first, char last) {
+    const __m128i in_range = _mm_and_si128(
+        _mm_cmpgt_epi8(chunk, _mm_set1_epi8((char) (first - 1))),
+        _mm_cmplt_epi8(chunk, _mm_set1_epi8((char) (last + 1))));
+    return _mm_and_si128(in_range, _mm_set1_epi8(ASCII_CASE_BIT));
+}
+
+static inline __m128i __fold_case_sse2(__m128i chunk) {
+    return _mm_add_epi8(chunk, __case_bits_sse2(chunk, 'A', 'Z'));
+}
+
+static void __case_convert_sse2(char* dst, const char* src, size_t len, bool upper) {
+    const char first = upper ? 'a' : 'A';
+    const char last = upper ? 'z' : 'Z';
+    size_t i = 0;
+
+    for (; (i + 16) <= len; i += 16) {
+        const __m128i chunk = _mm_loadu_si128((const __m128i*) (src + i));
+        _mm_storeu_si128((__m128i*) (dst + i), _mm_xor_si128(chunk, __case_bits_sse2(chunk, first, last)));
+    }
+
+    __case_convert_swar(dst + i, src + i, len - i, upper);
+}
+
+static size_t __mismatch_ignore_case_sse2(const char* a, const char* b, size_t len) {
+    size_t i = 0;
+
+    for (; (i + 16) <= len; i += 16) {
+        const __m128i chunk_a = _mm_loadu_si128((const __m128i*) (a + i));
+        const __m128i chunk_b = _mm_loadu_si128((const __m128i*) (b + i));
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(chunk_a, chunk_b)) != 0xFFFF) {
+            const unsigned int mask = ~(unsigned int) _mm_movemask_epi8(
+                _mm_cmpeq_epi8(__fold_case_sse2(chunk_a), __fold_case_sse2(chunk_b))) & 0xFFFF;
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+    }
+
+    return i + __mismatch_ignore_case_swar(a + i, b + i, len - i);
+}
+
+static const char* __find_substr_ignore_case_sse2(const char* haystack, size_t haystack_len,
+                                                  const char* needle, size_t needle_len)
+{
+    const __m128i first = _mm_set1_epi8(__fold_case(needle[0]));
+    const __m128i last = _mm_set1_epi8(__fold_case(needle[needle_len - 1]));
+    const __m128i first_case = _mm_set1_epi8(__case_bit(needle[0]));
+    const __m128i last_case = _mm_set1_epi8(__case_bit(needle[needle_len - 1]));
+    size_t i = 0;
+
+    for (; (i + needle_len - 1 + 16) <= haystack_len; i += 16) {
+        const __m128i block_first = _mm_loadu_si128((const __m128i*) (haystack + i));
+        const __m128i block_last = _mm_loadu_si128((const __m128i*) (haystack + i + needle_len - 1));
+
+        unsigned int mask = (unsigned int) _mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(_mm_or_si128(block_first, first_case), first),
+            _mm_cmpeq_epi8(_mm_or_si128(block_last, last_case), last)));
+
+        while (mask != 0) {
+            const char* candidate = haystack + i + __builtin_ctz(mask);
+            if (__mismatch_ignore_case_sse2(candidate, needle, needle_len) == needle_len) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    if ((i + needle_len) > haystack_len) {
+        return NULL;
+    }
+
+    return __find_substr_ignore_case_scalar(haystack + i, haystack_len - i, needle, needle_len);
+}
+
+/* SSSE3 kernels */
+
+SIMD_TARGET_SSSE3
+static size_t __class_span_ssse3(const unsigned char* lo_nibble, const unsigned char* hi_nibble,
+                                 const char* ptr, size_t len, bool member)
+{
+    const __m128i lo_table = _mm_loadu_si128((const __m128i*) lo_nibble);
+    const __m128i hi_table = _mm_loadu_si128((const __m128i*) hi_nibble);
+    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+    const __m128i zero = _mm_setzero_si128();
+    const unsigned int flip = member ? 0xFFFF : 0;
+    size_t i = 0;
+
+    for (; (i + 16) <= len; i += 16) {
+        const __m128i chunk = _mm_loadu_si128((const __m128i*) (ptr + i));
+        const __m128i lo = _mm_shuffle_epi8(lo_table, _mm_and_si128(chunk, nibble_mask));
+        const __m128i hi = _mm_shuffle_epi8(hi_table, _mm_and_si128(_mm_srli_epi16(chunk, 4), nibble_mask));
+
+        /* Bits of members are set */
+        const unsigned int members = 0xFFFF & ~(unsigned int) _mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_and_si128(lo, hi), zero));
+
+        const unsigned int stop = members ^ flip;
+        if (stop != 0) {
+            return i + __builtin_ctz(stop);
+        }
+    }
+
+    return i;
+}
+
+/* AVX2 kernels */
+
+SIMD_NO_SANITIZE SIMD_TARGET_AVX2
+static size_t __strlen_avx2(const char* string) {
+    const size_t misalign = (uintptr_t) string % 32;
+    const __m256i* block = (const __m256i*) (string - misalign);
+    const __m256i zero = _mm256_setzero_si256();
+
+    uint32_t mask = (uint32_t) _mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(_mm256_load_si256(block), zero)) >> misalign;
+
+    if (mask != 0) {
+        return (size_t) __builtin_ctz(mask);
+    }
+
+    for (;;) {
+        block += 1;
+        mask = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256(block), zero));
+        if (mask != 0) {
+            return (size_t) ((const char*) block - string) + __builtin_ctz(mask);
+        }
+    }
+}
+
+SIMD_TARGET_AVX2
+static void __ascii_copy_avx2(char* dst, const char* src, size_t len) {
+    const __m256i replacement = _mm256_set1_epi8(ASCII_REPLACEMENT_CHAR);
+    size_t i = 0;
+
+    for (; (i + 32) <= len; i += 32) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*) (src + i));
+        if (_mm256_movemask_epi8(chunk) != 0) {
+            chunk = _mm256_blendv_epi8(chunk, replacement, chunk);
+        }
+        _mm256_storeu_si256((__m256i*) (dst + i), chunk);
+    }
+
+    __ascii_copy_sse2(dst + i, src + i, len - i);
+}
+
+SIMD_TARGET_AVX2
+static const char* __find_char_avx2(const char* haystack, size_t len, char ch) {
+    const __m256i needle = _mm256_set1_epi8(ch);
+    size_t i = 0;
+
+    for (; (i + 32) <= len; i += 32) {
+        const __m256i chunk = _mm256_loadu_si256((const __m256i*) (haystack + i));
+        const uint32_t mask = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle));
+        if (mask != 0) {
+            return haystack + i + __builtin_ctz(mask);
+        }
+    }
+
+    return __find_char_sse2(haystack + i, len - i, ch);
+}
+
+SIMD_TARGET_AVX2
+static const char* __find_substr_avx2(const char* haystack, size_t haystack_len,
+                                      const char* needle, size_t needle_len)
+{
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[needle_len - 1]);
+    size_t i = 0;
+
+    for (; (i + needle_len - 1 + 32) <= haystack_len; i += 32) {
+        const __m256i block_first = _mm256_loadu_si256((const __m256i*) (haystack + i));
+        const __m256i block_last = _mm256_loadu_si256((const __m256i*) (haystack + i + needle_len - 1));
+
+        uint32_t mask = (uint32_t) _mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(block_first, first),
+            _mm256_cmpeq_epi8(block_last, last)));
+
+        while (mask != 0) {
+            const char* candidate = haystack + i + __builtin_ctz(mask);
+            if (memcmp(candidate + 1, needle + 1, needle_len - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return __find_substr_sse2(haystack + i, haystack_len - i, needle, needle_len);
+}
+
+SIMD_TARGET_AVX2
+static size_t __class_span_avx2(const unsigned char* lo_nibble, const unsigned char* hi_nibble,
+                                const char* ptr, size_t len, bool member)
+{
+    const __m256i lo_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) lo_nibble));
+    const __m256i hi_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) hi_nibble));
+    const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+    const __m256i zero = _mm256_setzero_si256();
+    const uint32_t flip = member ? 0xFFFFFFFF : 0;
+    size_t i = 0;
+
+    for (; (i + 32) <= len; i += 32) {
+        const __m256i chunk = _mm256_loadu_si256((const __m256i*) (ptr + i));
+        const __m256i lo = _mm256_shuffle_epi8(lo_table, _mm256_and_si256(chunk, nibble_mask));
+        const __m256i hi = _mm256_shuffle_epi8(hi_table,
+            _mm256_and_si256(_mm256_srli_epi16(chunk, 4), nibble_mask));
+
+        /* Bits of members are set */
+        const uint32_t members = ~(uint32_t) _mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), zero));
+
+        const uint32_t stop = members ^ flip;
+        if (stop != 0) {
+            return i + __builtin_ctz(stop);
+        }
+    }
+
+    return i + __class_span_ssse3(lo_nibble, hi_nibble, ptr + i, len - i, member);
+}
+
+SIMD_TARGET_AVX2
+static inline uint32_t __diff_mask_avx2(const char* a, const char* b) {
+    const __m256i chunk_a = _mm256_loadu_si256((const __m256i*) a);
+    const __m256i chunk_b = _mm256_loadu_si256((const __m256i*) b);
+    return ~(uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk_a, chunk_b));
+}
+
+SIMD_TARGET_AVX2
+static size_t __mismatch_avx2(const char* a, const char* b, size_t len) {
+    size_t i = 0;
+    uint32_t mask = 0;
+
+    for (; (i + 32) <= len; i += 32) {
+        mask = __diff_mask_avx2(a + i, b + i);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    /* Partial last block is compared overlapping the previous one */
+    if (i < len) {
+        i = len - 32;
+        mask = __diff_mask_avx2(a + i, b + i);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    return len;
+}
+
+SIMD_TARGET_AVX2
+static inline __m256i __case_bits_avx2(__m256i chunk, char first, char last) {
+    const __m256i in_range = _mm256_and_si256(
+        _mm256_cmpgt_epi8(chunk, _mm256_set1_epi8((char) (first - 1))),
+        _mm256_cmpgt_epi8(_mm256_set1_epi8((char) (last + 1)), chunk));
+    return _mm256_and_si256(in_range, _mm256_set1_epi8(ASCII_CASE_BIT));
+}
+
+SIMD_TARGET_AVX2
+static inline __m256i __fold_case_avx2(__m256i chunk) {
+    return _mm256_add_epi8(chunk, __case_bits_avx2(chunk, 'A', 'Z'));
+}
+
+SIMD_TARGET_AVX2
+static void __case_convert_avx2(char* dst, const char* src, size_t len, bool upper) {
+    const char first = upper ? 'a' : 'A';
+    const char last = upper ? 'z' : 'Z';
+    size_t i = 0;
+
+    for (; (i + 32) <= len; i += 32) {
+        const __m256i chunk = _mm256_loadu_si256((const __m256i*) (src + i));
+        _mm256_storeu_si256((__m256i*) (dst + i), _mm256_xor_si256(chunk, __case_bits_avx2(chunk, first, last)));
+    }
+
+    __case_convert_sse2(dst + i, src + i, len - i, upper);
+}
+
+SIMD_TARGET_AVX2
+static size_t __mismatch_ignore_case_avx2(const char* a, const char* b, size_t len) {
+    size_t i = 0;
+
+    for (; (i + 32) <= len; i += 32) {
+        const __m256i chunk_a = _mm256_loadu_si256((const __m256i*) (a + i));
+        const __m256i chunk_b = _mm256_loadu_si256((const __m256i*) (b + i));
+
+        if ((uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk_a, chunk_b)) != UINT32_MAX) {
+            const uint32_t mask = ~(uint32_t) _mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(__fold_case_avx2(chunk_a), __fold_case_avx2(chunk_b)));
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+    }
+
+    return i + __mismatch_ignore_case_sse2(a + i, b + i, len - i);
+}
+
+SIMD_TARGET_AVX2
+static const char* __find_substr_ignore_case_avx2(const char* haystack, size_t haystack_len,
+                                                  const char* needle, size_t needle_len)
+{
+    const __m256i first = _mm256_set1_epi8(__fold_case(needle[0]));
+    const __m256i last = _mm256_set1_epi8(__fold_case(needle[needle_len - 1]));
+    const __m256i first_case = _mm256_set1_epi8(__case_bit(needle[0]));
+    const __m256i last_case = _mm256_set1_epi8(__case_bit(needle[needle_len - 1]));
+    size_t i = 0;
+
+    for (; (i + needle_len - 1 + 32) <= haystack_len; i += 32) {
+        const __m256i block_first = _mm256_loadu_si256((const __m256i*) (haystack + i));
+        const __m256i block_last = _mm256_loadu_si256((const __m256i*) (haystack + i + needle_len - 1));
+
+        uint32_t mask = (uint32_t) _mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(_mm256_or_si256(block_first, first_case), first),
+            _mm256_cmpeq_epi8(_mm256_or_si256(block_last, last_case), last)));
+
+        while (mask != 0) {
+            const char* candidate = haystack + i + __builtin_ctz(mask);
+            if (__mismatch_ignore_case_avx2(candidate, needle, needle_len) == needle_len) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return __find_substr_ignore_case_sse2(haystack + i, haystack_len - i, needle, needle_len);
+}
+
+#endif /* USTRING_SIMD_X86 */
+
+/* Dispatch */
+
+size_t __simd_strlen(const char* string) {
+#if USTRING_SIMD_X86
+    return __has_avx2() ? __strlen_avx2(string) : __strlen_sse2(string);
+#else
+    return __strlen_swar(string);
+#endif
+}
+
+void __simd_ascii_copy(char* dst, const char* src, size_t len) {
+#if USTRING_SIMD_X86
+    if ((len >= 32) && __has_avx2()) {
+        __ascii_copy_avx2(dst, src, len);
+    } else {
+        __ascii_copy_sse2(dst, src, len);
+    }
+#else
+    __ascii_copy_swar(dst, src, len);
+#endif
+}
+
+const char* __simd_find_char(const char* haystack, size_t len, char ch) {
+#if USTRING_SIMD_X86
+    return ((len >= 32) && __has_avx2())
+        ? __find_char_avx2(haystack, len, ch)
+        : __find_char_sse2(haystack, len, ch);
+#else
+    return memchr(haystack, ch, len);
+#endif
+}
+
+const char* __simd_find_substr(const char* haystack, size_t haystack_len,
+                               const char* needle, size_t needle_len)
+{
+    if ((needle_len < 2) || (needle_len > haystack_len)) {
+        return NULL;
+    }
+
+#if USTRING_SIMD_X86
+    return ((haystack_len >= 64) && __has_avx2())
+        ? __find_substr_avx2(haystack, haystack_len, needle, needle_len)
+        : __find_substr_sse2(haystack, haystack_len, needle, needle_len);
+#else
+    return __find_substr_scalar(haystack, haystack_len, needle, needle_len);
+#endif
+}
+
+size_t __simd_mismatch(const char* a, const char* b, size_t len) {
+#if USTRING_SIMD_X86
+    return ((len >= 32) && __has_avx2())
+        ? __mismatch_avx2(a, b, len)
+        : __mismatch_sse2(a, b, len);
+#else
+    return __mismatch_swar(a, b, len);
+#endif
+}
+
+void __simd_case_convert(char* dst, const char* src, size_t len, bool upper) {
+#if USTRING_SIMD_X86
+    if ((len >= 32) && __has_avx2()) {
+        __case_convert_avx2(dst, src, len, upper);
+    } else {
+        __case_convert_sse2(dst, src, len, upper);
+    }
+#else
+    __case_convert_swar(dst, src, len, upper);
+#endif
+}
+
+size_t __simd_mismatch_ignore_case(const char* a, const char* b, size_t len) {
+#if USTRING_SIMD_X86
+    return ((len >= 32) && __has_avx2())
+        ? __mismatch_ignore_case_avx2(a, b, len)
+        : __mismatch_ignore_case_sse2(a, b, len);
+#else
+    return __mismatch_ignore_case_swar(a, b, len);
+#endif
+}
+
+const char* __simd_find_substr_ignore_case(const char* haystack, size_t haystack_len,
+                                           const char* needle, size_t needle_len)
+{
+    if ((needle_len == 0) || (needle_len > haystack_len)) {
+        return NULL;
+    }
+
+#if USTRING_SIMD_X86
+    return ((haystack_len >= 64) && __has_avx2())
+        ? __find_substr_ignore_case_avx2(haystack, haystack_len, needle, needle_len)
+        : __find_substr_ignore_case_sse2(haystack, haystack_len, needle, needle_len);
+#else
+    return __find_substr_ignore_case_scalar(haystack, haystack_len, needle, needle_len);
+#endif
+}
+
+size_t __simd_class_span(const unsigned char* lo_nibble, const unsigned char* hi_nibble,
+                         const char* ptr, size_t len, bool member)
+{
+#if USTRING_SIMD_X86
+    if ((len >= 32) && __has_avx2()) {
+        return __class_span_avx2(lo_nibble, hi_nibble, ptr, len, member);
+    } else if ((len >= 16) && __has_ssse3()) {
+        return __class_span_ssse3(lo_nibble, hi_nibble, ptr, len, member);
+    }
+#else
+    (void) lo_nibble;
+    (void) hi_nibble;
+    (void) ptr;
+    (void) len;
+    (void) member;
+#endif
+    return 0;
+}
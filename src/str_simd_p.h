@@ -0,0 +1,148 @@
+/******************************************************************************
+ *
+ * @file    str_simd_p.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   Vectorized string kernels private header file
+ *
+ * Kernels are selected at runtime: AVX2 is used when supported by the CPU,
+ * SSE2 is used on any other x86 target and portable word-at-a-time code
+ * is used everywhere else.
+ *
+ *****************************************************************************/
+
+#ifndef __STR_SIMD_P_H__
+#define __STR_SIMD_P_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#if (defined(__GNUC__) || defined(__clang__))                                 \
+    && (defined(__x86_64__) || defined(__i386__))                             \
+    && defined(__SSE2__)
+#define USTRING_SIMD_X86 1
+#else
+#define USTRING_SIMD_X86 0
+#endif
+
+/**
+ * @brief Returns the length of a C string.
+ *
+ * Scans for the null terminator 16 or 32 bytes at a time.
+ *
+ * @param string Null-terminated C string, must not be @c NULL
+ * @return Length of the C string
+ */
+size_t __simd_strlen(const char* string);
+
+/**
+ * @brief Copies characters replacing every non-ASCII character with '?'
+ *
+ * Blocks of valid ASCII characters are copied as is,
+ * blocks containing non-ASCII characters are normalized.
+ *
+ * @param dst Destination buffer of at least @c len bytes
+ * @param src Source characters, must not overlap @c dst
+ * @param len Number of characters to copy
+ */
+void __simd_ascii_copy(char* dst, const char* src, size_t len);
+
+/**
+ * @brief Finds the first occurrence of the character
+ *
+ * @param haystack Characters to search in
+ * @param len Number of characters in @c haystack
+ * @param ch Character to search for
+ * @return Pointer to the first occurrence of @c ch ; @c NULL if not found
+ */
+const char* __simd_find_char(const char* haystack, size_t len, char ch);
+
+/**
+ * @brief Finds the first occurrence of the short pattern
+ *
+ * Candidate positions are filtered by comparing the first and the last
+ * characters of the pattern against whole blocks of the haystack,
+ * only candidates passing the filter are compared entirely.
+ *
+ * @param haystack Characters to search in
+ * @param haystack_len Number of characters in @c haystack
+ * @param needle Pattern characters
+ * @param needle_len Pattern length, must be at least 2
+ * @return Pointer to the first occurrence of the pattern; @c NULL if not found
+ */
+const char* __simd_find_substr(const char* haystack, size_t haystack_len,
+                               const char* needle, size_t needle_len);
+
+/**
+ * @brief Finds the first position where the characters differ
+ *
+ * Compares 32, 16 or 8 characters at a time. Partial last block
+ * is compared overlapping the previous one instead of character by character.
+ *
+ * @param a,b Characters to compare
+ * @param len Number of characters in both @c a and @c b
+ * @return Index of the first differing character; @c len if all characters match
+ */
+size_t __simd_mismatch(const char* a, const char* b, size_t len);
+
+/**
+ * @brief Converts ASCII letters to the lower or to the upper case
+ *
+ * Whole blocks are converted at once: letters of the source case are
+ * selected with the range comparison and their case bit is flipped.
+ * Non-letter and non-ASCII characters are copied as is.
+ *
+ * @param dst Destination buffer of at least @c len bytes, may be equal to @c src
+ * @param src Source characters
+ * @param len Number of characters to convert
+ * @param upper @c true to convert to the upper case, @c false to the lower case
+ */
+void __simd_case_convert(char* dst, const char* src, size_t len, bool upper);
+
+/**
+ * @brief Finds the first position where the characters differ ignoring ASCII case
+ *
+ * Blocks are compared as is first, only differing blocks are folded to the lower case.
+ *
+ * @param a,b Characters to compare
+ * @param len Number of characters in both @c a and @c b
+ * @return Index of the first differing character; @c len if all characters match
+ */
+size_t __simd_mismatch_ignore_case(const char* a, const char* b, size_t len);
+
+/**
+ * @brief Finds the first occurrence of the pattern ignoring ASCII case
+ *
+ * Same filter as @c __simd_find_substr applied to the blocks folded
+ * to the lower case, candidates are compared with @c __simd_mismatch_ignore_case .
+ *
+ * @param haystack Characters to search in
+ * @param haystack_len Number of characters in @c haystack
+ * @param needle Pattern characters
+ * @param needle_len Pattern length
+ * @return Pointer to the first occurrence of the pattern;
+ *      @c NULL if not found or if the pattern is empty
+ */
+const char* __simd_find_substr_ignore_case(const char* haystack, size_t haystack_len,
+                                           const char* needle, size_t needle_len);
+
+/**
+ * @brief Scans the run of characters of the same class membership
+ *
+ * Classifies whole blocks of characters with the nibble lookup tables:
+ * character @c ch is a member if @c lo_nibble[ch & 0x0F] & hi_nibble[ch >> 4]
+ * is non-zero. Trailing characters not filling the whole block are not scanned.
+ *
+ * @param lo_nibble Class bits selected by the low nibble
+ * @param hi_nibble Class bits selected by the high nibble
+ * @param ptr Characters to scan
+ * @param len Number of characters in @c ptr
+ * @param member @c true to scan the run of members, @c false to scan the run of non-members
+ * @return Index of the first character ending the run or
+ *      the number of scanned characters if the run continues to the end of the last block
+ */
+size_t __simd_class_span(const unsigned char* lo_nibble, const unsigned char* hi_nibble,
+                         const char* ptr, size_t len, bool member);
+
+#endif /* __STR_SIMD_P_H__ */
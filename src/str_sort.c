@@ -0,0 +1,602 @@
+/**************************************************************************//**
+ *
+ * @file    str_sort.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ *****************************************************************************/
+
+#include <stdatomic.h>
+#include <string.h>
+
+#include <ustring/str_list.h>
+#include <ustring/str_view.h>
+#include "str_sort_p.h"
+#include "str_list_p.h"
+#include "alloc_p.h"
+#include "parallel_p.h"
+
+#define USTRING_OK  ((int) 0)
+#define USTRING_ERR ((int) 1)
+
+/* Ranges shorter than this are sorted by insertion */
+#define STR_SORT_INSERTION_THRESHOLD ((size_t) 16)
+#define STR_SORT_RADIX_THRESHOLD ((size_t) 32)
+
+/* Radix buckets: finished strings and 256 character values */
+#define STR_SORT_BUCKET_COUNT ((size_t) 257)
+
+#define STR_SORT_STACK_CAPACITY ((size_t) 64)
+
+/* Shorter lists are sorted by the calling thread */
+#define STR_PAR_SORT_MIN_ITEMS ((size_t) 1 << 14)
+#define STR_PAR_SORT_BUCKETS_PER_THREAD ((size_t) 4)
+#define STR_PAR_SORT_OVERSAMPLING ((size_t) 32)
+
+static inline uint64_t __str_sort_key(const str_t* string, size_t depth) {
+    if (depth >= string->len) {
+        return 0;
+    }
+
+    const unsigned char* chars = (const unsigned char*) string->buffer + depth;
+    const size_t left = string->len - depth;
+
+    if (left >= STR_SORT_KEY_SIZE) {
+        uint64_t key;
+        memcpy(&key, chars, sizeof(key));
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+        return __builtin_bswap64(key);
+#elif defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        return key;
+#endif
+    }
+
+    uint64_t key = 0;
+    for (size_t i = 0; i < STR_SORT_KEY_SIZE; i++) {
+        key = (key << 8) | ((i < left) ? chars[i] : 0);
+    }
+
+    return key;
+}
+
+void __str_sort_load_keys(struct __str_sort_item* items, size_t count, size_t depth) {
+    for (size_t i = 0; i < count; i++) {
+        items[i].key = __str_sort_key(items[i].str, depth);
+    }
+}
+
+int __str_sort_cmp(const struct __str_sort_item* a, const struct __str_sort_item* b, size_t depth) {
+    if (a->key != b->key) {
+        return (a->key < b->key) ? -1 : 1;
+    }
+
+    /*
+     * Equal keys: string which ends inside the key is a prefix of the other one,
+     * since its zero padding matches zero characters of the other string
+     */
+    const size_t start = depth + STR_SORT_KEY_SIZE;
+    const size_t a_len = a->str->len;
+    const size_t b_len = b->str->len;
+
+    if ((a_len > start) && (b_len > start)) {
+        const size_t len = (a_len < b_len) ? a_len : b_len;
+        const int cmp = memcmp(a->str->buffer + start, b->str->buffer + start, len - start);
+        if (cmp != 0) {
+            return cmp;
+        }
+    }
+
+    return (a_len > b_len) - (a_len < b_len);
+}
+
+static inline void __str_sort_swap(struct __str_sort_item* a, struct __str_sort_item* b) {
+    const struct __str_sort_item tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+/**
+ * @brief Stable insertion sort of the items with keys loaded at @c depth
+ */
+static void __str_sort_insertion(struct __str_sort_item* items, size_t count, size_t depth) {
+    for (size_t i = 1; i < count; i++) {
+        const struct __str_sort_item item = items[i];
+        size_t j = i;
+
+        while ((j > 0) && (__str_sort_cmp(&items[j - 1], &item, depth) > 0)) {
+            items[j] = items[j - 1];
+            j -= 1;
+        }
+
+        items[j] = item;
+    }
+}
+
+static inline uint64_t __str_sort_median(uint64_t a, uint64_t b, uint64_t c) {
+    if (a < b) {
+        return (b < c) ? b : ((a < c) ? c : a);
+    }
+
+    return (a < c) ? a : ((b < c) ? c : b);
+}
+
+void __str_sort_mkqs(struct __str_sort_item* items, size_t count, size_t depth) {
+    while (count > STR_SORT_INSERTION_THRESHOLD) {
+        const uint64_t pivot = __str_sort_median(items[0].key, items[count / 2].key, items[count - 1].key);
+
+        /* Three-way partition: [0, lt) < pivot, [lt, gt) == pivot, [gt, count) > pivot */
+        size_t lt = 0;
+        size_t gt = count;
+        size_t i = 0;
+
+        while (i < gt) {
+            if (items[i].key < pivot) {
+                __str_sort_swap(&items[lt], &items[i]);
+                lt += 1;
+                i += 1;
+            }
+            else if (items[i].key > pivot) {
+                gt -= 1;
+                __str_sort_swap(&items[i], &items[gt]);
+            }
+            else {
+                i += 1;
+            }
+        }
+
+        /* Strings ending inside the pivot key are sorted: they differ only by length */
+        size_t mid = lt;
+        for (i = lt; i < gt; i++) {
+            if (items[i].str->len <= depth + STR_SORT_KEY_SIZE) {
+                __str_sort_swap(&items[mid], &items[i]);
+                mid += 1;
+            }
+        }
+
+        __str_sort_insertion(items + lt, mid - lt, depth);
+        __str_sort_load_keys(items + mid, gt - mid, depth + STR_SORT_KEY_SIZE);
+
+        /* Recursion goes into two smaller parts, so its depth is logarithmic */
+        struct {
+            struct __str_sort_item* items;
+            size_t count;
+            size_t depth;
+        } parts[3] = {
+            {items, lt, depth},
+            {items + mid, gt - mid, depth + STR_SORT_KEY_SIZE},
+            {items + gt, count - gt, depth},
+        };
+
+        size_t largest = 0;
+        for (i = 1; i < 3; i++) {
+            if (parts[i].count > parts[largest].count) {
+                largest = i;
+            }
+        }
+
+        for (i = 0; i < 3; i++) {
+            if (i != largest) {
+                __str_sort_mkqs(parts[i].items, parts[i].count, parts[i].depth);
+            }
+        }
+
+        items = parts[largest].items;
+        count = parts[largest].count;
+        depth = parts[largest].depth;
+    }
+
+    __str_sort_insertion(items, count, depth);
+}
+
+struct __str_sort_range {
+    size_t begin;
+    size_t count;
+    size_t depth;
+};
+
+static inline size_t __str_sort_bucket(const struct __str_sort_item* item, size_t depth) {
+    const size_t shift = 8 * (STR_SORT_KEY_SIZE - 1 - (depth % STR_SORT_KEY_SIZE));
+    const size_t ch = (size_t) (item->key >> shift) & 0xFF;
+
+    /* Zero character is told apart from the padding only by the string length */
+    return ((ch == 0) && (item->str->len <= depth)) ? 0 : ch + 1;
+}
+
+bool __str_sort_msd(struct __str_sort_item* items, struct __str_sort_item* scratch, size_t count,
+                    const ustring_allocator_t* allocator)
+{
+    size_t stack_cap = STR_SORT_STACK_CAPACITY;
+    size_t stack_size = 0;
+    struct __str_sort_range* stack = __ustring_malloc(allocator, stack_cap * sizeof(struct __str_sort_range));
+
+    if (stack == NULL) {
+        return false;
+    }
+
+    stack[stack_size++] = (struct __str_sort_range) {0, count, 0};
+
+    while (stack_size != 0) {
+        struct __str_sort_range range = stack[--stack_size];
+        struct __str_sort_item* range_items = items + range.begin;
+
+        if (range.count < STR_SORT_RADIX_THRESHOLD) {
+            __str_sort_insertion(range_items, range.count, range.depth - (range.depth % STR_SORT_KEY_SIZE));
+            continue;
+        }
+
+        size_t counts[STR_SORT_BUCKET_COUNT] = {0};
+        for (size_t i = 0; i < range.count; i++) {
+            counts[__str_sort_bucket(&range_items[i], range.depth)] += 1;
+        }
+
+        if (counts[0] == range.count) {
+            /* All strings are equal */
+            continue;
+        }
+
+        size_t offsets[STR_SORT_BUCKET_COUNT];
+        size_t offset = 0;
+        bool single_bucket = false;
+
+        for (size_t b = 0; b < STR_SORT_BUCKET_COUNT; b++) {
+            offsets[b] = offset;
+            offset += counts[b];
+            single_bucket |= (counts[b] == range.count);
+        }
+
+        if (!single_bucket) {
+            for (size_t i = 0; i < range.count; i++) {
+                const size_t b = __str_sort_bucket(&range_items[i], range.depth);
+                scratch[offsets[b]++] = range_items[i];
+            }
+
+            memcpy(range_items, scratch, range.count * sizeof(struct __str_sort_item));
+        }
+
+        /* Finished strings are equal and keep their order */
+        offset = counts[0];
+        const size_t depth = range.depth + 1;
+
+        for (size_t b = 1; b < STR_SORT_BUCKET_COUNT; b++) {
+            if (counts[b] > 1) {
+                if (depth % STR_SORT_KEY_SIZE == 0) {
+                    __str_sort_load_keys(range_items + offset, counts[b], depth);
+                }
+
+                if (stack_size == stack_cap) {
+                    struct __str_sort_range* new_stack = __ustring_realloc(allocator, stack,
+                        stack_cap * sizeof(struct __str_sort_range),
+                        2 * stack_cap * sizeof(struct __str_sort_range));
+
+                    if (new_stack == NULL) {
+                        __ustring_free(allocator, stack);
+                        return false;
+                    }
+
+                    stack = new_stack;
+                    stack_cap *= 2;
+                }
+
+                stack[stack_size++] = (struct __str_sort_range) {range.begin + offset, counts[b], depth};
+            }
+
+            offset += counts[b];
+        }
+    }
+
+    __ustring_free(allocator, stack);
+
+    return true;
+}
+
+static int __str_list_sort(str_list_t* self, bool stable) {
+    if (self == NULL) {
+        return USTRING_ERR;
+    }
+
+    if (self->size < 2) {
+        return USTRING_OK;
+    }
+
+    const size_t count = self->size;
+    const size_t items_size = (stable ? 2 : 1) * count * sizeof(struct __str_sort_item);
+    struct __str_sort_item* items = __ustring_malloc(self->allocator, items_size);
+
+    if (items == NULL) {
+        return USTRING_ERR;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        items[i].str = self->buffer[i];
+    }
+
+    __str_sort_load_keys(items, count, 0);
+
+    if (stable) {
+        if (!__str_sort_msd(items, items + count, count, self->allocator)) {
+            __ustring_free(self->allocator, items);
+            return USTRING_ERR;
+        }
+    }
+    else {
+        __str_sort_mkqs(items, count, 0);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        self->buffer[i] = items[i].str;
+    }
+
+    __ustring_free(self->allocator, items);
+
+    return USTRING_OK;
+}
+
+int str_list_sort(str_list_t* self) {
+    return __str_list_sort(self, false);
+}
+
+int str_list_sort_stable(str_list_t* self) {
+    return __str_list_sort(self, true);
+}
+
+/**
+ * @brief Moves repeated strings of the sorted items to their end keeping the first one of equal strings
+ *
+ * Strings are not dropped: their allocators may not be called from several threads.
+ *
+ * @return Number of remaining items, repeated strings follow them
+ */
+static size_t __str_sort_dedup(struct __str_sort_item* items, size_t count) {
+    size_t kept = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if ((kept == 0) || !str_view_eq(str_as_view(items[kept - 1].str), str_as_view(items[i].str))) {
+            __str_sort_swap(&items[kept], &items[i]);
+            kept += 1;
+        }
+    }
+
+    return kept;
+}
+
+/*
+ * Parallel sort partitions the list into buckets by the sampled splitters:
+ * string goes to the bucket of the first splitter not less than the string,
+ * so equal strings share the bucket. Partitioning keeps the list order
+ * inside the buckets, and buckets are sorted with the stable sort, so the
+ * result is the same as the one of the stable sort for any thread count.
+ */
+struct __str_par_sort {
+    str_list_t* list;
+    struct __str_sort_item* items;      /**< Items in the list order, scratch of the bucket sort */
+    struct __str_sort_item* sorted;     /**< Items partitioned by buckets */
+    struct __str_sort_item* splitters;  /**< Sample, first bucket_count - 1 items are splitters */
+    uint16_t* buckets;                  /**< Bucket of each item */
+    size_t* offsets;                    /**< Per chunk bucket counts, then scatter positions */
+    size_t* bucket_start;               /**< Start of each bucket in sorted, bucket_count + 1 */
+    size_t* bucket_size;                /**< Size of each bucket after deduplication */
+    size_t chunk_count;
+    size_t chunk_size;
+    size_t bucket_count;
+    atomic_bool failed;
+};
+
+static size_t __str_par_sort_bucket(const struct __str_par_sort* self, const struct __str_sort_item* item) {
+    size_t lo = 0;
+    size_t hi = self->bucket_count - 1;
+
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+
+        if (__str_sort_cmp(&self->splitters[mid], item, 0) < 0) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+static void __str_par_sort_classify(void* ctx, size_t chunk) {
+    struct __str_par_sort* self = ctx;
+    size_t* counts = self->offsets + chunk * self->bucket_count;
+    const size_t begin = chunk * self->chunk_size;
+    const size_t end = (begin + self->chunk_size < self->list->size) ? begin + self->chunk_size : self->list->size;
+
+    for (size_t i = begin; i < end; i++) {
+        self->items[i].str = self->list->buffer[i];
+        self->items[i].key = __str_sort_key(self->items[i].str, 0);
+
+        const size_t bucket = __str_par_sort_bucket(self, &self->items[i]);
+        self->buckets[i] = (uint16_t) bucket;
+        counts[bucket] += 1;
+    }
+}
+
+static void __str_par_sort_scatter(void* ctx, size_t chunk) {
+    struct __str_par_sort* self = ctx;
+    size_t* offsets = self->offsets + chunk * self->bucket_count;
+    const size_t begin = chunk * self->chunk_size;
+    const size_t end = (begin + self->chunk_size < self->list->size) ? begin + self->chunk_size : self->list->size;
+
+    for (size_t i = begin; i < end; i++) {
+        self->sorted[offsets[self->buckets[i]]++] = self->items[i];
+    }
+}
+
+static void __str_par_sort_sort(void* ctx, size_t bucket) {
+    struct __str_par_sort* self = ctx;
+    const size_t start = self->bucket_start[bucket];
+    const size_t count = self->bucket_start[bucket + 1] - start;
+
+    if (!__str_sort_msd(self->sorted + start, self->items + start, count, self->list->allocator)) {
+        atomic_store(&self->failed, true);
+    }
+}
+
+static void __str_par_sort_dedup(void* ctx, size_t bucket) {
+    struct __str_par_sort* self = ctx;
+    const size_t start = self->bucket_start[bucket];
+
+    self->bucket_size[bucket] = __str_sort_dedup(self->sorted + start, self->bucket_start[bucket + 1] - start);
+}
+
+static void __str_par_sort_free(struct __str_par_sort* self) {
+    const ustring_allocator_t* allocator = self->list->allocator;
+
+    __ustring_free(allocator, self->items);
+    __ustring_free(allocator, self->splitters);
+    __ustring_free(allocator, self->buckets);
+    __ustring_free(allocator, self->offsets);
+    __ustring_free(allocator, self->bucket_start);
+}
+
+/**
+ * @brief Picks bucket splitters from the evenly spaced sample of the list
+ */
+static void __str_par_sort_sample(struct __str_par_sort* self, size_t sample_size) {
+    const size_t count = self->list->size;
+
+    for (size_t i = 0; i < sample_size; i++) {
+        self->splitters[i].str = self->list->buffer[(i * count) / sample_size];
+    }
+
+    __str_sort_load_keys(self->splitters, sample_size, 0);
+    __str_sort_mkqs(self->splitters, sample_size, 0);
+
+    for (size_t i = 0; i + 1 < self->bucket_count; i++) {
+        self->splitters[i] = self->splitters[(i + 1) * STR_PAR_SORT_OVERSAMPLING - 1];
+    }
+}
+
+static int __str_list_par_sort(str_list_t* self, size_t threads, bool dedup) {
+    if (self == NULL) {
+        return USTRING_ERR;
+    }
+
+    threads = __ustring_thread_count(threads);
+
+    if ((threads == 1) || (self->size < STR_PAR_SORT_MIN_ITEMS)) {
+        if (__str_list_sort(self, true) != USTRING_OK) {
+            return USTRING_ERR;
+        }
+
+        if (dedup && (self->size != 0)) {
+            size_t kept = 1;
+
+            for (size_t i = 1; i < self->size; i++) {
+                if (str_view_eq(str_as_view(self->buffer[kept - 1]), str_as_view(self->buffer[i]))) {
+                    str_drop(&self->buffer[i]);
+                }
+                else {
+                    self->buffer[kept++] = self->buffer[i];
+                }
+            }
+
+            self->size = kept;
+        }
+
+        return USTRING_OK;
+    }
+
+    const ustring_allocator_t* allocator = self->allocator;
+    const size_t count = self->size;
+
+    struct __str_par_sort par = {
+        .list = self,
+        .chunk_count = threads,
+        .chunk_size = (count + threads - 1) / threads,
+        .bucket_count = threads * STR_PAR_SORT_BUCKETS_PER_THREAD,
+    };
+
+    atomic_init(&par.failed, false);
+
+    const size_t sample_size = par.bucket_count * STR_PAR_SORT_OVERSAMPLING;
+    const size_t bucket_count = par.bucket_count;
+
+    par.items = __ustring_malloc(allocator, 2 * count * sizeof(struct __str_sort_item));
+    par.splitters = __ustring_malloc(allocator, sample_size * sizeof(struct __str_sort_item));
+    par.buckets = __ustring_malloc(allocator, count * sizeof(uint16_t));
+    par.offsets = __ustring_malloc(allocator, par.chunk_count * bucket_count * sizeof(size_t));
+    par.bucket_start = __ustring_malloc(allocator, (2 * bucket_count + 1) * sizeof(size_t));
+
+    if ((par.items == NULL) || (par.splitters == NULL) || (par.buckets == NULL)
+            || (par.offsets == NULL) || (par.bucket_start == NULL))
+    {
+        __str_par_sort_free(&par);
+        return USTRING_ERR;
+    }
+
+    /* Workers are started once for all phases of the sort */
+    struct __ustring_pool pool;
+    __ustring_pool_start(&pool, threads);
+
+    par.sorted = par.items + count;
+    par.bucket_size = par.bucket_start + bucket_count + 1;
+    memset(par.offsets, 0, par.chunk_count * bucket_count * sizeof(size_t));
+
+    __str_par_sort_sample(&par, sample_size);
+    __ustring_pool_run(&pool, par.chunk_count, __str_par_sort_classify, &par);
+
+    /* Buckets are laid out in order, chunks inside the bucket keep the list order */
+    size_t pos = 0;
+    for (size_t b = 0; b < bucket_count; b++) {
+        par.bucket_start[b] = pos;
+
+        for (size_t c = 0; c < par.chunk_count; c++) {
+            const size_t chunk_count = par.offsets[c * bucket_count + b];
+            par.offsets[c * bucket_count + b] = pos;
+            pos += chunk_count;
+        }
+    }
+    par.bucket_start[bucket_count] = count;
+
+    __ustring_pool_run(&pool, par.chunk_count, __str_par_sort_scatter, &par);
+    __ustring_pool_run(&pool, bucket_count, __str_par_sort_sort, &par);
+
+    if (atomic_load(&par.failed)) {
+        __ustring_pool_stop(&pool);
+        __str_par_sort_free(&par);
+        return USTRING_ERR;
+    }
+
+    for (size_t b = 0; b < bucket_count; b++) {
+        par.bucket_size[b] = par.bucket_start[b + 1] - par.bucket_start[b];
+    }
+
+    if (dedup) {
+        __ustring_pool_run(&pool, bucket_count, __str_par_sort_dedup, &par);
+    }
+
+    __ustring_pool_stop(&pool);
+
+    pos = 0;
+    for (size_t b = 0; b < bucket_count; b++) {
+        struct __str_sort_item* bucket = par.sorted + par.bucket_start[b];
+        const size_t bucket_items = par.bucket_start[b + 1] - par.bucket_start[b];
+
+        for (size_t i = 0; i < par.bucket_size[b]; i++) {
+            self->buffer[pos++] = bucket[i].str;
+        }
+
+        /* Repeated strings are dropped by the calling thread */
+        for (size_t i = par.bucket_size[b]; i < bucket_items; i++) {
+            str_drop(&bucket[i].str);
+        }
+    }
+    self->size = pos;
+
+    __str_par_sort_free(&par);
+
+    return USTRING_OK;
+}
+
+int str_list_par_sort(str_list_t* self, size_t threads) {
+    return __str_list_par_sort(self, threads, false);
+}
+
+int str_list_par_dedup(str_list_t* self, size_t threads) {
+    return __str_list_par_sort(self, threads, true);
+}
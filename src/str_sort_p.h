@@ -0,0 +1,65 @@
+/******************************************************************************
+ *
+ * @file    str_sort_p.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ * @brief   String sorting private header file
+ *
+ * Sorted strings are described by the items holding the string pointer
+ * and the cached key: 8 characters of the string starting at the current
+ * sorting depth, packed in big-endian order and padded with zeros.
+ * Comparing keys compares 8 characters at once without touching
+ * the string buffer, which is read only when keys are reloaded
+ * at the next depth.
+ *
+ *****************************************************************************/
+
+#ifndef __STR_SORT_P_H__
+#define __STR_SORT_P_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "str_p.h"
+
+#define STR_SORT_KEY_SIZE ((size_t) 8)
+
+struct __str_sort_item {
+    uint64_t key;
+    str_t* str;
+};
+
+/**
+ * @brief Loads keys of the items at the given depth
+ */
+void __str_sort_load_keys(struct __str_sort_item* items, size_t count, size_t depth);
+
+/**
+ * @brief Sorts the items with multikey quicksort
+ *
+ * Items must share first @c depth characters and hold keys loaded at @c depth .
+ */
+void __str_sort_mkqs(struct __str_sort_item* items, size_t count, size_t depth);
+
+/**
+ * @brief Stable sorts the items with MSD radix sort
+ *
+ * Items must hold keys loaded at depth 0.
+ *
+ * @param scratch Buffer of at least @c count items
+ * @return @c false on allocation failure, items are left partially sorted
+ */
+bool __str_sort_msd(struct __str_sort_item* items, struct __str_sort_item* scratch, size_t count,
+                    const ustring_allocator_t* allocator);
+
+/**
+ * @brief Compares the strings of the items which share first @c depth characters
+ *
+ * @return Negative value, zero or positive value if the first string is
+ *      less than, equal to or greater than the second one
+ */
+int __str_sort_cmp(const struct __str_sort_item* a, const struct __str_sort_item* b, size_t depth);
+
+#endif /* __STR_SORT_P_H__ */
@@ -0,0 +1,158 @@
+/**************************************************************************//**
+ *
+ * @file    str_view.c
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ *
+ *****************************************************************************/
+
+#include <string.h>
+
+#include <ustring/str_view.h>
+#include "str_p.h"
+#include "str_class_p.h"
+#include "str_search_p.h"
+
+str_view_t str_view_new(const char* string) {
+    return (string == NULL)
+        ? str_view_from_parts(NULL, 0)
+        : str_view_from_parts(string, __str_literal_len(string));
+}
+
+str_view_t str_view_from_parts(const char* ptr, size_t len) {
+    return (str_view_t) {
+        .ptr = ptr,
+        .len = (ptr == NULL) ? 0 : len,
+    };
+}
+
+str_view_t str_as_view(const str_t* self) {
+    return (self == NULL)
+        ? str_view_from_parts(NULL, 0)
+        : str_view_from_parts(self->buffer, self->len);
+}
+
+size_t str_view_len(str_view_t self) {
+    return self.len;
+}
+
+bool str_view_is_empty(str_view_t self) {
+    return self.len == 0;
+}
+
+char str_view_at(str_view_t self, size_t pos) {
+    return (pos < self.len) ? self.ptr[pos] : '\0';
+}
+
+str_view_t str_view_slice(str_view_t self, size_t start, size_t end) {
+    if (self.ptr == NULL) {
+        return self;
+    }
+
+    if (end > self.len) {
+        end = self.len;
+    }
+
+    if (start > end) {
+        start = end;
+    }
+
+    return str_view_from_parts(self.ptr + start, end - start);
+}
+
+bool str_view_eq(str_view_t a, str_view_t b) {
+    return (a.len == b.len)
+        && ((a.len == 0) || (memcmp(a.ptr, b.ptr, a.len) == 0));
+}
+
+int str_view_cmp(str_view_t a, str_view_t b) {
+    const size_t common_len = (a.len < b.len) ? a.len : b.len;
+
+    if (common_len != 0) {
+        const int status = memcmp(a.ptr, b.ptr, common_len);
+        if (status != 0) {
+            return status;
+        }
+    }
+
+    return (a.len > b.len) - (a.len < b.len);
+}
+
+size_t str_view_find(str_view_t self, str_view_t pattern) {
+    if (pattern.len > self.len) {
+        return STR_NPOS;
+    }
+
+    return __str_find(self.ptr, self.len, pattern.ptr, pattern.len);
+}
+
+bool str_view_starts_with(str_view_t self, str_view_t pattern) {
+    return (pattern.len <= self.len)
+        && ((pattern.len == 0) || (memcmp(self.ptr, pattern.ptr, pattern.len) == 0));
+}
+
+bool str_view_ends_with(str_view_t self, str_view_t pattern) {
+    return (pattern.len <= self.len)
+        && ((pattern.len == 0)
+            || (memcmp(self.ptr + (self.len - pattern.len), pattern.ptr, pattern.len) == 0));
+}
+
+str_view_t str_view_trim(str_view_t self) {
+    return str_view_trim_end(str_view_trim_start(self));
+}
+
+str_view_t str_view_trim_start(str_view_t self) {
+    size_t start = 0;
+
+    while ((start != self.len) && __is_blank(self.ptr[start])) {
+        start += 1;
+    }
+
+    return str_view_slice(self, start, self.len);
+}
+
+str_view_t str_view_trim_end(str_view_t self) {
+    size_t end = self.len;
+
+    while ((end != 0) && __is_blank(self.ptr[end - 1])) {
+        end -= 1;
+    }
+
+    return str_view_slice(self, 0, end);
+}
+
+str_split_iter_t str_split_iter(str_view_t string, const char* delim) {
+    str_split_iter_t self = {
+        .ptr = string.ptr,
+        .end = (string.ptr == NULL) ? NULL : string.ptr + string.len,
+    };
+
+    __str_class_init(&self.delim, delim);
+
+    return self;
+}
+
+str_split_iter_t str_split_whitespace_iter(str_view_t string) {
+    return str_split_iter(string, STR_WHITESPACE_DELIM);
+}
+
+bool str_split_iter_next(str_split_iter_t* self, str_view_t* token) {
+    if ((self == NULL) || (token == NULL) || (self->ptr == self->end)) {
+        return false;
+    }
+
+    const char* front_ptr = self->ptr;
+    front_ptr += __str_class_span(&self->delim, front_ptr, self->end - front_ptr);
+
+    if (front_ptr == self->end) {
+        self->ptr = front_ptr;
+        return false;
+    }
+
+    const size_t token_len = __str_class_cspan(&self->delim, front_ptr, self->end - front_ptr);
+
+    self->ptr = front_ptr + token_len;
+    *token = str_view_from_parts(front_ptr, token_len);
+
+    return true;
+}
@@ -0,0 +1,124 @@
+#include <criterion/criterion.h>
+
+#include <ustring/alloc.h>
+#include <ustring/str.h>
+#include <ustring/str_list.h>
+#include <ustring/str_list_flat.h>
+#include <ustring/str_view.h>
+#include "../src/str_p.h"
+#include "../src/str_list_p.h"
+#include "test_alloc.h"
+
+/* Allocations per short string: a single block unless inline buffers are disabled */
+#define STR_ALLOCS ((STR_INLINE_CAPACITY >= STR_DEFAULT_CAPACITY) ? 1 : 2)
+
+static test_alloc_stats_t stats;
+static ustring_allocator_t allocator;
+
+static void setup(void) {
+    allocator = test_allocator(&stats);
+}
+
+static void teardown(void) {
+    ustring_set_allocator(NULL);
+}
+
+TestSuite(alloc, .init = setup, .fini = teardown);
+
+Test(alloc, global) {
+    const ustring_allocator_t* default_allocator = ustring_get_allocator();
+    cr_assert_not_null(default_allocator);
+
+    ustring_set_allocator(&allocator);
+    cr_assert_eq(ustring_get_allocator(), &allocator);
+
+    str_t* string = str_new("Hello");
+    cr_assert_eq(stats.allocs, STR_ALLOCS);
+
+    /* Objects keep the allocator they were created with */
+    ustring_set_allocator(NULL);
+    cr_assert_eq(ustring_get_allocator(), default_allocator);
+
+    str_append(string, ", world! This sentence outgrows the default capacity");
+    cr_assert_eq(stats.allocs + stats.reallocs, STR_ALLOCS + 1);
+
+    str_drop(&string);
+    cr_assert_eq(stats.frees, 2);
+    cr_assert_eq(stats.frees, stats.allocs);
+}
+
+Test(alloc, str_new) {
+    str_t* string = str_new_alloc(&allocator, "Hello");
+    cr_assert_not_null(string);
+    cr_assert_eq(string->allocator, &allocator);
+    cr_assert_str_eq(str_as_ptr(string), "Hello");
+    cr_assert_eq(stats.allocs, STR_ALLOCS);
+
+    str_t* copy = str_copy_alloc(&allocator, string);
+    cr_assert_str_eq(str_as_ptr(copy), "Hello");
+    cr_assert_eq(stats.allocs, 2 * STR_ALLOCS);
+
+    str_t* concat = str_concat_alloc(&allocator, string, copy);
+    cr_assert_str_eq(str_as_ptr(concat), "HelloHello");
+    cr_assert_eq(stats.allocs, 3 * STR_ALLOCS);
+
+    str_drop(&string);
+    str_drop(&copy);
+    str_drop(&concat);
+    cr_assert_eq(stats.frees, stats.allocs);
+    cr_assert_eq(stats.reallocs, 0);
+}
+
+Test(alloc, str_list) {
+    str_t* string = str_new("One, Two; Three");
+    str_list_t* list = str_split_alloc(&allocator, string, " ,;");
+    cr_assert_not_null(list);
+    cr_assert_eq(list->allocator, &allocator);
+    cr_assert_eq(str_list_size(list), 3);
+
+    /* List instance, list buffer and three strings */
+    cr_assert_eq(stats.allocs, 2 + 3 * STR_ALLOCS);
+    cr_assert_eq(stats.reallocs, 0);
+
+    str_t* joined = str_list_join_alloc(&allocator, list, "-");
+    cr_assert_str_eq(str_as_ptr(joined), "One-Two-Three");
+
+    str_drop(&joined);
+    str_list_drop(&list);
+    str_drop(&string);
+    cr_assert_eq(stats.frees, stats.allocs);
+}
+
+Test(alloc, split_iter) {
+    str_t* string = str_new("One, Two; Three");
+
+    ustring_set_allocator(&allocator);
+
+    str_split_iter_t it = str_split_iter(str_as_view(string), " ,;");
+    str_view_t token;
+    size_t count = 0;
+    while (str_split_iter_next(&it, &token)) {
+        count += 1;
+    }
+
+    cr_assert_eq(count, 3);
+    cr_assert_eq(stats.allocs + stats.reallocs, 0);
+
+    ustring_set_allocator(NULL);
+    str_drop(&string);
+}
+
+Test(alloc, str_list_flat) {
+    str_list_flat_t* list = str_list_flat_with_capacity_alloc(&allocator, 4, 64);
+    cr_assert_not_null(list);
+
+    /* List instance, item array and character buffer */
+    cr_assert_eq(stats.allocs + stats.reallocs, 3);
+
+    cr_assert_eq(str_split_into(list, str_view_new("One, Two; Three"), " ,;"), 0);
+    cr_assert_eq(str_list_flat_size(list), 3);
+    cr_assert_eq(stats.allocs + stats.reallocs, 3);
+
+    str_list_flat_drop(&list);
+    cr_assert_eq(stats.frees, 3);
+}
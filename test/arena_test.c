@@ -0,0 +1,125 @@
+#include <criterion/criterion.h>
+
+#include <ustring/arena.h>
+#include <ustring/str.h>
+#include <ustring/str_list.h>
+#include "../src/arena_p.h"
+#include "../src/str_list_p.h"
+
+static ustring_arena_t* arena;
+
+static void setup(void) {
+    arena = ustring_arena_new(256);
+}
+
+static void teardown(void) {
+    ustring_arena_drop(&arena);
+}
+
+TestSuite(arena, .init = setup, .fini = teardown);
+
+Test(arena, alloc) {
+    cr_assert_not_null(arena);
+    cr_assert_eq(ustring_arena_used(arena), 0);
+
+    char* ptr_a = __arena_alloc(arena, 10);
+    char* ptr_b = __arena_alloc(arena, 1);
+    cr_assert_not_null(ptr_a);
+    cr_assert_not_null(ptr_b);
+    cr_assert_eq((size_t) ptr_b % _Alignof(max_align_t), 0);
+    cr_assert_gt(ptr_b, ptr_a);
+
+    /* Larger than block size */
+    char* ptr_c = __arena_alloc(arena, 1000);
+    cr_assert_not_null(ptr_c);
+    ptr_c[999] = 'c';
+
+    cr_assert_geq(ustring_arena_used(arena), 1011);
+    cr_assert_eq(ustring_arena_used(NULL), 0);
+}
+
+Test(arena, realloc) {
+    char* ptr_a = __arena_alloc(arena, 16);
+    for (int i = 0; i < 16; i++) {
+        ptr_a[i] = 'a';
+    }
+
+    /* Most recent allocation grows in place */
+    char* ptr_b = __arena_realloc(arena, ptr_a, 16, 64);
+    cr_assert_eq(ptr_a, ptr_b);
+
+    __arena_alloc(arena, 8);
+
+    char* ptr_c = __arena_realloc(arena, ptr_b, 64, 128);
+    cr_assert_neq(ptr_c, ptr_b);
+    cr_assert_eq(ptr_c[0], 'a');
+    cr_assert_eq(ptr_c[15], 'a');
+}
+
+Test(arena, reset) {
+    for (int i = 0; i < 100; i++) {
+        cr_assert_not_null(__arena_alloc(arena, 100));
+    }
+
+    ustring_arena_reset(arena);
+    cr_assert_eq(ustring_arena_used(arena), 0);
+    cr_assert_not_null(arena->head);
+    cr_assert_null(arena->head->next);
+
+    cr_assert_not_null(__arena_alloc(arena, 100));
+    ustring_arena_reset(NULL);
+}
+
+Test(arena, str_in) {
+    str_t* string = str_new_in(arena, "Pull & Bear");
+    cr_assert_not_null(string);
+    cr_assert_str_eq(str_as_ptr(string), "Pull & Bear");
+
+    str_append(string, " is a very long string that grows out of its buffer");
+    cr_assert_str_eq(str_as_ptr(string), "Pull & Bear is a very long string that grows out of its buffer");
+
+    str_replace(string, "very", "really");
+    cr_assert_str_eq(str_as_ptr(string), "Pull & Bear is a really long string that grows out of its buffer");
+
+    str_t* copy = str_copy_in(arena, string);
+    str_t* empty = str_with_capacity_in(arena, 0);
+    str_t* concat = str_concat_in(arena, copy, string);
+    cr_assert_str_eq(str_as_ptr(copy), str_as_ptr(string));
+    cr_assert_eq(str_len(empty), 0);
+    cr_assert_eq(str_len(concat), 2 * str_len(string));
+
+    str_drop(&string);
+    cr_assert_null(string);
+    str_drop(&copy);
+    str_drop(&empty);
+    str_drop(&concat);
+}
+
+Test(arena, str_list_in) {
+    str_t* string = str_new_in(arena, "one two three four five six seven eight nine ten");
+    str_list_t* list = str_split_whitespace_in(arena, string);
+    cr_assert_eq(str_list_size(list), 10);
+    cr_assert_str_eq(str_as_ptr(str_list_at(list, 9)), "ten");
+
+    for (int i = 0; i < 100; i++) {
+        str_list_push(list, str_new_in(arena, "more"));
+    }
+    cr_assert_eq(str_list_size(list), 110);
+
+    str_t* joined = str_list_join_in(arena, list, ",");
+    cr_assert_eq(str_len(joined), 48 + 100 * 5);
+
+    str_list_t* list_empty = str_list_with_capacity_in(arena, 0);
+    str_list_push(list_empty, str_new_in(arena, "first"));
+    cr_assert_eq(str_list_size(list_empty), 1);
+
+    str_list_t* list_csv = str_split_in(arena, joined, ",");
+    cr_assert_eq(str_list_size(list_csv), 110);
+
+    ustring_arena_reset(arena);
+
+    list = str_list_new_in(arena);
+    cr_assert_not_null(list);
+    cr_assert_eq(list->allocator, ustring_arena_allocator(arena));
+    str_list_drop(&list);
+}
@@ -0,0 +1,178 @@
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+
+#include <ustring/str.h>
+#include <ustring/str_charset.h>
+
+static str_t* string;
+
+static void setup(void) {
+    string = str_new(" \t+1 (555) 010-9999\t ");
+}
+
+static void teardown(void) {
+    str_drop(&string);
+}
+
+TestSuite(str_charset, .init = setup, .fini = teardown);
+
+static bool is_blank(char ch) {
+    return (ch == ' ') || (ch == '\t');
+}
+
+static bool is_punct(char ch) {
+    return strchr("+()-", ch) != NULL;
+}
+
+Test(str_charset, new) {
+    const str_charset_t punct = str_charset_new("+()-");
+    cr_assert(str_charset_contains(&punct, '('));
+    cr_assert(str_charset_contains(&punct, '-'));
+    cr_assert_not(str_charset_contains(&punct, '1'));
+    cr_assert_not(str_charset_contains(&punct, '\0'));
+
+    const str_charset_t empty = str_charset_new(NULL);
+    for (size_t ch = 0; ch < 256; ch++) {
+        cr_assert_not(str_charset_contains(&empty, (char) ch));
+    }
+
+    cr_assert_not(str_charset_contains(NULL, 'a'));
+}
+
+Test(str_charset, classes) {
+    const str_charset_t digit = str_charset_digit();
+    const str_charset_t alpha = str_charset_alpha();
+    const str_charset_t blank = str_charset_blank();
+    const str_charset_t space = str_charset_space();
+    const str_charset_t alnum = str_charset_union(&digit, &alpha);
+    const str_charset_t high = str_charset_range((char) 0x80, (char) 0xFF);
+    const str_charset_t reversed = str_charset_range('z', 'a');
+
+    for (size_t ch = 0; ch < 256; ch++) {
+        cr_assert_eq(str_charset_contains(&digit, (char) ch), (ch < 0x80) && isdigit((int) ch));
+        cr_assert_eq(str_charset_contains(&alpha, (char) ch), (ch < 0x80) && isalpha((int) ch));
+        cr_assert_eq(str_charset_contains(&blank, (char) ch), (ch < 0x80) && isblank((int) ch));
+        cr_assert_eq(str_charset_contains(&space, (char) ch), (ch < 0x80) && isspace((int) ch));
+        cr_assert_eq(str_charset_contains(&alnum, (char) ch), (ch < 0x80) && isalnum((int) ch));
+        cr_assert_eq(str_charset_contains(&high, (char) ch), ch >= 0x80);
+        cr_assert_not(str_charset_contains(&reversed, (char) ch));
+    }
+
+    const str_charset_t same = str_charset_union(&digit, NULL);
+    cr_assert(str_charset_contains(&same, '7'));
+    cr_assert_not(str_charset_contains(&same, 'a'));
+}
+
+Test(str_charset, contains_set) {
+    const str_charset_t digit = str_charset_digit();
+    const str_charset_t alpha = str_charset_alpha();
+
+    cr_assert(str_contains_set(string, &digit));
+    cr_assert_not(str_contains_set(string, &alpha));
+
+    str_t* empty = str_new("");
+    cr_assert_not(str_contains_set(empty, &digit));
+    str_drop(&empty);
+
+    /* Member found past the vector blocks */
+    str_t* long_string = str_new(NULL);
+    for (size_t i = 0; i < 20; i++) {
+        str_append(long_string, "no digits here, ");
+    }
+    cr_assert_not(str_contains_set(long_string, &digit));
+    str_append(long_string, "7");
+    cr_assert(str_contains_set(long_string, &digit));
+    str_drop(&long_string);
+
+    cr_assert_not(str_contains_set(NULL, &digit));
+    cr_assert_not(str_contains_set(string, NULL));
+}
+
+Test(str_charset, trim_matches_set) {
+    const str_charset_t punct = str_charset_new("+()-");
+    const str_charset_t blank = str_charset_blank();
+
+    cr_assert_eq(str_trim_matches_set(string, &punct), 0);
+    cr_assert_str_eq(str_as_ptr(string), " \t1 555 0109999\t ");
+    cr_assert_eq(str_trim_matches_set(string, &blank), 0);
+    cr_assert_str_eq(str_as_ptr(string), "15550109999");
+
+    /* Nothing to remove */
+    cr_assert_eq(str_trim_matches_set(string, &blank), 0);
+    cr_assert_str_eq(str_as_ptr(string), "15550109999");
+
+    cr_assert_neq(str_trim_matches_set(NULL, &blank), 0);
+    cr_assert_neq(str_trim_matches_set(string, NULL), 0);
+}
+
+Test(str_charset, trim_start_end_matches_set) {
+    const str_charset_t blank = str_charset_blank();
+
+    cr_assert_eq(str_trim_start_matches_set(string, &blank), 0);
+    cr_assert_str_eq(str_as_ptr(string), "+1 (555) 010-9999\t ");
+    cr_assert_eq(str_trim_end_matches_set(string, &blank), 0);
+    cr_assert_str_eq(str_as_ptr(string), "+1 (555) 010-9999");
+
+    str_t* blanks = str_new(" \t \t");
+    cr_assert_eq(str_trim_end_matches_set(blanks, &blank), 0);
+    cr_assert_str_eq(str_as_ptr(blanks), "");
+    cr_assert_eq(str_trim_start_matches_set(blanks, &blank), 0);
+    cr_assert_str_eq(str_as_ptr(blanks), "");
+    str_drop(&blanks);
+
+    cr_assert_neq(str_trim_start_matches_set(NULL, &blank), 0);
+    cr_assert_neq(str_trim_end_matches_set(string, NULL), 0);
+}
+
+Test(str_charset, shared) {
+    const str_charset_t blank = str_charset_blank();
+
+    str_make_shared(string);
+    str_t* copy = str_copy(string);
+
+    cr_assert_eq(str_trim_matches_set(copy, &blank), 0);
+    cr_assert_str_eq(str_as_ptr(copy), "+1(555)010-9999");
+    cr_assert_str_eq(str_as_ptr(string), " \t+1 (555) 010-9999\t ");
+
+    str_drop(&copy);
+}
+
+Test(str_charset, random) {
+    const str_charset_t blank = str_charset_blank();
+    const str_charset_t punct = str_charset_new("+()-");
+    char text[300];
+
+    srand(7);
+    for (size_t n = 0; n < 200; n++) {
+        const size_t len = (size_t) rand() % (sizeof(text) - 1);
+        for (size_t i = 0; i < len; i++) {
+            /* Long runs of kept characters cross the vector blocks */
+            text[i] = ((i / 37) % 2 == 0) ? 'x' : " \t+()-ab"[rand() % 8];
+        }
+        text[len] = '\0';
+
+        str_t* by_set = str_new(text);
+        str_t* by_fn = str_new(text);
+
+        str_trim_start_matches_set(by_set, &blank);
+        str_trim_start_matches_fn(by_fn, is_blank);
+        cr_assert_str_eq(str_as_ptr(by_set), str_as_ptr(by_fn));
+
+        str_trim_end_matches_set(by_set, &punct);
+        str_trim_end_matches_fn(by_fn, is_punct);
+        cr_assert_str_eq(str_as_ptr(by_set), str_as_ptr(by_fn));
+
+        cr_assert_eq(str_contains_set(by_set, &punct), str_contains_fn(by_fn, is_punct));
+
+        str_trim_matches_set(by_set, &blank);
+        str_trim_matches_fn(by_fn, is_blank);
+        cr_assert_str_eq(str_as_ptr(by_set), str_as_ptr(by_fn));
+        cr_assert_eq(str_len(by_set), str_len(by_fn));
+
+        str_drop(&by_fn);
+        str_drop(&by_set);
+    }
+}
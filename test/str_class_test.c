@@ -0,0 +1,83 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+
+#include "../src/str_class_p.h"
+
+#define TEXT_LEN ((size_t) 300)
+
+static bool in_set(const char* chars, char ch) {
+    return (ch != '\0') && (strchr(chars, ch) != NULL);
+}
+
+static size_t naive_span(const char* chars, const char* ptr, size_t len, bool member) {
+    size_t i = 0;
+    while ((i < len) && (in_set(chars, ptr[i]) == member)) {
+        i += 1;
+    }
+    return i;
+}
+
+/* Checks spans starting at every position of the text against the naive scan */
+static void check_spans(const char* chars, const char* text, size_t len) {
+    __str_class_t cls;
+    __str_class_init(&cls, chars);
+
+    for (size_t i = 0; i < len; i++) {
+        cr_assert_eq(__str_class_span(&cls, text + i, len - i), naive_span(chars, text + i, len - i, true));
+        cr_assert_eq(__str_class_cspan(&cls, text + i, len - i), naive_span(chars, text + i, len - i, false));
+    }
+}
+
+TestSuite(str_class);
+
+Test(str_class, contains) {
+    __str_class_t cls;
+    __str_class_init(&cls, " \t,");
+
+    cr_assert(__str_class_contains(&cls, ' '));
+    cr_assert(__str_class_contains(&cls, '\t'));
+    cr_assert(__str_class_contains(&cls, ','));
+    cr_assert_not(__str_class_contains(&cls, 'a'));
+    cr_assert_not(__str_class_contains(&cls, '\0'));
+    cr_assert_not(__str_class_contains(&cls, (char) 0xAC));
+    cr_assert(cls.vectorized);
+
+    __str_class_init(&cls, NULL);
+    for (size_t ch = 0; ch < 256; ch++) {
+        cr_assert_not(__str_class_contains(&cls, (char) ch));
+    }
+}
+
+Test(str_class, vectorized) {
+    __str_class_t cls;
+
+    /* Eight distinct low nibble sets at most */
+    __str_class_init(&cls, " !0123456789ABCabc");
+    cr_assert(cls.vectorized);
+
+    __str_class_init(&cls, "\x01\x12\x23\x34\x45\x56\x67\x78\x89");
+    cr_assert_not(cls.vectorized);
+}
+
+Test(str_class, span) {
+    char text[TEXT_LEN];
+
+    srand(7);
+    for (size_t i = 0; i < TEXT_LEN; i++) {
+        text[i] = " ,;abcdefgh\x80\xff"[rand() % 14];
+    }
+
+    check_spans(" ,;", text, TEXT_LEN);
+    check_spans(" ", text, TEXT_LEN);
+    check_spans("abcdefgh", text, TEXT_LEN);
+    check_spans("\x80\xff", text, TEXT_LEN);
+    check_spans("\x01\x12\x23\x34\x45\x56\x67\x78\x89 ,", text, TEXT_LEN);
+    check_spans("", text, TEXT_LEN);
+
+    /* Long runs of members and non-members */
+    memset(text, ' ', TEXT_LEN / 2);
+    memset(text + TEXT_LEN / 2, 'x', TEXT_LEN / 2);
+    check_spans(" \t", text, TEXT_LEN);
+}
@@ -0,0 +1,172 @@
+#include <string.h>
+#include <pthread.h>
+
+#include <criterion/criterion.h>
+
+#include <ustring/str.h>
+#include <ustring/str_list.h>
+#include <ustring/str_view.h>
+#include "../src/str_p.h"
+#include "../src/str_hash_p.h"
+
+#define THREAD_COUNT ((size_t) 8)
+#define ITEM_COUNT ((size_t) 256)
+
+static str_t* string_a;
+static str_t* string_b;
+
+static void setup(void) {
+    string_a = str_new("Pull & Bear");
+    string_b = str_new("Pull & Bear");
+}
+
+static void teardown(void) {
+    str_drop(&string_a);
+    str_drop(&string_b);
+}
+
+TestSuite(str_hash, .init = setup, .fini = teardown);
+
+Test(str_hash, hash) {
+    cr_assert_not(string_a->hashed);
+
+    const uint64_t hash = str_hash(string_a);
+    cr_assert(string_a->hashed);
+    cr_assert_eq(string_a->hash, hash);
+    cr_assert_eq(str_hash(string_a), hash);
+    cr_assert_eq(str_hash(string_b), hash);
+    cr_assert_eq(str_view_hash(str_view_new("Pull & Bear"), STR_HASH_DEFAULT_SEED), hash);
+
+    cr_assert_eq(str_hash(NULL), str_view_hash(str_view_new(""), STR_HASH_DEFAULT_SEED));
+    cr_assert_neq(str_hash(string_a), str_view_hash(str_view_new("Pull & Beer"), STR_HASH_DEFAULT_SEED));
+}
+
+Test(str_hash, seeded) {
+    const uint64_t hash = str_hash_seeded(string_a, 42);
+    cr_assert_not(string_a->hashed);
+    cr_assert_eq(hash, str_view_hash(str_as_view(string_a), 42));
+    cr_assert_neq(hash, str_hash(string_a));
+    cr_assert_eq(str_hash_seeded(string_a, STR_HASH_DEFAULT_SEED), str_hash(string_a));
+}
+
+Test(str_hash, lengths) {
+    char buffer[200];
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = 'a' + (char) (i % 26);
+    }
+
+    /* Every length takes its own path through the short and long input branches */
+    for (size_t len = 0; len < sizeof(buffer); len++) {
+        const uint64_t hash = __str_hash_bytes(buffer, len, 0);
+        cr_assert_neq(hash, __str_hash_bytes(buffer, len + 1, 0));
+        cr_assert_neq(hash, __str_hash_bytes(buffer, len, 1));
+
+        if (len != 0) {
+            cr_assert_neq(hash, __str_hash_bytes(buffer + 1, len, 0));
+
+            char flipped[sizeof(buffer)];
+            memcpy(flipped, buffer, len);
+            flipped[len / 2] ^= 1;
+            cr_assert_neq(hash, __str_hash_bytes(flipped, len, 0));
+        }
+    }
+}
+
+Test(str_hash, invalidate) {
+    uint64_t hash = str_hash(string_a);
+
+    str_append(string_a, "!");
+    cr_assert_not(string_a->hashed);
+    cr_assert_neq(str_hash(string_a), hash);
+
+    str_truncate(string_a, 11);
+    cr_assert_eq(str_hash(string_a), hash);
+
+    str_to_uppercase(string_a);
+    cr_assert_not(string_a->hashed);
+    str_to_lowercase(string_a);
+    cr_assert_not(string_a->hashed);
+    hash = str_hash(string_a);
+
+    str_replace(string_a, "&", "and");
+    cr_assert_neq(str_hash(string_a), hash);
+
+    hash = str_hash(string_a);
+    str_trim_matches(string_a, "pull");
+    cr_assert_neq(str_hash(string_a), hash);
+
+    str_hash(string_a);
+    str_clear(string_a);
+    cr_assert_eq(str_hash(string_a), str_hash(NULL));
+
+    str_list_t* list = str_list_new();
+    str_list_push(list, str_new("a"));
+    str_list_push(list, str_new("b"));
+    str_list_join_into(string_a, list, ",");
+    cr_assert_eq(str_hash(string_a), str_view_hash(str_view_new("a,b"), STR_HASH_DEFAULT_SEED));
+    str_list_drop(&list);
+}
+
+Test(str_hash, eq) {
+    str_hash(string_a);
+    str_hash(string_b);
+    cr_assert(str_eq(string_a, string_b));
+
+    /* Stale hash would make str_eq reject equal strings */
+    str_to_uppercase(string_a);
+    str_to_uppercase(string_b);
+    str_hash(string_a);
+    cr_assert(str_eq(string_a, string_b));
+
+    str_t* string_c = str_new("Pull & Beer");
+    str_hash(string_c);
+    cr_assert_not(str_eq(string_a, string_c));
+    str_drop(&string_c);
+}
+
+static void* hash_worker_run(void* arg) {
+    const str_list_t* snapshot = arg;
+    char item[32];
+    size_t matches = 0;
+
+    /* Every worker fills the caches of the same shared items */
+    for (size_t i = 0; i < ITEM_COUNT; i++) {
+        snprintf(item, sizeof(item), "item-%zu", i);
+        str_t* expected = str_new(item);
+        str_hash(expected);
+
+        const str_t* shared = str_list_at(snapshot, i);
+        matches += (str_hash(shared) == str_hash(expected)) && str_eq(shared, expected);
+
+        str_drop(&expected);
+    }
+
+    return (void*) matches;
+}
+
+Test(str_hash, threads) {
+    str_list_t* list = str_list_new();
+    char item[32];
+
+    for (size_t i = 0; i < ITEM_COUNT; i++) {
+        snprintf(item, sizeof(item), "item-%zu", i);
+        str_list_push(list, str_new(item));
+    }
+
+    str_list_make_shared(list);
+    str_list_t* snapshot = str_list_copy(list);
+    pthread_t threads[THREAD_COUNT];
+
+    for (size_t i = 0; i < THREAD_COUNT; i++) {
+        cr_assert_eq(pthread_create(&threads[i], NULL, hash_worker_run, snapshot), 0);
+    }
+
+    for (size_t i = 0; i < THREAD_COUNT; i++) {
+        void* matches = NULL;
+        pthread_join(threads[i], &matches);
+        cr_assert_eq((size_t) matches, ITEM_COUNT);
+    }
+
+    str_list_drop(&snapshot);
+    str_list_drop(&list);
+}
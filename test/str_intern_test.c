@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <pthread.h>
+
+#include <criterion/criterion.h>
+
+#include <ustring/str.h>
+#include <ustring/str_intern.h>
+#include <ustring/str_view.h>
+#include "../src/str_p.h"
+#include "../src/str_intern_p.h"
+#include "test_alloc.h"
+
+#define THREAD_COUNT ((size_t) 8)
+#define TAG_COUNT ((size_t) 1000)
+
+static str_intern_t* intern;
+
+static void setup(void) {
+    intern = str_intern_new();
+}
+
+static void teardown(void) {
+    str_intern_drop(&intern);
+}
+
+TestSuite(str_intern, .init = setup, .fini = teardown);
+
+Test(str_intern, new) {
+    cr_assert_not_null(intern);
+    cr_assert_eq(str_intern_size(intern), 0);
+    cr_assert_null(str_intern_lookup(intern, str_view_new("Pull")));
+
+    str_intern_t* concurrent = str_intern_new_concurrent();
+    cr_assert_not_null(concurrent);
+    cr_assert_eq(concurrent->shard_count, STR_INTERN_SHARD_COUNT);
+    cr_assert_eq(str_intern_size(concurrent), 0);
+    str_intern_drop(&concurrent);
+    cr_assert_null(concurrent);
+
+    cr_assert_eq(str_intern_size(NULL), 0);
+    str_intern_drop(NULL);
+}
+
+Test(str_intern, intern) {
+    str_t* string = str_new("Pull & Bear");
+
+    const str_t* a = str_intern(intern, string);
+    const str_t* b = str_intern_cstr(intern, "Pull & Bear");
+    const str_t* c = str_intern_view(intern, str_view_from_parts("Pull & Bear & Co", 11));
+    const str_t* d = str_intern_cstr(intern, "Zara");
+
+    /* Equal strings share the handle owned by the table */
+    cr_assert_not_null(a);
+    cr_assert_neq(a, string);
+    cr_assert_eq(a, b);
+    cr_assert_eq(a, c);
+    cr_assert_neq(a, d);
+    cr_assert_str_eq(str_as_ptr(a), "Pull & Bear");
+    cr_assert_eq(str_intern_size(intern), 2);
+
+    /* Hash of the handle is cached */
+    cr_assert(a->hashed);
+    cr_assert_eq(str_hash(a), str_hash(string));
+
+    cr_assert_null(str_intern(NULL, string));
+    cr_assert_null(str_intern(intern, NULL));
+    cr_assert_null(str_intern_cstr(intern, NULL));
+
+    str_drop(&string);
+    cr_assert_str_eq(str_as_ptr(a), "Pull & Bear");
+}
+
+Test(str_intern, lookup) {
+    const str_t* handle = str_intern_cstr(intern, "Pull");
+
+    cr_assert_eq(str_intern_lookup(intern, str_view_new("Pull")), handle);
+    cr_assert_null(str_intern_lookup(intern, str_view_new("Bear")));
+    cr_assert_null(str_intern_lookup(NULL, str_view_new("Pull")));
+    cr_assert_eq(str_intern_size(intern), 1);
+
+    /* Non-ASCII characters are replaced like in str_from_view */
+    handle = str_intern_cstr(intern, "Caf\xc3\xa9");
+    cr_assert_str_eq(str_as_ptr(handle), "Caf??");
+    cr_assert_eq(str_intern_lookup(intern, str_view_new("Caf??")), handle);
+}
+
+Test(str_intern, alloc) {
+    test_alloc_stats_t stats;
+    ustring_allocator_t allocator = test_allocator(&stats);
+
+    str_intern_t* local = str_intern_new_alloc(&allocator, true);
+    cr_assert_not_null(local);
+    cr_assert_not_null(str_intern_cstr(local, "Pull"));
+    cr_assert_not_null(str_intern_cstr(local, "Bear"));
+    str_intern_drop(&local);
+
+    cr_assert_gt(stats.allocs, 0);
+    cr_assert_eq(stats.allocs, stats.frees);
+}
+
+struct intern_worker {
+    str_intern_t* intern;
+    size_t first;
+    const str_t* handles[TAG_COUNT];
+};
+
+static void* intern_worker_run(void* arg) {
+    struct intern_worker* worker = arg;
+    char tag[32];
+
+    /* Workers intern the same tags in different order */
+    for (size_t n = 0; n < TAG_COUNT; n++) {
+        const size_t i = (worker->first + n) % TAG_COUNT;
+        snprintf(tag, sizeof(tag), "tag-%zu", i);
+        worker->handles[i] = str_intern_cstr(worker->intern, tag);
+    }
+
+    return NULL;
+}
+
+Test(str_intern, concurrent) {
+    str_intern_t* concurrent = str_intern_new_concurrent();
+    static struct intern_worker workers[THREAD_COUNT];
+    pthread_t threads[THREAD_COUNT];
+
+    for (size_t i = 0; i < THREAD_COUNT; i++) {
+        workers[i].intern = concurrent;
+        workers[i].first = i * (TAG_COUNT / THREAD_COUNT);
+        cr_assert_eq(pthread_create(&threads[i], NULL, intern_worker_run, &workers[i]), 0);
+    }
+
+    for (size_t i = 0; i < THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    cr_assert_eq(str_intern_size(concurrent), TAG_COUNT);
+
+    for (size_t i = 0; i < TAG_COUNT; i++) {
+        cr_assert_not_null(workers[0].handles[i]);
+
+        for (size_t t = 1; t < THREAD_COUNT; t++) {
+            cr_assert_eq(workers[t].handles[i], workers[0].handles[i]);
+        }
+    }
+
+    str_intern_drop(&concurrent);
+}
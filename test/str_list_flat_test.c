@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+
+#include <ustring/str_list.h>
+#include <ustring/str_list_flat.h>
+#include "../src/str_list_flat_p.h"
+
+static str_list_flat_t* list_a;
+static str_list_flat_t* list_empty;
+
+static void setup(void) {
+    list_a = str_list_flat_new();
+    str_list_flat_push(list_a, str_view_new("foo"));
+    str_list_flat_push(list_a, str_view_new("bar"));
+    str_list_flat_push(list_a, str_view_new("baz"));
+
+    list_empty = str_list_flat_new();
+}
+
+static void teardown(void) {
+    str_list_flat_drop(&list_a);
+    str_list_flat_drop(&list_empty);
+}
+
+TestSuite(str_list_flat, .init = setup, .fini = teardown);
+
+Test(str_list_flat, new) {
+    cr_assert_not_null(list_empty);
+    cr_assert_eq(list_empty->size, 0);
+    cr_assert_eq(list_empty->cap, STR_LIST_FLAT_DEFAULT_CAPACITY);
+    cr_assert_eq(list_empty->bytes_cap, STR_LIST_FLAT_DEFAULT_BYTES);
+    cr_assert(str_list_flat_is_empty(list_empty));
+    cr_assert(str_list_flat_is_empty(NULL));
+
+    str_list_flat_t* list = str_list_flat_with_capacity(0, 0);
+    cr_assert_not_null(list);
+    cr_assert_eq(str_list_flat_push(list, str_view_new("grow")), 0);
+    cr_assert_str_eq(str_list_flat_at(list, 0).ptr, "grow");
+    str_list_flat_drop(&list);
+    cr_assert_null(list);
+
+    str_list_flat_drop(NULL);
+}
+
+Test(str_list_flat, push) {
+    cr_assert_eq(str_list_flat_size(list_a), 3);
+    cr_assert_eq(list_a->bytes_len, 12);
+
+    /* Items share the single buffer */
+    cr_assert_eq(str_list_flat_at(list_a, 1).ptr, str_list_flat_at(list_a, 0).ptr + 4);
+
+    char long_item[500];
+    memset(long_item, 'x', sizeof(long_item));
+    cr_assert_eq(str_list_flat_push(list_a, str_view_from_parts(long_item, sizeof(long_item))), 0);
+    cr_assert_eq(str_list_flat_push(list_a, str_view_new("")), 0);
+    cr_assert_eq(str_list_flat_push(list_a, str_view_new("Caf\xc3\xa9")), 0);
+    cr_assert_neq(str_list_flat_push(NULL, str_view_new("foo")), 0);
+
+    cr_assert_eq(str_list_flat_size(list_a), 6);
+    cr_assert_str_eq(str_list_flat_at(list_a, 0).ptr, "foo");
+    cr_assert_eq(str_list_flat_at(list_a, 3).len, sizeof(long_item));
+    cr_assert(str_view_is_empty(str_list_flat_at(list_a, 4)));
+    cr_assert_str_eq(str_list_flat_at(list_a, 5).ptr, "Caf??");
+}
+
+Test(str_list_flat, push_self) {
+    /* Items of the list pushed into itself survive reallocation of the bytes */
+    str_list_flat_t* list = str_list_flat_with_capacity(1, 8);
+    cr_assert_eq(str_list_flat_push(list, str_view_new("abc def")), 0);
+
+    for (size_t i = 0; i < 6; i++) {
+        cr_assert_eq(str_list_flat_push(list, str_list_flat_at(list, i)), 0);
+    }
+
+    cr_assert_eq(str_list_flat_size(list), 7);
+    for (size_t i = 0; i < str_list_flat_size(list); i++) {
+        cr_assert_str_eq(str_list_flat_at(list, i).ptr, "abc def");
+    }
+
+    str_list_flat_drop(&list);
+
+    list = str_list_flat_with_capacity(1, 8);
+    cr_assert_eq(str_list_flat_push(list, str_view_new("abc def")), 0);
+    cr_assert_eq(str_split_into(list, str_list_flat_at(list, 0), " "), 0);
+    cr_assert_eq(str_list_flat_size(list), 3);
+    cr_assert_str_eq(str_list_flat_at(list, 1).ptr, "abc");
+    cr_assert_str_eq(str_list_flat_at(list, 2).ptr, "def");
+
+    str_list_flat_drop(&list);
+}
+
+Test(str_list_flat, at) {
+    cr_assert(str_view_eq(str_list_flat_at(list_a, 0), str_view_new("foo")));
+    cr_assert(str_view_eq(str_list_flat_at(list_a, 2), str_view_new("baz")));
+    cr_assert_str_eq(str_list_flat_at(list_a, 2).ptr, "baz");
+    cr_assert_null(str_list_flat_at(list_a, 3).ptr);
+    cr_assert_null(str_list_flat_at(list_empty, 0).ptr);
+    cr_assert_null(str_list_flat_at(NULL, 0).ptr);
+}
+
+Test(str_list_flat, clear) {
+    const size_t bytes_cap = list_a->bytes_cap;
+
+    cr_assert_eq(str_list_flat_clear(list_a), 0);
+    cr_assert(str_list_flat_is_empty(list_a));
+    cr_assert_eq(list_a->bytes_cap, bytes_cap);
+    cr_assert_neq(str_list_flat_clear(NULL), 0);
+}
+
+Test(str_list_flat, split_into) {
+    str_t* string = str_new(" .One, Two;; Three.");
+    str_list_t* list = str_split(string, " ,;.");
+
+    cr_assert_eq(str_split_into(list_empty, str_as_view(string), " ,;."), 0);
+    cr_assert_eq(str_list_flat_size(list_empty), str_list_size(list));
+
+    for (size_t i = 0; i < str_list_size(list); i++) {
+        cr_assert(str_view_eq(str_list_flat_at(list_empty, i), str_as_view(str_list_at(list, i))));
+    }
+
+    /* Tokens are appended */
+    cr_assert_eq(str_split_into(list_a, str_view_new("qux quux"), " "), 0);
+    cr_assert_eq(str_list_flat_size(list_a), 5);
+    cr_assert_str_eq(str_list_flat_at(list_a, 4).ptr, "quux");
+
+    cr_assert_eq(str_split_into(list_a, str_view_new(NULL), " "), 0);
+    cr_assert_eq(str_list_flat_size(list_a), 5);
+    cr_assert_neq(str_split_into(NULL, str_view_new("a b"), " "), 0);
+
+    str_list_drop(&list);
+    str_drop(&string);
+}
+
+Test(str_list_flat, join) {
+    str_t* joined = str_list_flat_join(list_a, ", ");
+    cr_assert_str_eq(str_as_ptr(joined), "foo, bar, baz");
+    cr_assert_eq(str_len(joined), 13);
+    cr_assert_eq(str_cap(joined), 14);
+    str_drop(&joined);
+
+    joined = str_list_flat_join(list_a, NULL);
+    cr_assert_str_eq(str_as_ptr(joined), "foobarbaz");
+    str_drop(&joined);
+
+    joined = str_list_flat_join(list_empty, ", ");
+    cr_assert_str_eq(str_as_ptr(joined), "");
+    str_drop(&joined);
+
+    joined = str_list_flat_join(NULL, ", ");
+    cr_assert_not_null(joined);
+    cr_assert_eq(str_len(joined), 0);
+    str_drop(&joined);
+}
+
+Test(str_list_flat, par_split_into) {
+    str_t* input = str_with_capacity(1 << 20);
+
+    for (size_t i = 0; str_len(input) < (1 << 20) - 32; i++) {
+        char token[32];
+        snprintf(token, sizeof(token), (i % 7 == 0) ? "%zu,, " : "%zu;", i);
+        str_append(input, token);
+    }
+
+    str_list_flat_t* expected = str_list_flat_new();
+    cr_assert_eq(str_split_into(expected, str_as_view(input), " ,;"), 0);
+
+    /* Tokens are appended after the items of the list */
+    cr_assert_eq(str_par_split_into(list_a, str_as_view(input), " ,;", 8), 0);
+    cr_assert_eq(str_list_flat_size(list_a), 3 + str_list_flat_size(expected));
+    cr_assert(str_view_eq(str_list_flat_at(list_a, 2), str_view_new("baz")));
+
+    for (size_t i = 0; i < str_list_flat_size(expected); i++) {
+        str_view_t item = str_list_flat_at(list_a, 3 + i);
+        cr_assert(str_view_eq(item, str_list_flat_at(expected, i)));
+        cr_assert_eq(item.ptr[item.len], '\0');
+    }
+
+    cr_assert_eq(str_par_split_into(list_empty, str_view_new(NULL), ",", 8), 0);
+    cr_assert(str_list_flat_is_empty(list_empty));
+    cr_assert_neq(str_par_split_into(NULL, str_as_view(input), ",", 8), 0);
+
+    str_list_flat_drop(&expected);
+    str_drop(&input);
+}
@@ -1,8 +1,13 @@
 #include <criterion/criterion.h>
 
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include <ustring/str_list.h>
+#include <ustring/str_view.h>
 #include "../src/str_list_p.h"
 
 static str_list_t* list_a;
@@ -49,6 +54,11 @@ Test(str_list, with_capacity) {
     cr_assert_eq(list_2->cap, 0);
     cr_assert_null(list_2->buffer);
 
+    str_list_push(list_2, str_new("first"));
+    cr_assert_eq(list_2->size, 1);
+    cr_assert_geq(list_2->cap, 1);
+    cr_assert_str_eq(list_2->buffer[0]->buffer, "first");
+
     str_list_drop(&list_1);
     str_list_drop(&list_2);
 }
@@ -77,6 +87,57 @@ Test(str_list, copy) {
     str_list_drop(&list_empty_copy_2);
 }
 
+#define SHARED_THREAD_COUNT 4
+
+static void* shared_reader_run(void* arg) {
+    str_list_t* snapshot = arg;
+
+    for (size_t i = 0; i < str_list_size(snapshot); i++) {
+        const str_t* item = str_list_at(snapshot, i);
+        if (str_len(item) != strlen(str_as_ptr(item))) {
+            return arg;
+        }
+    }
+
+    str_list_drop(&snapshot);
+
+    return NULL;
+}
+
+Test(str_list, make_shared) {
+    cr_assert_neq(str_list_make_shared(list_null), 0);
+    cr_assert_eq(str_list_make_shared(list_a), 0);
+
+    str_list_t* copy = str_list_copy(list_a);
+    for (size_t i = 0; i < list_a->size; i++) {
+        cr_assert(str_is_shared(copy->buffer[i]));
+        cr_assert_eq(copy->buffer[i]->buffer, list_a->buffer[i]->buffer);
+    }
+
+    str_append(copy->buffer[0], "d");
+    cr_assert_str_eq(str_as_ptr(copy->buffer[0]), "food");
+    cr_assert_str_eq(str_as_ptr(list_a->buffer[0]), "foo");
+    str_list_drop(&copy);
+
+    /* Snapshots are read and dropped by other threads */
+    pthread_t threads[SHARED_THREAD_COUNT];
+
+    for (size_t i = 0; i < SHARED_THREAD_COUNT; i++) {
+        cr_assert_eq(pthread_create(&threads[i], NULL, shared_reader_run, str_list_copy(list_a)), 0);
+    }
+
+    str_append(list_a->buffer[1], "n");
+
+    for (size_t i = 0; i < SHARED_THREAD_COUNT; i++) {
+        void* result = NULL;
+        pthread_join(threads[i], &result);
+        cr_assert_null(result);
+    }
+
+    cr_assert_str_eq(str_as_ptr(list_a->buffer[1]), "barn");
+    cr_assert_eq(atomic_load(&list_a->buffer[2]->shared->refs), 1);
+}
+
 Test(str_list, push) {
     cr_assert_eq(list_empty->size, 0);
     
@@ -197,11 +258,53 @@ Test(str_list, join) {
     str_t* empty_string = str_list_join(NULL, "");
     cr_assert_eq(empty_string->len, 0);
 
+    /* Exact-size buffer */
+    cr_assert_eq(joined_hyphen_foobar->len, 11);
+    cr_assert_eq(joined_hyphen_foobar->cap, 12);
+
+    str_t* joined_null_foobar = str_list_join(list_a, NULL);
+    cr_assert_str_eq(joined_null_foobar->buffer, "foobarbaz");
+    str_drop(&joined_null_foobar);
+
     str_drop(&joined_hyphen_foobar);
     str_drop(&joined_ws_foobar);
     str_drop(&empty_string);
 }
 
+Test(str_list, join_into) {
+    str_t* line = str_new("> ");
+
+    cr_assert_eq(str_list_join_into(line, list_a, ", "), 0);
+    cr_assert_str_eq(str_as_ptr(line), "> foo, bar, baz");
+    cr_assert_eq(str_len(line), 15);
+
+    /* Buffer is reused */
+    const size_t cap = str_cap(line);
+    str_clear(line);
+    cr_assert_eq(str_list_join_into(line, list_b, " "), 0);
+    cr_assert_str_eq(str_as_ptr(line), "Hello world");
+    cr_assert_eq(str_cap(line), cap);
+
+    cr_assert_eq(str_list_join_into(line, list_empty, " "), 0);
+    cr_assert_eq(str_list_join_into(line, NULL, " "), 0);
+    cr_assert_str_eq(str_as_ptr(line), "Hello world");
+    cr_assert_neq(str_list_join_into(NULL, list_a, " "), 0);
+
+    /* Destination is one of the list items */
+    str_t* first = str_list_at(list_a, 0);
+    cr_assert_eq(str_list_join_into(first, list_a, "-"), 0);
+    cr_assert_str_eq(str_as_ptr(first), "foofoo-bar-baz");
+
+    /* Each join doubles the item and adds 8 characters, moving it to the heap */
+    for (size_t i = 0; i < 3; i++) {
+        cr_assert_eq(str_list_join_into(first, list_a, "-"), 0);
+    }
+    cr_assert_eq(str_len(first), 168);
+    cr_assert(str_ends_with(first, "-bar-baz"));
+
+    str_drop(&line);
+}
+
 Test(str_list, contains) {
     str_t* string_foo = str_new("foo");
     str_t* string_baz = str_new("baz");
@@ -218,3 +321,257 @@ Test(str_list, contains) {
     str_drop(&string_baz);
     str_drop(&string_beez);
 }
+
+static int sort_reference_cmp(const void* a, const void* b) {
+    return str_view_cmp(str_as_view(*(str_t* const*) a), str_as_view(*(str_t* const*) b));
+}
+
+/* Random strings with long shared prefixes, duplicates and zero characters */
+static str_list_t* sort_make_list(size_t count) {
+    static const char* prefixes[] = {"", "a", "https://example.com/", "https://example.com/api/v1/users/"};
+    str_list_t* list = str_list_with_capacity(count);
+    char buffer[64];
+
+    srand(7);
+    for (size_t i = 0; i < count; i++) {
+        const char* prefix = prefixes[rand() % 4];
+        const size_t prefix_len = strlen(prefix);
+        memcpy(buffer, prefix, prefix_len);
+
+        const size_t len = prefix_len + (size_t) rand() % 12;
+        for (size_t j = prefix_len; j < len; j++) {
+            buffer[j] = (rand() % 16 == 0) ? '\0' : (char) ('a' + rand() % 3);
+        }
+
+        str_list_push(list, str_from_view(str_view_from_parts(buffer, len)));
+    }
+
+    return list;
+}
+
+static void sort_check(int (*sort)(str_list_t*), size_t count) {
+    str_list_t* list = sort_make_list(count);
+    str_t** expected = malloc(count * sizeof(str_t*));
+
+    memcpy(expected, list->buffer, count * sizeof(str_t*));
+    qsort(expected, count, sizeof(str_t*), sort_reference_cmp);
+
+    cr_assert_eq(sort(list), 0);
+    cr_assert_eq(str_list_size(list), count);
+
+    for (size_t i = 0; i < count; i++) {
+        cr_assert(str_eq(str_list_at(list, i), expected[i]));
+    }
+
+    free(expected);
+    str_list_drop(&list);
+}
+
+Test(str_list, sort) {
+    str_t* expected[] = {list_a->buffer[1], list_a->buffer[2], list_a->buffer[0]};
+
+    cr_assert_eq(str_list_sort(list_a), 0);
+    for (size_t i = 0; i < 3; i++) {
+        cr_assert_eq(str_list_at(list_a, i), expected[i]);
+    }
+
+    cr_assert_eq(str_list_sort(list_empty), 0);
+    cr_assert_neq(str_list_sort(NULL), 0);
+
+    sort_check(str_list_sort, 10);
+    sort_check(str_list_sort, 20000);
+}
+
+Test(str_list, sort_stable) {
+    sort_check(str_list_sort_stable, 10);
+    sort_check(str_list_sort_stable, 20000);
+
+    /* Equal strings keep their order */
+    str_list_t* list = str_list_new();
+    str_t* items[200];
+
+    for (size_t i = 0; i < 200; i++) {
+        items[i] = str_new((i % 3 == 0) ? "https://example.com/b" : "https://example.com/a");
+        str_list_push(list, items[i]);
+    }
+
+    cr_assert_eq(str_list_sort_stable(list), 0);
+
+    size_t pos = 0;
+    for (size_t i = 0; i < 200; i++) {
+        if (i % 3 != 0) {
+            cr_assert_eq(str_list_at(list, pos++), items[i]);
+        }
+    }
+    for (size_t i = 0; i < 200; i += 3) {
+        cr_assert_eq(str_list_at(list, pos++), items[i]);
+    }
+
+    str_list_drop(&list);
+    cr_assert_neq(str_list_sort_stable(NULL), 0);
+}
+
+Test(str_list, par_sort) {
+    const size_t count = 50000;
+    const size_t thread_counts[] = {1, 2, 3, 8, 0};
+    str_list_t* list = sort_make_list(count);
+    str_t** original = malloc(count * sizeof(str_t*));
+    str_t** expected = malloc(count * sizeof(str_t*));
+
+    memcpy(original, list->buffer, count * sizeof(str_t*));
+    cr_assert_eq(str_list_sort_stable(list), 0);
+    memcpy(expected, list->buffer, count * sizeof(str_t*));
+
+    /* Result is the same as the one of the stable sort for any thread count */
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+        memcpy(list->buffer, original, count * sizeof(str_t*));
+        cr_assert_eq(str_list_par_sort(list, thread_counts[t]), 0);
+        cr_assert_eq(str_list_size(list), count);
+        cr_assert_arr_eq(list->buffer, expected, count * sizeof(str_t*));
+    }
+
+    cr_assert_eq(str_list_par_sort(list_a, 4), 0);
+    cr_assert_str_eq(str_as_ptr(str_list_at(list_a, 0)), "bar");
+    cr_assert_neq(str_list_par_sort(NULL, 4), 0);
+
+    free(expected);
+    free(original);
+    str_list_drop(&list);
+}
+
+Test(str_list, par_dedup) {
+    const size_t count = 50000;
+    str_list_t* list = sort_make_list(count);
+    str_t** expected = malloc(count * sizeof(str_t*));
+    size_t expected_size = 0;
+
+    str_list_t* copy = str_list_copy(list);
+    cr_assert_eq(str_list_sort_stable(list), 0);
+
+    /* First of the equal strings in the list order is kept */
+    for (size_t i = 0; i < count; i++) {
+        if ((expected_size == 0) || !str_eq(expected[expected_size - 1], list->buffer[i])) {
+            expected[expected_size++] = list->buffer[i];
+        }
+    }
+
+    cr_assert_eq(str_list_par_dedup(copy, 4), 0);
+    cr_assert_eq(str_list_size(copy), expected_size);
+    cr_assert_lt(expected_size, count);
+
+    for (size_t i = 0; i < expected_size; i++) {
+        cr_assert(str_eq(str_list_at(copy, i), expected[i]));
+    }
+
+    cr_assert_eq(str_list_par_dedup(list, 1), 0);
+    cr_assert_arr_eq(list->buffer, expected, expected_size * sizeof(str_t*));
+
+    cr_assert_eq(str_list_par_dedup(list_empty, 4), 0);
+    cr_assert_neq(str_list_par_dedup(NULL, 4), 0);
+
+    free(expected);
+    str_list_drop(&copy);
+    str_list_drop(&list);
+}
+
+struct owner_stats {
+    pthread_t owner;
+    atomic_size_t foreign_frees;
+};
+
+static void* owner_alloc(void* ctx, size_t size) {
+    (void) ctx;
+    return malloc(size);
+}
+
+static void* owner_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size) {
+    (void) ctx;
+    (void) old_size;
+    return realloc(ptr, new_size);
+}
+
+static void owner_free(void* ctx, void* ptr) {
+    struct owner_stats* self = ctx;
+    if (!pthread_equal(self->owner, pthread_self())) {
+        atomic_fetch_add(&self->foreign_frees, 1);
+    }
+    free(ptr);
+}
+
+Test(str_list, par_dedup_string_allocator) {
+    struct owner_stats owner = {.owner = pthread_self()};
+    const ustring_allocator_t allocator = {
+        .alloc = owner_alloc,
+        .realloc = owner_realloc,
+        .free = owner_free,
+        .ctx = &owner,
+    };
+    str_list_t* list = str_list_with_capacity(50000);
+    char buffer[32];
+
+    atomic_init(&owner.foreign_frees, 0);
+
+    for (size_t i = 0; i < 50000; i++) {
+        snprintf(buffer, sizeof(buffer), "item %zu", (i * 7919) % 1000);
+        str_list_push(list, str_new_alloc(&allocator, buffer));
+    }
+
+    /* Strings allocator, unlike the list one, is called only by the calling thread */
+    cr_assert_eq(str_list_par_dedup(list, 4), 0);
+    cr_assert_eq(str_list_size(list), 1000);
+    cr_assert_eq(atomic_load(&owner.foreign_frees), 0);
+
+    str_list_drop(&list);
+}
+
+/* About 1 MB of tokens separated by runs of delimiters */
+static str_t* split_make_input(void) {
+    str_t* input = str_with_capacity(1 << 20);
+    char buffer[32];
+
+    srand(11);
+    while (str_len(input) < (1 << 20) - 64) {
+        const size_t len = (size_t) rand() % 20;
+        for (size_t j = 0; j < len; j++) {
+            buffer[j] = (rand() % 8 == 0) ? ",; "[rand() % 3] : (char) ('a' + rand() % 26);
+        }
+        buffer[len] = '\0';
+        str_append(input, buffer);
+    }
+
+    return input;
+}
+
+Test(str_list, par_split) {
+    str_t* input = split_make_input();
+    str_list_t* expected = str_split(input, ",; ");
+    const size_t thread_counts[] = {1, 4, 16, 0};
+
+    cr_assert_gt(str_list_size(expected), 1000);
+
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+        str_list_t* list = str_par_split(input, ",; ", thread_counts[t]);
+        cr_assert_not_null(list);
+        cr_assert_eq(str_list_size(list), str_list_size(expected));
+
+        for (size_t i = 0; i < str_list_size(list); i++) {
+            cr_assert(str_eq(str_list_at(list, i), str_list_at(expected, i)));
+        }
+
+        str_list_drop(&list);
+    }
+
+    /* Input without delimiters is a single token */
+    str_list_t* list = str_par_split(input, "#", 8);
+    cr_assert_eq(str_list_size(list), 1);
+    cr_assert(str_eq(str_list_at(list, 0), input));
+    str_list_drop(&list);
+
+    list = str_par_split(NULL, ",", 8);
+    cr_assert_not_null(list);
+    cr_assert(str_list_is_empty(list));
+    str_list_drop(&list);
+
+    str_list_drop(&expected);
+    str_drop(&input);
+}
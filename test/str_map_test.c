@@ -0,0 +1,294 @@
+#include <stdio.h>
+
+#include <criterion/criterion.h>
+
+#include <ustring/str.h>
+#include <ustring/str_list.h>
+#include <ustring/str_map.h>
+#include <ustring/str_view.h>
+#include "../src/str_p.h"
+#include "../src/str_map_p.h"
+#include "test_alloc.h"
+
+static str_map_t* map;
+static str_set_t* set;
+
+static void setup(void) {
+    map = str_map_new();
+    set = str_set_new();
+}
+
+static void teardown(void) {
+    str_map_drop(&map);
+    str_set_drop(&set);
+}
+
+TestSuite(str_map, .init = setup, .fini = teardown);
+
+Test(str_map, new) {
+    cr_assert_not_null(map);
+    cr_assert_eq(str_map_size(map), 0);
+    cr_assert(str_map_is_empty(map));
+    cr_assert_null(str_map_find_cstr(map, "Pull"));
+    cr_assert_not(str_map_erase_cstr(map, "Pull"));
+
+    str_map_t* reserved = str_map_with_capacity(100);
+    cr_assert_not_null(reserved);
+    cr_assert_geq(reserved->table.growth_left, 100);
+    str_map_drop(&reserved);
+    cr_assert_null(reserved);
+
+    cr_assert_eq(str_map_size(NULL), 0);
+    cr_assert(str_map_is_empty(NULL));
+    str_map_drop(NULL);
+}
+
+Test(str_map, insert) {
+    int a = 1;
+    int b = 2;
+
+    cr_assert_eq(str_map_insert_cstr(map, "Pull", &a), 0);
+    cr_assert_eq(str_map_insert_cstr(map, "Bear", &b), 0);
+    cr_assert_eq(str_map_size(map), 2);
+
+    /* Existing key gets the new value */
+    cr_assert_eq(str_map_insert_cstr(map, "Pull", &b), 0);
+    cr_assert_eq(str_map_size(map), 2);
+    cr_assert_eq(*str_map_find_cstr(map, "Pull"), &b);
+
+    /* Map keeps its own copy of the key */
+    char key[] = "Zara";
+    cr_assert_eq(str_map_insert_cstr(map, key, &a), 0);
+    key[0] = 'z';
+    cr_assert_eq(*str_map_find_cstr(map, "Zara"), &a);
+    cr_assert_null(str_map_find_cstr(map, "zara"));
+
+    cr_assert_neq(str_map_insert_cstr(NULL, "Pull", &a), 0);
+    cr_assert_neq(str_map_insert_cstr(map, NULL, &a), 0);
+    cr_assert_neq(str_map_insert(map, NULL, &a), 0);
+}
+
+Test(str_map, find) {
+    int value = 1;
+    str_t* key = str_new("Pull & Bear");
+
+    cr_assert_eq(str_map_insert(map, key, &value), 0);
+    cr_assert_eq(str_map_insert_cstr(map, "", NULL), 0);
+
+    /* String, C string and view of the same characters refer to the same key */
+    cr_assert_eq(*str_map_find(map, key), &value);
+    cr_assert_eq(*str_map_find_cstr(map, "Pull & Bear"), &value);
+    cr_assert_eq(*str_map_find_view(map, str_view_from_parts("Pull & Bear & Co", 11)), &value);
+    cr_assert_not_null(str_map_find_view(map, str_view_new(NULL)));
+    cr_assert_null(str_map_find_cstr(map, "Pull & Bea"));
+
+    /* Value may be updated through the returned pointer */
+    *str_map_find_cstr(map, "") = &value;
+    cr_assert_eq(*str_map_find_view(map, str_view_new("")), &value);
+
+    cr_assert_null(str_map_find(NULL, key));
+    cr_assert_null(str_map_find(map, NULL));
+    cr_assert_null(str_map_find_cstr(map, NULL));
+
+    str_drop(&key);
+}
+
+Test(str_map, non_ascii) {
+    /* Keys are stored as strings, so non-ASCII characters are replaced */
+    cr_assert_eq(str_map_insert_cstr(map, "Caf\xc3\xa9", NULL), 0);
+    cr_assert_not_null(str_map_find_cstr(map, "Caf??"));
+    cr_assert_not_null(str_map_find_cstr(map, "Caf\xc3\xa9"));
+    cr_assert_eq(str_map_insert_cstr(map, "Caf??", NULL), 0);
+    cr_assert_eq(str_map_size(map), 1);
+    cr_assert(str_map_erase_cstr(map, "Caf\xc3\xa9"));
+    cr_assert(str_map_is_empty(map));
+}
+
+Test(str_map, erase) {
+    cr_assert_eq(str_map_insert_cstr(map, "Pull", NULL), 0);
+    cr_assert_eq(str_map_insert_cstr(map, "Bear", NULL), 0);
+
+    cr_assert(str_map_erase_cstr(map, "Pull"));
+    cr_assert_not(str_map_erase_cstr(map, "Pull"));
+    cr_assert_null(str_map_find_cstr(map, "Pull"));
+    cr_assert_not_null(str_map_find_cstr(map, "Bear"));
+    cr_assert_eq(str_map_size(map), 1);
+
+    /* Erased key may be inserted again */
+    cr_assert_eq(str_map_insert_cstr(map, "Pull", NULL), 0);
+    cr_assert_not_null(str_map_find_cstr(map, "Pull"));
+    cr_assert_eq(str_map_size(map), 2);
+
+    cr_assert_not(str_map_erase(map, NULL));
+    cr_assert_not(str_map_erase_cstr(NULL, "Pull"));
+}
+
+Test(str_map, grow) {
+    char key[32];
+    static int values[10000];
+
+    for (size_t i = 0; i < 10000; i++) {
+        snprintf(key, sizeof(key), "key-%zu", i);
+        cr_assert_eq(str_map_insert_cstr(map, key, &values[i]), 0);
+    }
+
+    cr_assert_eq(str_map_size(map), 10000);
+    cr_assert_leq(map->table.size, map->table.cap - map->table.cap / 8);
+
+    for (size_t i = 0; i < 10000; i++) {
+        snprintf(key, sizeof(key), "key-%zu", i);
+        void** value = str_map_find_cstr(map, key);
+        cr_assert_not_null(value);
+        cr_assert_eq(*value, &values[i]);
+    }
+
+    cr_assert_null(str_map_find_cstr(map, "key-10000"));
+}
+
+Test(str_map, erase_reinsert) {
+    char key[32];
+
+    /* Deleted slots are reused or dropped without growing the half-empty table */
+    str_map_drop(&map);
+    map = str_map_with_capacity(128);
+
+    for (size_t i = 0; i < 64; i++) {
+        snprintf(key, sizeof(key), "key-%zu", i);
+        cr_assert_eq(str_map_insert_cstr(map, key, NULL), 0);
+    }
+
+    const size_t cap = map->table.cap;
+
+    for (size_t round = 0; round < 100; round++) {
+        for (size_t i = 0; i < 64; i++) {
+            snprintf(key, sizeof(key), "key-%zu", i);
+            cr_assert(str_map_erase_cstr(map, key));
+            snprintf(key, sizeof(key), "key-%zu-%zu", round, i);
+            cr_assert_eq(str_map_insert_cstr(map, key, NULL), 0);
+            cr_assert(str_map_erase_cstr(map, key));
+            snprintf(key, sizeof(key), "key-%zu", i);
+            cr_assert_eq(str_map_insert_cstr(map, key, NULL), 0);
+        }
+    }
+
+    cr_assert_eq(str_map_size(map), 64);
+    cr_assert_eq(map->table.cap, cap);
+
+    for (size_t i = 0; i < 64; i++) {
+        snprintf(key, sizeof(key), "key-%zu", i);
+        cr_assert_not_null(str_map_find_cstr(map, key));
+    }
+}
+
+Test(str_map, next) {
+    int values[3] = {0, 1, 2};
+    const char* keys[3] = {"One", "Two", "Three"};
+
+    for (size_t i = 0; i < 3; i++) {
+        cr_assert_eq(str_map_insert_cstr(map, keys[i], &values[i]), 0);
+    }
+
+    size_t pos = 0;
+    size_t count = 0;
+    const str_t* key;
+    void* value;
+    bool seen[3] = {false};
+
+    while (str_map_next(map, &pos, &key, &value)) {
+        const int idx = *(int*) value;
+        cr_assert_str_eq(str_as_ptr(key), keys[idx]);
+        cr_assert_not(seen[idx]);
+        seen[idx] = true;
+        count += 1;
+    }
+
+    cr_assert_eq(count, 3);
+    cr_assert_not(str_map_next(map, &pos, &key, &value));
+
+    pos = 0;
+    cr_assert_not(str_map_next(NULL, &pos, &key, &value));
+    cr_assert_not(str_map_next(map, NULL, &key, &value));
+}
+
+Test(str_map, clear) {
+    cr_assert_eq(str_map_insert_cstr(map, "Pull", NULL), 0);
+    cr_assert_eq(str_map_insert_cstr(map, "Bear", NULL), 0);
+
+    cr_assert_eq(str_map_clear(map), 0);
+    cr_assert(str_map_is_empty(map));
+    cr_assert_null(str_map_find_cstr(map, "Pull"));
+
+    cr_assert_eq(str_map_insert_cstr(map, "Pull", NULL), 0);
+    cr_assert_not_null(str_map_find_cstr(map, "Pull"));
+    cr_assert_neq(str_map_clear(NULL), 0);
+}
+
+Test(str_map, alloc) {
+    test_alloc_stats_t stats;
+    ustring_allocator_t allocator = test_allocator(&stats);
+
+    str_map_t* local = str_map_with_capacity_alloc(&allocator, 0);
+    cr_assert_not_null(local);
+    cr_assert_eq(str_map_insert_cstr(local, "Pull", NULL), 0);
+    cr_assert_eq(str_map_insert_cstr(local, "Bear", NULL), 0);
+    cr_assert(str_map_erase_cstr(local, "Bear"));
+    str_map_drop(&local);
+
+    cr_assert_gt(stats.allocs, 0);
+    cr_assert_eq(stats.allocs, stats.frees);
+}
+
+Test(str_map, set) {
+    str_t* key = str_new("Pull");
+
+    cr_assert(str_set_is_empty(set));
+    cr_assert_eq(str_set_insert(set, key), 0);
+    cr_assert_eq(str_set_insert_cstr(set, "Pull"), 0);
+    cr_assert_eq(str_set_insert_view(set, str_view_new("Bear")), 0);
+    cr_assert_eq(str_set_size(set), 2);
+
+    cr_assert(str_set_contains(set, key));
+    cr_assert(str_set_contains_cstr(set, "Bear"));
+    cr_assert(str_set_contains_view(set, str_view_from_parts("Pull & Bear", 4)));
+    cr_assert_not(str_set_contains_cstr(set, "Zara"));
+
+    cr_assert(str_set_erase(set, key));
+    cr_assert_not(str_set_contains_cstr(set, "Pull"));
+    cr_assert_eq(str_set_size(set), 1);
+
+    size_t pos = 0;
+    const str_t* item;
+    cr_assert(str_set_next(set, &pos, &item));
+    cr_assert_str_eq(str_as_ptr(item), "Bear");
+    cr_assert_not(str_set_next(set, &pos, &item));
+
+    cr_assert_eq(str_set_clear(set), 0);
+    cr_assert(str_set_is_empty(set));
+
+    cr_assert_not(str_set_contains(NULL, key));
+    cr_assert_not(str_set_contains(set, NULL));
+    cr_assert_neq(str_set_insert(NULL, key), 0);
+
+    str_drop(&key);
+}
+
+Test(str_map, set_from_list) {
+    str_t* string = str_new("a b a c b a");
+    str_list_t* list = str_split_whitespace(string);
+
+    str_set_t* distinct = str_set_from_list(list);
+    cr_assert_not_null(distinct);
+    cr_assert_eq(str_set_size(distinct), 3);
+    cr_assert(str_set_contains_cstr(distinct, "a"));
+    cr_assert(str_set_contains_cstr(distinct, "b"));
+    cr_assert(str_set_contains_cstr(distinct, "c"));
+    str_set_drop(&distinct);
+
+    distinct = str_set_from_list(NULL);
+    cr_assert_not_null(distinct);
+    cr_assert(str_set_is_empty(distinct));
+    str_set_drop(&distinct);
+
+    str_list_drop(&list);
+    str_drop(&string);
+}
@@ -0,0 +1,208 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+
+#include <ustring/str.h>
+#include <ustring/str_matcher.h>
+#include "../src/str_p.h"
+#include "../src/str_matcher_p.h"
+#include "test_alloc.h"
+
+static const char* patterns[] = {"password", "pass", "token", "ken", "", NULL, "pass"};
+static const char* replacements[] = {"********", "****", "*****", "K", "empty", "null", "duplicate"};
+
+static str_matcher_t* matcher;
+
+static void setup(void) {
+    matcher = str_matcher_new(patterns, sizeof(patterns) / sizeof(patterns[0]));
+}
+
+static void teardown(void) {
+    str_matcher_drop(&matcher);
+}
+
+TestSuite(str_matcher, .init = setup, .fini = teardown);
+
+/**
+ * @brief Reference leftmost-longest replacement checking every pattern at every position
+ */
+static char* matcher_reference(const char* text, const char* const* from, const char* const* to, size_t count) {
+    const size_t len = strlen(text);
+    size_t max_to = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        max_to = (strlen(to[i]) > max_to) ? strlen(to[i]) : max_to;
+    }
+
+    char* result = malloc(len * (max_to + 1) + 1);
+    size_t write_idx = 0;
+    size_t read_idx = 0;
+
+    while (read_idx < len) {
+        size_t best = count;
+
+        for (size_t i = 0; i < count; i++) {
+            const size_t from_len = strlen(from[i]);
+            if ((from_len != 0) && (strncmp(text + read_idx, from[i], from_len) == 0)
+                && ((best == count) || (from_len > strlen(from[best]))))
+            {
+                best = i;
+            }
+        }
+
+        if (best == count) {
+            result[write_idx++] = text[read_idx++];
+        } else {
+            memcpy(result + write_idx, to[best], strlen(to[best]));
+            write_idx += strlen(to[best]);
+            read_idx += strlen(from[best]);
+        }
+    }
+
+    result[write_idx] = '\0';
+
+    return result;
+}
+
+Test(str_matcher, new) {
+    cr_assert_not_null(matcher);
+    cr_assert_eq(str_matcher_size(matcher), 7);
+    cr_assert_eq(str_matcher_size(NULL), 0);
+
+    str_matcher_t* empty = str_matcher_new(NULL, 0);
+    cr_assert_not_null(empty);
+    cr_assert_eq(str_matcher_size(empty), 0);
+    str_matcher_drop(&empty);
+    cr_assert_null(empty);
+
+    cr_assert_null(str_matcher_new(NULL, 1));
+    str_matcher_drop(NULL);
+}
+
+Test(str_matcher, alloc) {
+    test_alloc_stats_t stats;
+    ustring_allocator_t allocator = test_allocator(&stats);
+
+    str_matcher_t* local = str_matcher_new_alloc(&allocator, patterns, 4);
+    cr_assert_not_null(local);
+    str_matcher_drop(&local);
+
+    cr_assert_gt(stats.allocs, 0);
+    cr_assert_eq(stats.allocs, stats.frees);
+}
+
+Test(str_matcher, contains_any) {
+    str_t* string = str_new("user=bob tok=1");
+
+    cr_assert_not(str_contains_any(string, matcher));
+    str_append(string, " kenny");
+    cr_assert(str_contains_any(string, matcher));
+
+    str_t* empty = str_new("");
+    cr_assert_not(str_contains_any(empty, matcher));
+    cr_assert_not(str_contains_any(NULL, matcher));
+    cr_assert_not(str_contains_any(string, NULL));
+
+    str_drop(&empty);
+    str_drop(&string);
+}
+
+Test(str_matcher, find_any) {
+    size_t pattern = 0;
+    str_t* string = str_new("my passwords");
+
+    /* Longest of the patterns starting at the same position wins */
+    cr_assert_eq(str_find_any(string, matcher, &pattern), 3);
+    cr_assert_eq(pattern, 0);
+
+    /* Leftmost pattern wins over the longer one starting later */
+    const char* overlapping[] = {"bcdef", "abc"};
+    str_matcher_t* local = str_matcher_new(overlapping, 2);
+    str_t* text = str_new("xabcdefg");
+    cr_assert_eq(str_find_any(text, local, &pattern), 1);
+    cr_assert_eq(pattern, 1);
+
+    cr_assert_eq(str_find_any(text, matcher, NULL), STR_NPOS);
+    cr_assert_eq(str_find_any(NULL, matcher, NULL), STR_NPOS);
+
+    str_drop(&text);
+    str_matcher_drop(&local);
+    str_drop(&string);
+}
+
+Test(str_matcher, replace_many) {
+    str_t* string = str_new("password=pass token=tokens passport");
+
+    /* Shrink or keep length: in place */
+    const char* shrink[] = {"***", "*", "-", "k", "", "", ""};
+    const char* buffer = str_as_ptr(string);
+    cr_assert_eq(str_replace_many(string, matcher, shrink), 0);
+    cr_assert_str_eq(str_as_ptr(string), "***=* -=-s *port");
+    cr_assert_eq(str_as_ptr(string), buffer);
+
+    /* Grow: single buffer of the exact size */
+    str_t* grow = str_new("password=pass token=kenny");
+    cr_assert_eq(str_replace_many(grow, matcher, replacements), 0);
+    cr_assert_str_eq(str_as_ptr(grow), "********=**** *****=Kny");
+    cr_assert_eq(str_cap(grow), str_len(grow) + 1);
+
+    /* No match leaves the string as is */
+    cr_assert_eq(str_replace_many(grow, matcher, replacements), 0);
+    cr_assert_str_eq(str_as_ptr(grow), "********=**** *****=Kny");
+
+    const char* with_null[] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+    str_t* removed = str_new("a token, a pass");
+    cr_assert_eq(str_replace_many(removed, matcher, with_null), 0);
+    cr_assert_str_eq(str_as_ptr(removed), "a , a ");
+
+    cr_assert_neq(str_replace_many(NULL, matcher, replacements), 0);
+    cr_assert_neq(str_replace_many(string, NULL, replacements), 0);
+    cr_assert_neq(str_replace_many(string, matcher, NULL), 0);
+
+    str_drop(&removed);
+    str_drop(&grow);
+    str_drop(&string);
+}
+
+Test(str_matcher, replace_many_shared) {
+    str_t* string = str_new("token");
+    str_make_shared(string);
+    str_t* copy = str_copy(string);
+
+    cr_assert_eq(str_replace_many(copy, matcher, replacements), 0);
+    cr_assert_str_eq(str_as_ptr(copy), "*****");
+    cr_assert_str_eq(str_as_ptr(string), "token");
+
+    str_drop(&copy);
+    str_drop(&string);
+}
+
+Test(str_matcher, random) {
+    const char* from[] = {"ab", "abc", "bca", "c", "aaaa", "cab", "bb"};
+    const char* to[] = {"X", "YYYY", "", "cc", "Z", "WW", "bbb"};
+    const size_t count = sizeof(from) / sizeof(from[0]);
+    str_matcher_t* local = str_matcher_new(from, count);
+    char text[512];
+
+    srand(11);
+    for (size_t n = 0; n < 200; n++) {
+        const size_t len = (size_t) rand() % (sizeof(text) - 1);
+        for (size_t i = 0; i < len; i++) {
+            /* Long runs of characters no pattern starts with are skipped */
+            text[i] = ((n % 2 == 1) && ((i / 40) % 3 == 0)) ? 'd' : "abcd"[rand() % 4];
+        }
+        text[len] = '\0';
+
+        char* expected = matcher_reference(text, from, to, count);
+        str_t* string = str_new(text);
+
+        cr_assert_eq(str_replace_many(string, local, to), 0);
+        cr_assert_str_eq(str_as_ptr(string), expected);
+
+        free(expected);
+        str_drop(&string);
+    }
+
+    str_matcher_drop(&local);
+}
@@ -0,0 +1,161 @@
+#include <string.h>
+
+#include <criterion/criterion.h>
+
+#include <ustring/str.h>
+#include <ustring/str_pattern.h>
+#include "test_alloc.h"
+
+#define LONG_PATTERN "0123456789abcdefghijklmnopqrstuvwxyzABCDEF"
+
+static str_pattern_t* dash;
+static str_pattern_t* long_pattern;
+static str_pattern_t* empty;
+
+static void setup(void) {
+    dash = str_pattern_compile("--");
+    long_pattern = str_pattern_compile(LONG_PATTERN);
+    empty = str_pattern_compile("");
+}
+
+static void teardown(void) {
+    str_pattern_drop(&dash);
+    str_pattern_drop(&long_pattern);
+    str_pattern_drop(&empty);
+}
+
+TestSuite(str_pattern, .init = setup, .fini = teardown);
+
+Test(str_pattern, compile) {
+    cr_assert_eq(str_pattern_len(dash), 2);
+    cr_assert_str_eq(str_pattern_as_ptr(dash), "--");
+    cr_assert_eq(str_pattern_len(long_pattern), strlen(LONG_PATTERN));
+    cr_assert_str_eq(str_pattern_as_ptr(long_pattern), LONG_PATTERN);
+    cr_assert_eq(str_pattern_len(empty), 0);
+
+    cr_assert_null(str_pattern_compile(NULL));
+    cr_assert_eq(str_pattern_len(NULL), 0);
+    cr_assert_null(str_pattern_as_ptr(NULL));
+
+    test_alloc_stats_t stats;
+    ustring_allocator_t allocator = test_allocator(&stats);
+
+    str_pattern_t* local = str_pattern_compile_alloc(&allocator, LONG_PATTERN);
+    cr_assert_not_null(local);
+    str_pattern_drop(&local);
+    cr_assert_null(local);
+    str_pattern_drop(NULL);
+
+    cr_assert_eq(stats.allocs, 1);
+    cr_assert_eq(stats.frees, 1);
+}
+
+Test(str_pattern, find) {
+    str_t* string = str_new("a--b--c-" LONG_PATTERN "-" LONG_PATTERN);
+
+    cr_assert(str_contains_pat(string, dash));
+    cr_assert_eq(str_find_pat(string, dash), 1);
+    cr_assert_eq(str_find_from_pat(string, dash, 2), 4);
+    cr_assert_eq(str_find_from_pat(string, dash, 5), STR_NPOS);
+
+    cr_assert_eq(str_find_pat(string, long_pattern), 8);
+    cr_assert_eq(str_find_from_pat(string, long_pattern, 9), 9 + strlen(LONG_PATTERN));
+    cr_assert_eq(str_find_pat(string, empty), 0);
+
+    cr_assert_eq(str_find_from_pat(string, dash, str_len(string) + 1), STR_NPOS);
+    cr_assert_not(str_contains_pat(NULL, dash));
+    cr_assert_not(str_contains_pat(string, NULL));
+
+    str_drop(&string);
+}
+
+Test(str_pattern, starts_ends_with) {
+    str_t* string = str_new("--x--");
+    str_t* empty_string = str_new("");
+
+    cr_assert(str_starts_with_pat(string, dash));
+    cr_assert(str_ends_with_pat(string, dash));
+    cr_assert_not(str_starts_with_pat(string, long_pattern));
+    cr_assert(str_starts_with_pat(string, empty));
+    cr_assert(str_ends_with_pat(empty_string, empty));
+    cr_assert_not(str_ends_with_pat(empty_string, dash));
+    cr_assert_not(str_starts_with_pat(NULL, dash));
+
+    str_drop(&empty_string);
+    str_drop(&string);
+}
+
+Test(str_pattern, trim) {
+    str_t* string = str_new("----a--b----");
+
+    cr_assert_eq(str_trim_start_matches_pat(string, dash), 0);
+    cr_assert_str_eq(str_as_ptr(string), "--a--b----");
+    cr_assert_eq(str_trim_end_matches_pat(string, dash), 0);
+    cr_assert_str_eq(str_as_ptr(string), "--a--b--");
+    cr_assert_eq(str_trim_matches_pat(string, dash), 0);
+    cr_assert_str_eq(str_as_ptr(string), "ab");
+    cr_assert_eq(str_trim_matches_pat(string, empty), 0);
+    cr_assert_str_eq(str_as_ptr(string), "ab");
+
+    cr_assert_neq(str_trim_matches_pat(string, NULL), 0);
+    cr_assert_neq(str_trim_start_matches_pat(NULL, dash), 0);
+    cr_assert_neq(str_trim_end_matches_pat(string, NULL), 0);
+
+    str_drop(&string);
+}
+
+Test(str_pattern, replace) {
+    str_t* string = str_new("a--b--c--d");
+
+    cr_assert_eq(str_replacen_pat(string, dash, "+", 2), 0);
+    cr_assert_str_eq(str_as_ptr(string), "a+b+c--d");
+    cr_assert_eq(str_replace_pat(string, dash, "<->"), 0);
+    cr_assert_str_eq(str_as_ptr(string), "a+b+c<->d");
+
+    /* Long compiled pattern gives the same result as the plain one */
+    str_t* compiled = str_new(LONG_PATTERN "x" LONG_PATTERN LONG_PATTERN "y");
+    str_t* plain = str_copy(compiled);
+    cr_assert_eq(str_replace_pat(compiled, long_pattern, "L"), 0);
+    cr_assert_eq(str_replace(plain, LONG_PATTERN, "L"), 0);
+    cr_assert_str_eq(str_as_ptr(compiled), "LxLLy");
+    cr_assert(str_eq(compiled, plain));
+
+    cr_assert_neq(str_replace_pat(NULL, dash, "x"), 0);
+    cr_assert_neq(str_replace_pat(string, NULL, "x"), 0);
+
+    str_drop(&plain);
+    str_drop(&compiled);
+    str_drop(&string);
+}
+
+Test(str_pattern, non_ascii) {
+    /* Non-ASCII characters of the string are replaced with '?', of the pattern are kept */
+    const char* needles[] = {"\xC3\xA9", "\xC3\xA9" LONG_PATTERN};
+    const char* texts[] = {"x??y", "x??" LONG_PATTERN "y"};
+
+    for (size_t i = 0; i < 2; i++) {
+        str_pattern_t* pattern = str_pattern_compile(needles[i]);
+        str_t* compiled = str_new(texts[i]);
+        str_t* plain = str_new(texts[i]);
+
+        cr_assert_eq(str_pattern_len(pattern), strlen(needles[i]));
+        cr_assert_arr_eq(str_pattern_as_ptr(pattern), needles[i], strlen(needles[i]) + 1);
+
+        cr_assert_eq(str_contains_pat(compiled, pattern), str_contains(plain, needles[i]));
+        cr_assert_eq(str_find_pat(compiled, pattern), str_find(plain, needles[i]));
+        cr_assert_not(str_contains_pat(compiled, pattern));
+
+        cr_assert_eq(str_replace_pat(compiled, pattern, "e"), 0);
+        cr_assert_eq(str_replace(plain, needles[i], "e"), 0);
+        cr_assert_str_eq(str_as_ptr(compiled), str_as_ptr(plain));
+
+        cr_assert_eq(str_trim_matches_pat(compiled, pattern), 0);
+        cr_assert_eq(str_trim_matches(plain, needles[i]), 0);
+        cr_assert_str_eq(str_as_ptr(compiled), texts[i]);
+        cr_assert_str_eq(str_as_ptr(plain), texts[i]);
+
+        str_drop(&plain);
+        str_drop(&compiled);
+        str_pattern_drop(&pattern);
+    }
+}
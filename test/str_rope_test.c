@@ -0,0 +1,285 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <criterion/criterion.h>
+
+#include <ustring/str.h>
+#include <ustring/str_rope.h>
+#include <ustring/str_view.h>
+#include "../src/str_p.h"
+#include "../src/str_rope_p.h"
+#include "test_alloc.h"
+
+static str_rope_t* rope;
+
+static void setup(void) {
+    rope = str_rope_from_view(str_view_new("Pull & Bear"));
+}
+
+static void teardown(void) {
+    str_rope_drop(&rope);
+}
+
+TestSuite(str_rope, .init = setup, .fini = teardown);
+
+/**
+ * @brief Checks rope characters against the expected C string
+ */
+static void rope_check(const str_rope_t* self, const char* expected) {
+    str_t* flat = str_rope_to_str(self);
+
+    cr_assert_not_null(flat);
+    cr_assert_eq(str_rope_len(self), strlen(expected));
+    cr_assert_eq(str_len(flat), strlen(expected));
+    cr_assert_eq(memcmp(str_as_ptr(flat), expected, strlen(expected)), 0);
+
+    str_drop(&flat);
+}
+
+/**
+ * @brief Returns the number of chunks and checks no chunk is empty
+ */
+static size_t rope_chunk_count(const str_rope_t* self) {
+    size_t pos = 0;
+    size_t count = 0;
+    str_view_t chunk;
+
+    while (str_rope_next_chunk(self, &pos, &chunk)) {
+        cr_assert_gt(chunk.len, 0);
+        count += 1;
+    }
+
+    cr_assert_eq(pos, str_rope_len(self));
+
+    return count;
+}
+
+static char* rope_make_text(size_t len) {
+    char* text = malloc(len + 1);
+
+    for (size_t i = 0; i < len; i++) {
+        text[i] = 'a' + (char) (i % 26);
+    }
+    text[len] = '\0';
+
+    return text;
+}
+
+Test(str_rope, new) {
+    str_rope_t* empty = str_rope_new();
+
+    cr_assert_not_null(empty);
+    cr_assert_eq(str_rope_len(empty), 0);
+    cr_assert_eq(str_rope_len(NULL), 0);
+    rope_check(empty, "");
+    str_rope_drop(&empty);
+    cr_assert_null(empty);
+
+    rope_check(rope, "Pull & Bear");
+
+    char* text = rope_make_text(5000);
+    str_rope_t* large = str_rope_from_view(str_view_new(text));
+    rope_check(large, text);
+    cr_assert_eq(rope_chunk_count(large), 5);
+    str_rope_drop(&large);
+    free(text);
+
+    str_rope_drop(NULL);
+}
+
+Test(str_rope, at) {
+    cr_assert_eq(str_rope_at(rope, 0), 'P');
+    cr_assert_eq(str_rope_at(rope, 10), 'r');
+    cr_assert_eq(str_rope_at(rope, 11), 0);
+    cr_assert_eq(str_rope_at(NULL, 0), 0);
+}
+
+Test(str_rope, insert) {
+    cr_assert_eq(str_rope_insert(rope, 4, str_view_new(" Cat")), 0);
+    rope_check(rope, "Pull Cat & Bear");
+    cr_assert_eq(str_rope_insert(rope, 0, str_view_new(">")), 0);
+    cr_assert_eq(str_rope_append(rope, str_view_new("<")), 0);
+    rope_check(rope, ">Pull Cat & Bear<");
+    cr_assert_eq(rope_chunk_count(rope), 1);
+
+    cr_assert_eq(str_rope_insert(rope, 3, str_view_new("")), 0);
+    cr_assert_neq(str_rope_insert(rope, 100, str_view_new("x")), 0);
+    cr_assert_neq(str_rope_insert(NULL, 0, str_view_new("x")), 0);
+    rope_check(rope, ">Pull Cat & Bear<");
+
+    /* Insertion into the full chunk cuts it */
+    char* text = rope_make_text(STR_ROPE_CHUNK_SIZE);
+    str_rope_t* full = str_rope_from_view(str_view_new(text));
+    cr_assert_eq(str_rope_insert(full, 10, str_view_new("XY")), 0);
+    cr_assert_eq(rope_chunk_count(full), 2);
+    cr_assert_eq(str_rope_at(full, 9), 'j');
+    cr_assert_eq(str_rope_at(full, 10), 'X');
+    cr_assert_eq(str_rope_at(full, 12), 'k');
+    cr_assert_eq(str_rope_len(full), STR_ROPE_CHUNK_SIZE + 2);
+    str_rope_drop(&full);
+    free(text);
+}
+
+Test(str_rope, erase) {
+    cr_assert_eq(str_rope_erase(rope, 4, 2), 0);
+    rope_check(rope, "Pull Bear");
+    cr_assert_eq(str_rope_erase(rope, 4, 100), 0);
+    rope_check(rope, "Pull");
+    cr_assert_eq(str_rope_erase(rope, 4, 1), 0);
+    cr_assert_neq(str_rope_erase(rope, 5, 1), 0);
+    cr_assert_eq(str_rope_erase(rope, 0, 4), 0);
+    rope_check(rope, "");
+    cr_assert_neq(str_rope_erase(NULL, 0, 1), 0);
+
+    /* Removal across chunks merges the remaining parts */
+    char* text = rope_make_text(3 * STR_ROPE_CHUNK_SIZE);
+    str_rope_t* large = str_rope_from_view(str_view_new(text));
+    cr_assert_eq(str_rope_erase(large, 100, 2 * STR_ROPE_CHUNK_SIZE), 0);
+    memmove(text + 100, text + 100 + 2 * STR_ROPE_CHUNK_SIZE, STR_ROPE_CHUNK_SIZE - 100 + 1);
+    rope_check(large, text);
+    cr_assert_eq(rope_chunk_count(large), 1);
+    str_rope_drop(&large);
+    free(text);
+}
+
+Test(str_rope, replace) {
+    cr_assert_eq(str_rope_replace(rope, 7, 4, str_view_new("Bull")), 0);
+    rope_check(rope, "Pull & Bull");
+    cr_assert_eq(str_rope_replace(rope, 0, 0, str_view_new("The ")), 0);
+    rope_check(rope, "The Pull & Bull");
+    cr_assert_neq(str_rope_replace(rope, 100, 0, str_view_new("x")), 0);
+}
+
+Test(str_rope, concat) {
+    str_rope_t* other = str_rope_from_view(str_view_new(" Co."));
+
+    cr_assert_eq(str_rope_concat(rope, other), 0);
+    rope_check(rope, "Pull & Bear Co.");
+    cr_assert_eq(str_rope_len(other), 0);
+    cr_assert_eq(rope_chunk_count(rope), 1);
+
+    cr_assert_neq(str_rope_concat(rope, rope), 0);
+    cr_assert_neq(str_rope_concat(rope, NULL), 0);
+    cr_assert_neq(str_rope_concat(NULL, other), 0);
+
+    test_alloc_stats_t stats;
+    ustring_allocator_t allocator = test_allocator(&stats);
+    str_rope_t* foreign = str_rope_new_alloc(&allocator);
+    cr_assert_neq(str_rope_concat(rope, foreign), 0);
+
+    str_rope_drop(&foreign);
+    str_rope_drop(&other);
+}
+
+Test(str_rope, split_off) {
+    str_rope_t* tail = str_rope_split_off(rope, 4);
+
+    cr_assert_not_null(tail);
+    rope_check(rope, "Pull");
+    rope_check(tail, " & Bear");
+
+    str_rope_t* empty = str_rope_split_off(rope, 4);
+    cr_assert_not_null(empty);
+    cr_assert_eq(str_rope_len(empty), 0);
+    cr_assert_null(str_rope_split_off(rope, 5));
+
+    str_rope_drop(&empty);
+    str_rope_drop(&tail);
+}
+
+Test(str_rope, substr) {
+    str_rope_t* sub = str_rope_substr(rope, 5, 100);
+    rope_check(sub, "& Bear");
+    str_rope_drop(&sub);
+
+    cr_assert_null(str_rope_substr(rope, 12, 1));
+
+    char* text = rope_make_text(4 * STR_ROPE_CHUNK_SIZE);
+    str_rope_t* large = str_rope_from_view(str_view_new(text));
+    sub = str_rope_substr(large, 1000, 2000);
+    text[3000] = '\0';
+    rope_check(sub, text + 1000);
+    str_rope_drop(&sub);
+    str_rope_drop(&large);
+    free(text);
+}
+
+Test(str_rope, next_chunk) {
+    size_t pos = 0;
+    str_view_t chunk;
+
+    cr_assert(str_rope_next_chunk(rope, &pos, &chunk));
+    cr_assert_eq(chunk.len, 11);
+    cr_assert_eq(memcmp(chunk.ptr, "Pull & Bear", 11), 0);
+    cr_assert_not(str_rope_next_chunk(rope, &pos, &chunk));
+
+    pos = 7;
+    cr_assert(str_rope_next_chunk(rope, &pos, &chunk));
+    cr_assert_eq(memcmp(chunk.ptr, "Bear", 4), 0);
+
+    cr_assert_not(str_rope_next_chunk(NULL, &pos, &chunk));
+    cr_assert_not(str_rope_next_chunk(rope, NULL, &chunk));
+}
+
+Test(str_rope, to_str) {
+    str_t* flat = str_rope_to_str(rope);
+    cr_assert_str_eq(str_as_ptr(flat), "Pull & Bear");
+    str_drop(&flat);
+
+    flat = str_rope_to_str(NULL);
+    cr_assert_not_null(flat);
+    cr_assert_eq(str_len(flat), 0);
+    str_drop(&flat);
+}
+
+Test(str_rope, random_edits) {
+    test_alloc_stats_t stats;
+    ustring_allocator_t allocator = test_allocator(&stats);
+
+    const size_t max_len = 64 * STR_ROPE_CHUNK_SIZE;
+    char* expected = malloc(max_len + 2 * STR_ROPE_CHUNK_SIZE);
+    char* text = rope_make_text(2 * STR_ROPE_CHUNK_SIZE);
+    size_t len = 0;
+
+    str_rope_t* local = str_rope_new_alloc(&allocator);
+
+    srand(7);
+    for (size_t n = 0; n < 4000; n++) {
+        const size_t pos = (len == 0) ? 0 : (size_t) rand() % (len + 1);
+        const size_t count = ((rand() % 8) == 0)
+            ? (size_t) rand() % (2 * STR_ROPE_CHUNK_SIZE)
+            : (size_t) rand() % 16;
+
+        if ((len + count < max_len) && (rand() % 3 != 0)) {
+            cr_assert_eq(str_rope_insert(local, pos, str_view_from_parts(text, count)), 0);
+            memmove(expected + pos + count, expected + pos, len - pos);
+            memcpy(expected + pos, text, count);
+            len += count;
+        } else {
+            const size_t erased = (count < len - pos) ? count : len - pos;
+            cr_assert_eq(str_rope_erase(local, pos, count), 0);
+            memmove(expected + pos, expected + pos + erased, len - pos - erased);
+            len -= erased;
+        }
+
+        cr_assert_eq(str_rope_len(local), len);
+    }
+
+    expected[len] = '\0';
+    rope_check(local, expected);
+
+    /* Adjacent chunks never fit into one */
+    size_t pos = 0;
+    size_t prev_len = STR_ROPE_CHUNK_SIZE;
+    str_view_t chunk;
+    while (str_rope_next_chunk(local, &pos, &chunk)) {
+        cr_assert_gt(prev_len + chunk.len, STR_ROPE_CHUNK_SIZE);
+        prev_len = chunk.len;
+    }
+
+    str_rope_drop(&local);
+    cr_assert_eq(stats.allocs, stats.frees);
+
+    free(text);
+    free(expected);
+}
@@ -54,6 +54,66 @@ Test(str, new) {
     cr_assert_eq(string_empty_a->cap, STR_DEFAULT_CAPACITY);
 }
 
+Test(str, new_long) {
+    char long_string[200];
+    for (size_t i = 0; i < 199; i++) {
+        long_string[i] = 'a' + (i % 26);
+    }
+    long_string[199] = '\0';
+
+    str_t* string = str_new(long_string);
+    cr_assert_eq(string->len, 199);
+    cr_assert_str_eq(string->buffer, long_string);
+    str_drop(&string);
+
+    long_string[70] = (char) 0xC3;
+    long_string[198] = (char) 0xA9;
+    string = str_new(long_string + 1);
+    cr_assert_eq(string->len, 198);
+    cr_assert_eq(string->buffer[69], '?');
+    cr_assert_eq(string->buffer[197], '?');
+    cr_assert_eq(string->buffer[68], long_string[69]);
+    str_drop(&string);
+}
+
+Test(str, inline_buffer) {
+    /* Single allocation layout is disabled by the build configuration */
+    if (STR_INLINE_CAPACITY < STR_DEFAULT_CAPACITY) {
+        return;
+    }
+
+    cr_assert_eq(string_a->buffer, string_a->inline_buffer);
+    cr_assert_eq(string_empty_a->buffer, string_empty_a->inline_buffer);
+
+    str_t* string = str_new("short");
+    str_append(string, " string grows out of the inline buffer");
+    cr_assert_neq(string->buffer, string->inline_buffer);
+    cr_assert_str_eq(string->buffer, "short string grows out of the inline buffer");
+    cr_assert_gt(string->cap, STR_DEFAULT_CAPACITY);
+
+    str_truncate(string, 5);
+    str_shrink_to_fit(string);
+    cr_assert_eq(string->cap, 6);
+    cr_assert_str_eq(string->buffer, "short");
+
+    str_append(string, "er");
+    cr_assert_str_eq(string->buffer, "shorter");
+    str_drop(&string);
+
+    string = str_with_capacity(STR_INLINE_CAPACITY);
+    cr_assert_eq(string->buffer, string->inline_buffer);
+    str_drop(&string);
+
+    string = str_with_capacity(STR_INLINE_CAPACITY + 1);
+    cr_assert_neq(string->buffer, string->inline_buffer);
+    str_drop(&string);
+
+    str_t* copy = str_copy(string_a);
+    cr_assert_eq(copy->buffer, copy->inline_buffer);
+    cr_assert_str_eq(copy->buffer, "Pull & Bear");
+    str_drop(&copy);
+}
+
 Test(str, with_capacity) {
     str_t* string = str_with_capacity(128);
     
@@ -88,6 +148,145 @@ Test(str, copy) {
     str_drop(&copy);
 }
 
+Test(str, make_shared) {
+    cr_assert_not(str_is_shared(string_a));
+    cr_assert_not(str_is_shared(string_null));
+    cr_assert_neq(str_make_shared(string_null), 0);
+
+    cr_assert_eq(str_make_shared(string_a), 0);
+    cr_assert(str_is_shared(string_a));
+    cr_assert_str_eq(str_as_ptr(string_a), "Pull & Bear");
+    cr_assert_eq(str_make_shared(string_a), 0);
+
+    str_t* copy = str_copy(string_a);
+    cr_assert(str_is_shared(copy));
+    cr_assert_eq(copy->buffer, string_a->buffer);
+    cr_assert_eq(copy->len, string_a->len);
+    cr_assert_eq(atomic_load(&string_a->shared->refs), 2);
+
+    /* Modified copy gets its own characters, others are untouched */
+    cr_assert_eq(str_to_uppercase(copy), 0);
+    cr_assert_not(str_is_shared(copy));
+    cr_assert_str_eq(str_as_ptr(copy), "PULL & BEAR");
+    cr_assert_str_eq(str_as_ptr(string_a), "Pull & Bear");
+    cr_assert_eq(atomic_load(&string_a->shared->refs), 1);
+    str_drop(&copy);
+
+    copy = str_copy(string_a);
+    str_drop(&string_a);
+    cr_assert_eq(atomic_load(&copy->shared->refs), 1);
+    cr_assert_str_eq(str_as_ptr(copy), "Pull & Bear");
+
+    /* The last owner reuses the shared block */
+    cr_assert_not_null(str_append(copy, "!"));
+    cr_assert_not(str_is_shared(copy));
+    cr_assert_str_eq(str_as_ptr(copy), "Pull & Bear!");
+    str_drop(&copy);
+}
+
+Test(str, shared_copy_on_write) {
+    str_make_shared(string_b);
+
+    str_t* copy_a = str_copy(string_b);
+    str_t* copy_b = str_copy(string_b);
+    str_t* copy_c = str_copy(string_b);
+    str_t* copy_d = str_copy(string_b);
+
+    str_append(copy_a, " Four");
+    str_trim_matches(copy_b, "T");
+    str_replace(copy_c, "One", "Zero");
+    str_truncate(copy_d, 3);
+
+    cr_assert_str_eq(str_as_ptr(copy_a), "One Two Three Four");
+    cr_assert_str_eq(str_as_ptr(copy_b), "One wo hree");
+    cr_assert_str_eq(str_as_ptr(copy_c), "Zero Two Three");
+    cr_assert_str_eq(str_as_ptr(copy_d), "One");
+    cr_assert_str_eq(str_as_ptr(string_b), "One Two Three");
+    cr_assert_eq(atomic_load(&string_b->shared->refs), 1);
+
+    /* Shared buffer is not shrunk */
+    const size_t cap = str_cap(string_b);
+    cr_assert_eq(str_shrink_to_fit(string_b), 0);
+    cr_assert_eq(str_cap(string_b), cap);
+
+    str_drop(&copy_a);
+    str_drop(&copy_b);
+    str_drop(&copy_c);
+    str_drop(&copy_d);
+}
+
+Test(str, shared_no_op) {
+    str_make_shared(string_b);
+
+    str_t* copy = str_copy(string_b);
+    const char* buffer = str_as_ptr(copy);
+
+    /* Nothing is removed, characters stay shared */
+    cr_assert_eq(str_trim(copy), 0);
+    cr_assert_eq(str_truncate(copy, 100), 0);
+    cr_assert_eq(str_trim_matches_fn(copy, predicate_a), 0);
+    cr_assert_eq(str_trim_start_matches_fn(copy, predicate_b), 0);
+    cr_assert_eq(str_trim_end_matches_fn(copy, predicate_b), 0);
+    cr_assert(str_is_shared(copy));
+    cr_assert_eq(str_as_ptr(copy), buffer);
+    cr_assert_str_eq(str_as_ptr(copy), "One Two Three");
+
+    /* Cleared copy does not touch the shared characters */
+    cr_assert_eq(str_clear(copy), 0);
+    cr_assert_not(str_is_shared(copy));
+    cr_assert_str_eq(str_as_ptr(copy), "");
+    cr_assert_str_eq(str_as_ptr(string_b), "One Two Three");
+    cr_assert_eq(atomic_load(&string_b->shared->refs), 1);
+
+    str_append(copy, "Four Five Six Seven Eight Nine Ten Eleven");
+    cr_assert_str_eq(str_as_ptr(copy), "Four Five Six Seven Eight Nine Ten Eleven");
+
+    /* Sole owner reuses the block */
+    cr_assert_eq(str_clear(string_b), 0);
+    cr_assert_not(str_is_shared(string_b));
+    cr_assert_str_eq(str_as_ptr(string_b), "");
+
+    str_drop(&copy);
+}
+
+Test(str, shared_case_no_op) {
+    str_t* lower = str_new("already lower 123");
+    str_t* upper = str_new(NULL);
+    for (size_t i = 0; i < 40; i++) {
+        str_append(upper, "ALREADY UPPER 123 ");
+    }
+
+    str_make_shared(lower);
+    str_make_shared(upper);
+    str_t* lower_copy = str_copy(lower);
+    str_t* upper_copy = str_copy(upper);
+    const char* upper_buffer = str_as_ptr(upper_copy);
+
+    /* Nothing to convert, characters stay shared */
+    cr_assert_eq(str_to_lowercase(lower_copy), 0);
+    cr_assert_eq(str_to_uppercase(upper_copy), 0);
+    cr_assert(str_is_shared(lower_copy));
+    cr_assert(str_is_shared(upper_copy));
+    cr_assert_eq(str_as_ptr(upper_copy), upper_buffer);
+
+    /* Changed character past the first scanned block */
+    str_append(upper_copy, "x");
+    cr_assert_eq(str_to_uppercase(upper_copy), 0);
+    cr_assert_not(str_is_shared(upper_copy));
+    cr_assert(str_ends_with(upper_copy, "123 X"));
+    cr_assert(str_ends_with(upper, "123 "));
+
+    cr_assert_eq(str_to_uppercase(lower_copy), 0);
+    cr_assert_not(str_is_shared(lower_copy));
+    cr_assert_str_eq(str_as_ptr(lower_copy), "ALREADY LOWER 123");
+    cr_assert_str_eq(str_as_ptr(lower), "already lower 123");
+
+    str_drop(&upper_copy);
+    str_drop(&lower_copy);
+    str_drop(&upper);
+    str_drop(&lower);
+}
+
 Test(str, is_empty) {
     cr_assert_not(str_is_empty(string_a));
     cr_assert_not(str_is_empty(string_b));
@@ -115,6 +314,10 @@ Test(str, append) {
     cr_assert_str_eq(string_a->buffer, "Pull & Bear & Break");
     str_append(string_a, str_as_ptr(string_a));
     cr_assert_str_eq(string_a->buffer, "Pull & Bear & BreakPull & Bear & Break");
+    str_append(string_a, str_as_ptr(string_a) + 33);
+    cr_assert_str_eq(string_a->buffer, "Pull & Bear & BreakPull & Bear & BreakBreak");
+    str_append(string_b, "\xC3\xA9t\xC3\xA9 and more than thirty two characters\xFF");
+    cr_assert_str_eq(string_b->buffer, "One Two Three??t?? and more than thirty two characters?");
 }
 
 Test(str, clear) {
@@ -174,6 +377,83 @@ Test(str, eq) {
     cr_assert_not(str_eq(string_null, string_b));
 }
 
+Test(str, eq_long) {
+    char text[300];
+
+    for (size_t i = 0; i < 299; i++) {
+        text[i] = 'a' + (char) (i % 26);
+    }
+    text[299] = '\0';
+
+    /* Difference at every position of the vector blocks and the overlapped tail */
+    for (size_t len = 1; len < 100; len++) {
+        const char saved = text[len];
+        text[len] = '\0';
+        str_t* a = str_new(text);
+        str_t* b = str_new(text);
+        cr_assert(str_eq(a, b));
+
+        for (size_t i = 0; i < len; i++) {
+            b->buffer[i] = '#';
+            cr_assert_not(str_eq(a, b));
+            cr_assert_lt(str_cmp(b, a), 0);
+            b->buffer[i] = text[i];
+        }
+
+        str_drop(&b);
+        str_drop(&a);
+        text[len] = saved;
+    }
+}
+
+Test(str, cmp) {
+    str_t* apple = str_new("apple");
+    str_t* banana = str_new("banana");
+    str_t* apple_pie = str_new("apple pie");
+    str_t* upper = str_new("Apple");
+
+    cr_assert_eq(str_cmp(apple, banana), -1);
+    cr_assert_eq(str_cmp(banana, apple), 1);
+    cr_assert_eq(str_cmp(apple, apple_pie), -1);
+    cr_assert_eq(str_cmp(apple_pie, apple), 1);
+    cr_assert_eq(str_cmp(upper, apple), -1);
+    cr_assert_eq(str_cmp(string_a, string_a), 0);
+
+    str_t* copy = str_copy(apple);
+    cr_assert_eq(str_cmp(apple, copy), 0);
+    str_drop(&copy);
+
+    cr_assert_eq(str_cmp(string_empty_a, string_empty_b), 0);
+    cr_assert_eq(str_cmp(string_empty_a, apple), -1);
+    cr_assert_eq(str_cmp(string_null, string_empty_a), -1);
+    cr_assert_eq(str_cmp(apple, string_null), 1);
+    cr_assert_eq(str_cmp(string_null, string_null), 0);
+
+    str_drop(&upper);
+    str_drop(&apple_pie);
+    str_drop(&banana);
+    str_drop(&apple);
+}
+
+Test(str, cmp_prefix) {
+    str_t* apple = str_new("apple");
+    str_t* apple_pie = str_new("apple pie");
+    str_t* apricot = str_new("apricot");
+
+    cr_assert_eq(str_cmp_prefix(apple, apple_pie, 5), 0);
+    cr_assert_eq(str_cmp_prefix(apple, apple_pie, 6), -1);
+    cr_assert_eq(str_cmp_prefix(apple, apricot, 2), 0);
+    cr_assert_eq(str_cmp_prefix(apple, apricot, 3), -1);
+    cr_assert_eq(str_cmp_prefix(apricot, apple, 3), 1);
+    cr_assert_eq(str_cmp_prefix(apple, apricot, 0), 0);
+    cr_assert_eq(str_cmp_prefix(apple, apple_pie, STR_NPOS), str_cmp(apple, apple_pie));
+    cr_assert_eq(str_cmp_prefix(string_null, apple, 0), -1);
+
+    str_drop(&apricot);
+    str_drop(&apple_pie);
+    str_drop(&apple);
+}
+
 Test(str, truncate) {
     size_t old_len = string_a->len;
     str_truncate(string_a, string_a->len + 10);
@@ -201,6 +481,62 @@ Test(str, contains) {
     cr_assert_not(str_contains(NULL, NULL));
 }
 
+Test(str, contains_long) {
+    str_t* haystack = str_new(NULL);
+    for (size_t i = 0; i < 64; i++) {
+        str_append(haystack, "abcabcabd");
+    }
+    str_append(haystack, "the quick brown fox jumps over the lazy dog");
+
+    cr_assert(str_contains(haystack, "abd"));
+    cr_assert(str_contains(haystack, "dog"));
+    cr_assert(str_contains(haystack, "abcabdthe quick"));
+    cr_assert(str_contains(haystack, "quick brown fox jumps over the lazy dog"));
+    cr_assert_not(str_contains(haystack, "abcabcabcabc"));
+    cr_assert_not(str_contains(haystack, "quick brown fox jumps over the lazy cat"));
+    cr_assert_not(str_contains(haystack, "Z"));
+
+    str_drop(&haystack);
+}
+
+Test(str, find) {
+    cr_assert_eq(str_find(string_a, "Pull"), 0);
+    cr_assert_eq(str_find(string_a, "&"), 5);
+    cr_assert_eq(str_find(string_a, "Bear"), 7);
+    cr_assert_eq(str_find(string_a, ""), 0);
+    cr_assert_eq(str_find(string_a, "bear"), STR_NPOS);
+    cr_assert_eq(str_find(string_empty_a, ""), 0);
+    cr_assert_eq(str_find(string_empty_a, "a"), STR_NPOS);
+    cr_assert_eq(str_find(string_a, NULL), STR_NPOS);
+    cr_assert_eq(str_find(NULL, "a"), STR_NPOS);
+}
+
+Test(str, find_from) {
+    str_t* string = str_new("ab-ab-ab-abab");
+    size_t matches[8];
+    size_t count = 0;
+
+    size_t idx = str_find(string, "ab");
+    while (idx != STR_NPOS) {
+        matches[count++] = idx;
+        idx = str_find_from(string, "ab", idx + 2);
+    }
+
+    cr_assert_eq(count, 5);
+    cr_assert_eq(matches[0], 0);
+    cr_assert_eq(matches[1], 3);
+    cr_assert_eq(matches[2], 6);
+    cr_assert_eq(matches[3], 9);
+    cr_assert_eq(matches[4], 11);
+
+    cr_assert_eq(str_find_from(string, "-", 6), 8);
+    cr_assert_eq(str_find_from(string, "", 13), 13);
+    cr_assert_eq(str_find_from(string, "", 14), STR_NPOS);
+    cr_assert_eq(str_find_from(string, "b", 100), STR_NPOS);
+
+    str_drop(&string);
+}
+
 Test(str, contains_fn) {
     cr_assert(str_contains_fn(string_a, predicate_a));
     cr_assert_not(str_contains_fn(string_b, predicate_a));
@@ -354,6 +690,74 @@ Test(str, replace) {
 
     str_replace(string_a, "Pu", "Bu");
     cr_assert_str_eq(string_a->buffer, "BullBush");
+
+    str_t* string_long = str_new("<tag>-<tag>-<tag>-<tag>-<tag>-<tag>-<tag>-<tag>");
+    str_replace(string_long, "<tag>", "<very-long-replacement>");
+    cr_assert_str_eq(string_long->buffer,
+        "<very-long-replacement>-<very-long-replacement>-<very-long-replacement>-"
+        "<very-long-replacement>-<very-long-replacement>-<very-long-replacement>-"
+        "<very-long-replacement>-<very-long-replacement>");
+    str_replace(string_long, "<very-long-replacement>-<very-long-replacement>-", "x");
+    cr_assert_str_eq(string_long->buffer, "xxx<very-long-replacement>-<very-long-replacement>");
+    str_drop(&string_long);
+}
+
+Test(str, replace_in_place) {
+    str_t* string = str_with_capacity(128);
+    str_append(string, "a.b.c.d");
+    const char* buffer = string->buffer;
+
+    /* Shrink, equal size and grow within the capacity keep the buffer */
+    str_replace(string, ".", "");
+    cr_assert_str_eq(string->buffer, "abcd");
+    str_replace(string, "b", "B");
+    cr_assert_str_eq(string->buffer, "aBcd");
+    str_replace(string, "c", "<c>");
+    cr_assert_str_eq(string->buffer, "aB<c>d");
+    str_replace(string, "<c>", "<c><c>");
+    cr_assert_str_eq(string->buffer, "aB<c><c>d");
+    cr_assert_eq(string->buffer, buffer);
+    cr_assert_eq(string->cap, 128);
+
+    /* Grow beyond the capacity allocates the exact size */
+    str_t* grow = str_new("x-x-x-x-x-x-x-x-x-x-x-x-x-x-x-x-x-x-x-x-x-x-x-x-x-x-x-x-x-x-x-x");
+    str_replace(grow, "x", "xyz");
+    cr_assert_eq(str_len(grow), 127);
+    cr_assert_eq(str_cap(grow), 128);
+    cr_assert(str_starts_with(grow, "xyz-xyz-"));
+    cr_assert(str_ends_with(grow, "-xyz-xyz"));
+
+    /* Pattern and replacement pointing into the string itself */
+    str_t* self_ref = str_new("ab-ab-ab");
+    str_replace(self_ref, str_as_ptr(self_ref) + 6, str_as_ptr(self_ref) + 5);
+    cr_assert_str_eq(self_ref->buffer, "-ab--ab--ab");
+    str_replace(self_ref, str_as_ptr(self_ref) + 9, "");
+    cr_assert_str_eq(self_ref->buffer, "-----");
+
+    str_drop(&self_ref);
+    str_drop(&grow);
+    str_drop(&string);
+}
+
+Test(str, replacen) {
+    str_t* string = str_new("a-b-c-d-e");
+
+    cr_assert_eq(str_replacen(string, "-", "+", 2), 0);
+    cr_assert_str_eq(string->buffer, "a+b+c-d-e");
+
+    cr_assert_eq(str_replacen(string, "-", "--", 1), 0);
+    cr_assert_str_eq(string->buffer, "a+b+c--d-e");
+
+    cr_assert_eq(str_replacen(string, "+", NULL, 5), 0);
+    cr_assert_str_eq(string->buffer, "abc--d-e");
+
+    cr_assert_eq(str_replacen(string, "-", "x", 0), 0);
+    cr_assert_str_eq(string->buffer, "abc--d-e");
+
+    cr_assert_neq(str_replacen(NULL, "-", "x", 1), 0);
+    cr_assert_neq(str_replacen(string, NULL, "x", 1), 0);
+
+    str_drop(&string);
 }
 
 Test(str, starts_with) {
@@ -416,10 +820,135 @@ Test(str, to_uppercase) {
     str_to_uppercase(NULL);
 }
 
+Test(str, to_case_long) {
+    char text[300];
+    char lower[300];
+    char upper[300];
+
+    /* Every ASCII character at every position of the vector blocks and the tail */
+    for (size_t i = 0; i < 299; i++) {
+        const unsigned char ch = (unsigned char) (1 + (i * 7) % 127);
+        text[i] = (char) ch;
+        lower[i] = (char) tolower(ch);
+        upper[i] = (char) toupper(ch);
+    }
+    text[299] = lower[299] = upper[299] = '\0';
+
+    for (size_t offset = 0; offset < 40; offset++) {
+        str_t* string = str_new(text + offset);
+
+        str_to_lowercase(string);
+        cr_assert_arr_eq(str_as_ptr(string), lower + offset, 300 - offset);
+        str_to_uppercase(string);
+        cr_assert_arr_eq(str_as_ptr(string), upper + offset, 300 - offset);
+
+        str_drop(&string);
+    }
+}
+
+Test(str, eq_ignore_case) {
+    str_t* lower = str_new("pull & bear");
+    cr_assert(str_eq_ignore_case(string_a, lower));
+    cr_assert_not(str_eq_ignore_case(string_a, string_b));
+    cr_assert(str_eq_ignore_case(string_empty_a, string_empty_b));
+    cr_assert_not(str_eq_ignore_case(string_a, string_null));
+
+    /* Only letters are folded: '@' and '`' differ from 'A' and 'a' by the case bit */
+    str_t* at = str_new("@[");
+    str_t* grave = str_new("`{");
+    cr_assert_not(str_eq_ignore_case(at, grave));
+
+    str_t* long_a = str_new(NULL);
+    str_t* long_b = str_new(NULL);
+    for (size_t i = 0; i < 20; i++) {
+        str_append(long_a, "The Quick Brown Fox ");
+        str_append(long_b, "tHE qUICK bROWN fOX ");
+    }
+    cr_assert(str_eq_ignore_case(long_a, long_b));
+    str_append(long_a, "x");
+    str_append(long_b, "y");
+    cr_assert_not(str_eq_ignore_case(long_a, long_b));
+
+    str_drop(&long_b);
+    str_drop(&long_a);
+    str_drop(&grave);
+    str_drop(&at);
+    str_drop(&lower);
+}
+
+Test(str, cmp_ignore_case) {
+    str_t* apple = str_new("apple");
+    str_t* banana = str_new("BANANA");
+    str_t* apple_pie = str_new("Apple pie");
+    str_t* underscore = str_new("_");
+
+    cr_assert_lt(str_cmp_ignore_case(apple, banana), 0);
+    cr_assert_gt(str_cmp_ignore_case(banana, apple), 0);
+    cr_assert_lt(str_cmp_ignore_case(apple, apple_pie), 0);
+    cr_assert_eq(str_cmp_ignore_case(string_a, string_a), 0);
+
+    /* Letters are compared in the lower case: '_' (0x5F) is less than 'a' (0x61) */
+    cr_assert_gt(str_cmp_ignore_case(apple, underscore), 0);
+
+    cr_assert_lt(str_cmp_ignore_case(string_empty_a, apple), 0);
+    cr_assert_eq(str_cmp_ignore_case(string_empty_a, string_empty_b), 0);
+    cr_assert_lt(str_cmp_ignore_case(string_null, string_empty_a), 0);
+    cr_assert_gt(str_cmp_ignore_case(apple, string_null), 0);
+    cr_assert_eq(str_cmp_ignore_case(string_null, string_null), 0);
+
+    str_drop(&underscore);
+    str_drop(&apple_pie);
+    str_drop(&banana);
+    str_drop(&apple);
+}
+
+Test(str, contains_ignore_case) {
+    cr_assert(str_contains_ignore_case(string_a, "BEAR"));
+    cr_assert(str_contains_ignore_case(string_a, "l & b"));
+    cr_assert(str_contains_ignore_case(string_a, "p"));
+    cr_assert(str_contains_ignore_case(string_a, ""));
+    cr_assert_not(str_contains_ignore_case(string_a, "bears"));
+    cr_assert(str_contains_ignore_case(string_empty_a, ""));
+    cr_assert_not(str_contains_ignore_case(string_empty_a, "a"));
+    cr_assert_not(str_contains_ignore_case(string_null, "a"));
+    cr_assert_not(str_contains_ignore_case(string_a, NULL));
+
+    str_t* haystack = str_new(NULL);
+    for (size_t i = 0; i < 64; i++) {
+        str_append(haystack, "AbcAbcAbD");
+    }
+    str_append(haystack, "The Quick Brown Fox Jumps Over The Lazy Dog");
+
+    cr_assert(str_contains_ignore_case(haystack, "ABD"));
+    cr_assert(str_contains_ignore_case(haystack, "abcabdTHE QUICK"));
+    cr_assert(str_contains_ignore_case(haystack, "quick brown fox jumps over the lazy dog"));
+    cr_assert_not(str_contains_ignore_case(haystack, "abcabcabcabc"));
+    cr_assert_not(str_contains_ignore_case(haystack, "quick brown fox jumps over the lazy cat"));
+
+    str_drop(&haystack);
+}
+
+Test(str, starts_with_ignore_case) {
+    cr_assert(str_starts_with_ignore_case(string_a, "PULL &"));
+    cr_assert(str_starts_with_ignore_case(string_a, ""));
+    cr_assert_not(str_starts_with_ignore_case(string_a, "bear"));
+    cr_assert_not(str_starts_with_ignore_case(string_a, "pull & bear!"));
+    cr_assert_not(str_starts_with_ignore_case(string_null, ""));
+    cr_assert_not(str_starts_with_ignore_case(string_a, NULL));
+}
+
 Test(str, literal_len) {
     cr_assert_eq(__str_literal_len(""), 0);
     cr_assert_eq(__str_literal_len("Godspeed"), 8);
     cr_assert_eq(__str_literal_len(NULL), 0);
+
+    char long_string[300] = { 0 };
+    for (size_t i = 0; i < 299; i++) {
+        long_string[i] = 'x';
+    }
+    for (size_t offset = 0; offset < 40; offset++) {
+        cr_assert_eq(__str_literal_len(long_string + offset), 299 - offset);
+    }
 }
 
 Test(str, literal_contains) {
@@ -0,0 +1,193 @@
+#include <criterion/criterion.h>
+
+#include <ustring/str.h>
+#include <ustring/str_list.h>
+#include <ustring/str_view.h>
+#include "../src/str_p.h"
+
+static str_t* string_a;
+static str_view_t view_a;
+static str_view_t view_empty;
+
+static void setup(void) {
+    string_a = str_new("  Pull & Bear\t\n");
+    view_a = str_as_view(string_a);
+    view_empty = str_view_new(NULL);
+}
+
+static void teardown(void) {
+    str_drop(&string_a);
+}
+
+TestSuite(str_view, .init = setup, .fini = teardown);
+
+Test(str_view, new) {
+    const char* literal = "Hello";
+    str_view_t view = str_view_new(literal);
+    cr_assert_eq(view.ptr, literal);
+    cr_assert_eq(str_view_len(view), 5);
+
+    view = str_view_from_parts(literal + 1, 3);
+    cr_assert_eq(view.ptr, literal + 1);
+    cr_assert_eq(view.len, 3);
+
+    cr_assert_eq(str_view_len(view_empty), 0);
+    cr_assert(str_view_is_empty(view_empty));
+    cr_assert(str_view_is_empty(str_view_from_parts(NULL, 10)));
+    cr_assert(str_view_is_empty(str_view_new("")));
+}
+
+Test(str_view, as_view) {
+    cr_assert_eq(view_a.ptr, str_as_ptr(string_a));
+    cr_assert_eq(view_a.len, str_len(string_a));
+    cr_assert(str_view_is_empty(str_as_view(NULL)));
+}
+
+Test(str_view, from_view) {
+    str_t* string = str_from_view(str_view_slice(view_a, 2, 6));
+    cr_assert_not_null(string);
+    cr_assert_str_eq(str_as_ptr(string), "Pull");
+    cr_assert_eq(str_cap(string), STR_DEFAULT_CAPACITY);
+    str_drop(&string);
+
+    string = str_from_view(view_empty);
+    cr_assert_not_null(string);
+    cr_assert_str_eq(str_as_ptr(string), "");
+    str_drop(&string);
+
+    string = str_from_view(str_view_new("Caf\xc3\xa9"));
+    cr_assert_str_eq(str_as_ptr(string), "Caf??");
+    str_drop(&string);
+}
+
+Test(str_view, at) {
+    cr_assert_eq(str_view_at(view_a, 2), 'P');
+    cr_assert_eq(str_view_at(view_a, 100), '\0');
+    cr_assert_eq(str_view_at(view_empty, 0), '\0');
+}
+
+Test(str_view, slice) {
+    str_view_t slice = str_view_slice(view_a, 2, 6);
+    cr_assert_eq(slice.ptr, view_a.ptr + 2);
+    cr_assert_eq(slice.len, 4);
+
+    slice = str_view_slice(view_a, 9, STR_NPOS);
+    cr_assert(str_view_eq(slice, str_view_new("Bear\t\n")));
+
+    slice = str_view_slice(view_a, 6, 2);
+    cr_assert(str_view_is_empty(slice));
+
+    slice = str_view_slice(view_a, 100, 200);
+    cr_assert(str_view_is_empty(slice));
+    cr_assert(str_view_is_empty(str_view_slice(view_empty, 0, 10)));
+}
+
+Test(str_view, eq) {
+    cr_assert(str_view_eq(str_view_new("Bear"), str_view_slice(view_a, 9, 13)));
+    cr_assert_not(str_view_eq(str_view_new("Bear"), str_view_new("Bea")));
+    cr_assert_not(str_view_eq(str_view_new("Bear"), str_view_new("Beer")));
+    cr_assert(str_view_eq(view_empty, str_view_new("")));
+}
+
+Test(str_view, cmp) {
+    cr_assert_eq(str_view_cmp(str_view_new("abc"), str_view_new("abc")), 0);
+    cr_assert_lt(str_view_cmp(str_view_new("abc"), str_view_new("abd")), 0);
+    cr_assert_gt(str_view_cmp(str_view_new("abd"), str_view_new("abc")), 0);
+    cr_assert_lt(str_view_cmp(str_view_new("ab"), str_view_new("abc")), 0);
+    cr_assert_gt(str_view_cmp(str_view_new("abc"), view_empty), 0);
+    cr_assert_eq(str_view_cmp(view_empty, str_view_new("")), 0);
+    cr_assert_gt(str_view_cmp(str_view_new("\x80"), str_view_new("a")), 0);
+}
+
+Test(str_view, find) {
+    cr_assert_eq(str_view_find(view_a, str_view_new("&")), 7);
+    cr_assert_eq(str_view_find(view_a, str_view_new("Bear")), 9);
+    cr_assert_eq(str_view_find(view_a, str_view_new("bear")), STR_NPOS);
+    cr_assert_eq(str_view_find(view_a, view_empty), 0);
+    cr_assert_eq(str_view_find(view_empty, view_empty), 0);
+    cr_assert_eq(str_view_find(view_empty, str_view_new("a")), STR_NPOS);
+
+    /* Match must not extend past the end of the view */
+    cr_assert_eq(str_view_find(str_view_slice(view_a, 0, 11), str_view_new("Bear")), STR_NPOS);
+}
+
+Test(str_view, starts_with) {
+    str_view_t trimmed = str_view_trim(view_a);
+    cr_assert(str_view_starts_with(trimmed, str_view_new("Pull")));
+    cr_assert(str_view_starts_with(trimmed, view_empty));
+    cr_assert_not(str_view_starts_with(trimmed, str_view_new("Bear")));
+    cr_assert_not(str_view_starts_with(view_empty, str_view_new("P")));
+}
+
+Test(str_view, ends_with) {
+    str_view_t trimmed = str_view_trim(view_a);
+    cr_assert(str_view_ends_with(trimmed, str_view_new("Bear")));
+    cr_assert(str_view_ends_with(trimmed, view_empty));
+    cr_assert_not(str_view_ends_with(trimmed, str_view_new("Pull")));
+    cr_assert_not(str_view_ends_with(view_empty, str_view_new("r")));
+}
+
+Test(str_view, trim) {
+    cr_assert(str_view_eq(str_view_trim(view_a), str_view_new("Pull & Bear")));
+    cr_assert(str_view_eq(str_view_trim_start(view_a), str_view_new("Pull & Bear\t\n")));
+    cr_assert(str_view_eq(str_view_trim_end(view_a), str_view_new("  Pull & Bear")));
+    cr_assert(str_view_is_empty(str_view_trim(str_view_new(" \t\n "))));
+    cr_assert(str_view_is_empty(str_view_trim(view_empty)));
+
+    /* String itself is left unchanged */
+    cr_assert_str_eq(str_as_ptr(string_a), "  Pull & Bear\t\n");
+}
+
+Test(str_view, split_iter) {
+    str_split_iter_t it = str_split_iter(str_view_new(" .One, Two;; Three."), " ,;.");
+    str_view_t token;
+
+    cr_assert(str_split_iter_next(&it, &token));
+    cr_assert(str_view_eq(token, str_view_new("One")));
+    cr_assert(str_split_iter_next(&it, &token));
+    cr_assert(str_view_eq(token, str_view_new("Two")));
+    cr_assert(str_split_iter_next(&it, &token));
+    cr_assert(str_view_eq(token, str_view_new("Three")));
+    cr_assert_not(str_split_iter_next(&it, &token));
+    cr_assert_not(str_split_iter_next(&it, &token));
+
+    /* Tokens refer to the split characters */
+    it = str_split_iter(view_a, "&");
+    cr_assert(str_split_iter_next(&it, &token));
+    cr_assert_eq(token.ptr, view_a.ptr);
+    cr_assert_eq(token.len, 7);
+
+    /* Empty delimiter yields the whole view */
+    it = str_split_iter(view_a, NULL);
+    cr_assert(str_split_iter_next(&it, &token));
+    cr_assert(str_view_eq(token, view_a));
+    cr_assert_not(str_split_iter_next(&it, &token));
+
+    it = str_split_iter(view_empty, ",");
+    cr_assert_not(str_split_iter_next(&it, &token));
+
+    it = str_split_iter(str_view_new(",,,"), ",");
+    cr_assert_not(str_split_iter_next(&it, &token));
+    cr_assert_not(str_split_iter_next(NULL, &token));
+    cr_assert_not(str_split_iter_next(&it, NULL));
+}
+
+Test(str_view, split_whitespace_iter) {
+    str_t* string = str_new("\tOne  Two\r\nThree \v");
+    str_list_t* list = str_split_whitespace(string);
+
+    str_split_iter_t it = str_split_whitespace_iter(str_as_view(string));
+    str_view_t token;
+    size_t count = 0;
+
+    while (str_split_iter_next(&it, &token)) {
+        cr_assert(str_view_eq(token, str_as_view(str_list_at(list, count))));
+        count += 1;
+    }
+
+    cr_assert_eq(count, 3);
+    cr_assert_eq(count, str_list_size(list));
+
+    str_list_drop(&list);
+    str_drop(&string);
+}
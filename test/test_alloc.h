@@ -0,0 +1,53 @@
+/******************************************************************************
+ * 
+ * @file    test_alloc.h
+ * @date    16 Oct 2026
+ * @author  Mikhail Malyarenko <malyarenko.md@gmail.com>
+ * 
+ * @brief   Allocation counting allocator for tests
+ * 
+ *****************************************************************************/
+
+#ifndef __USTRING_TEST_ALLOC_H__
+#define __USTRING_TEST_ALLOC_H__
+
+#include <stdlib.h>
+
+#include <ustring/alloc.h>
+
+typedef struct test_alloc_stats {
+    size_t allocs;
+    size_t reallocs;
+    size_t frees;
+} test_alloc_stats_t;
+
+static void* test_alloc(void* ctx, size_t size) {
+    ((test_alloc_stats_t*) ctx)->allocs += 1;
+    return malloc(size);
+}
+
+static void* test_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size) {
+    (void) old_size;
+    ((test_alloc_stats_t*) ctx)->reallocs += 1;
+    return realloc(ptr, new_size);
+}
+
+static void test_free(void* ctx, void* ptr) {
+    ((test_alloc_stats_t*) ctx)->frees += 1;
+    free(ptr);
+}
+
+/**
+ * @brief Returns the allocator counting calls into @c stats
+ */
+static inline ustring_allocator_t test_allocator(test_alloc_stats_t* stats) {
+    *stats = (test_alloc_stats_t) {0};
+    return (ustring_allocator_t) {
+        .alloc = test_alloc,
+        .realloc = test_realloc,
+        .free = test_free,
+        .ctx = stats,
+    };
+}
+
+#endif /* __USTRING_TEST_ALLOC_H__ */